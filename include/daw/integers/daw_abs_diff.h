@@ -0,0 +1,264 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+#include "impl/daw_signed_simd.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace daw::integers {
+	template<std::size_t Bits>
+	using abs_diff_t =
+	  std::make_unsigned_t<sint_impl::signed_integer_type_t<Bits>>;
+
+	namespace sint_impl {
+		/// Blocks are summed in u32, which holds 65536 distances of up to 2^16 - 1,
+		/// and then added to the u64 total
+		inline constexpr std::size_t sad_block_size = 65536;
+
+		/// @brief The sum of |a[i] - b[i]| over at most sad_block_size elements
+		template<std::size_t Bits>
+		DAW_ATTRIB_INLINE std::uint64_t
+		sad_block( signed_integer_type_t<Bits> const *a,
+		           signed_integer_type_t<Bits> const *b,
+		           std::size_t count ) noexcept {
+			static_assert( Bits == 8 or Bits == 16 );
+			std::size_t n = 0;
+			std::uint64_t result = 0;
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+			auto acc = _mm256_setzero_si256( );
+			if constexpr( Bits == 8 ) {
+				// psadbw works on unsigned bytes, flipping the sign bits keeps the
+				// differences the same
+				auto const bias = _mm256_set1_epi8( -128 );
+				for( ; n + 32 <= count; n += 32 ) {
+					auto const va = _mm256_xor_si256(
+					  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( a + n ) ),
+					  bias );
+					auto const vb = _mm256_xor_si256(
+					  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( b + n ) ),
+					  bias );
+					acc = _mm256_add_epi64( acc, _mm256_sad_epu8( va, vb ) );
+				}
+			} else {
+				auto const low_half = _mm256_set1_epi32( 0xFFFF );
+				auto sum32 = _mm256_setzero_si256( );
+				for( ; n + 16 <= count; n += 16 ) {
+					auto const va =
+					  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( a + n ) );
+					auto const vb =
+					  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( b + n ) );
+					// max - min is the exact difference as a u16
+					auto const d = _mm256_sub_epi16( _mm256_max_epi16( va, vb ),
+					                                 _mm256_min_epi16( va, vb ) );
+					sum32 = _mm256_add_epi32(
+					  sum32, _mm256_add_epi32( _mm256_and_si256( d, low_half ),
+					                           _mm256_srli_epi32( d, 16 ) ) );
+				}
+				acc = _mm256_add_epi64(
+				  _mm256_cvtepu32_epi64( _mm256_castsi256_si128( sum32 ) ),
+				  _mm256_cvtepu32_epi64( _mm256_extracti128_si256( sum32, 1 ) ) );
+			}
+			auto const sum128 = _mm_add_epi64( _mm256_castsi256_si128( acc ),
+			                                   _mm256_extracti128_si256( acc, 1 ) );
+			result = static_cast<std::uint64_t>( _mm_cvtsi128_si64( sum128 ) ) +
+			         static_cast<std::uint64_t>( _mm_extract_epi64( sum128, 1 ) );
+#endif
+			std::uint32_t tail = 0;
+			for( ; n < count; ++n ) {
+				auto const d = static_cast<int>( a[n] ) - static_cast<int>( b[n] );
+				tail += static_cast<std::uint32_t>( d < 0 ? -d : d );
+			}
+			return result + tail;
+		}
+	} // namespace sint_impl
+
+	/// @brief The sum of absolute differences, sum( |a[i] - b[i]| ), of count
+	/// elements.  i8 and i16 are summed in wide accumulators, with psadbw on
+	/// AVX2 for i8, and cannot overflow.  A sum of i32 or i64 elements that is
+	/// larger than i64::max( ) is reported via on_signed_integer_overflow and
+	/// i64::max( ) is returned
+	template<std::size_t Bits>
+	[[nodiscard]] i64 sad( signed_integer<Bits> const *a,
+	                       signed_integer<Bits> const *b, std::size_t count ) {
+		std::uint64_t result = 0;
+		bool overflow = false;
+		if constexpr( Bits <= 16 ) {
+			auto const *const lhs = sint_impl::raw_ptr( a );
+			auto const *const rhs = sint_impl::raw_ptr( b );
+			for( std::size_t n = 0; n < count; n += sint_impl::sad_block_size ) {
+				result += sint_impl::sad_block<Bits>(
+				  lhs + n, rhs + n,
+				  ( std::min )( count - n, sint_impl::sad_block_size ) );
+			}
+		} else {
+			for( std::size_t n = 0; n < count; ++n ) {
+				auto const d = a[n].abs_diff( b[n] );
+				result += d;
+				overflow |= result < d;
+			}
+		}
+		overflow |= result > static_cast<std::uint64_t>(
+		                       daw::numeric_limits<std::int64_t>::max( ) );
+		if( DAW_UNLIKELY( overflow ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_overflow( );
+			return i64::max( );
+		}
+		return i64( static_cast<std::int64_t>( result ) );
+	}
+
+	/// @brief sad of two ranges of the same size.  Ranges of different sizes
+	/// are reported via on_signed_integer_out_of_range and 0 is returned
+	template<typename A, typename B,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<A const> and
+	                            sint_impl::is_contiguous_range_v<B const>,
+	                          std::nullptr_t> = nullptr>
+	[[nodiscard]] i64 sad( A const &a, B const &b ) {
+		static_assert( std::is_same_v<sint_impl::range_value_t<A const>,
+		                              sint_impl::range_value_t<B const>>,
+		               "sad requires ranges of the same signed_integer type" );
+		if( DAW_UNLIKELY( std::size( a ) != std::size( b ) ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			return i64( 0 );
+		}
+		return sad( std::data( a ), std::data( b ),
+		            static_cast<std::size_t>( std::size( a ) ) );
+	}
+
+	/// @brief out[i] = a[i].abs_diff( b[i] ) for count elements.  The
+	/// distances are unsigned so that none overflow
+	template<std::size_t Bits>
+	void abs_diff( signed_integer<Bits> const *a, signed_integer<Bits> const *b,
+	               std::size_t count, abs_diff_t<Bits> *out ) noexcept {
+		std::size_t n = 0;
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+		if constexpr( Bits == 8 or Bits == 16 ) {
+			for( ; n + 32 / sizeof( abs_diff_t<Bits> ) <= count;
+			     n += 32 / sizeof( abs_diff_t<Bits> ) ) {
+				auto const va =
+				  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( a + n ) );
+				auto const vb =
+				  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( b + n ) );
+				auto d = _mm256_setzero_si256( );
+				if constexpr( Bits == 8 ) {
+					d = _mm256_sub_epi8( _mm256_max_epi8( va, vb ),
+					                     _mm256_min_epi8( va, vb ) );
+				} else {
+					d = _mm256_sub_epi16( _mm256_max_epi16( va, vb ),
+					                      _mm256_min_epi16( va, vb ) );
+				}
+				_mm256_storeu_si256( reinterpret_cast<__m256i *>( out + n ), d );
+			}
+		}
+#endif
+		for( ; n < count; ++n ) {
+			out[n] = a[n].abs_diff( b[n] );
+		}
+	}
+
+	/// @brief abs_diff over ranges.  b and out must be at least as large as a,
+	/// otherwise it is reported via on_signed_integer_out_of_range and nothing
+	/// is written
+	template<typename A, typename B, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<A const> and
+	                            sint_impl::is_contiguous_range_v<B const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	void abs_diff( A const &a, B const &b, Out &&out ) {
+		using value_t = sint_impl::range_value_t<A const>;
+		static_assert(
+		  std::is_same_v<value_t, sint_impl::range_value_t<B const>> and
+		    std::is_same_v<abs_diff_t<sizeof( value_t ) * 8>,
+		                   sint_impl::range_value_t<Out>>,
+		  "abs_diff requires ranges of the same signed_integer type and a range "
+		  "of abs_diff_t for the output" );
+		auto const count = static_cast<std::size_t>( std::size( a ) );
+		if( DAW_UNLIKELY( static_cast<std::size_t>( std::size( b ) ) < count or
+		                  static_cast<std::size_t>( std::size( out ) ) < count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			return;
+		}
+		abs_diff( std::data( a ), std::data( b ), count, std::data( out ) );
+	}
+
+	/// @brief out[i] = a[i].avg_rounded( b[i] ) for count elements.  With AVX2
+	/// i8 and i16 use pavgb/pavgw on sign flipped values.  out may be a or b
+	template<std::size_t Bits>
+	void avg_rounded( signed_integer<Bits> const *a,
+	                  signed_integer<Bits> const *b, std::size_t count,
+	                  signed_integer<Bits> *out ) noexcept {
+		std::size_t n = 0;
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+		if constexpr( Bits == 8 or Bits == 16 ) {
+			// ( a + 2^(Bits-1) + b + 2^(Bits-1) + 1 ) / 2 is the rounded average
+			// moved by 2^(Bits-1) again
+			auto const bias = Bits == 8 ? _mm256_set1_epi8( -128 )
+			                            : _mm256_set1_epi16( -32768 );
+			for( ; n + 32 / sizeof( signed_integer<Bits> ) <= count;
+			     n += 32 / sizeof( signed_integer<Bits> ) ) {
+				auto const va = _mm256_xor_si256(
+				  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( a + n ) ),
+				  bias );
+				auto const vb = _mm256_xor_si256(
+				  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( b + n ) ),
+				  bias );
+				auto avg = _mm256_setzero_si256( );
+				if constexpr( Bits == 8 ) {
+					avg = _mm256_avg_epu8( va, vb );
+				} else {
+					avg = _mm256_avg_epu16( va, vb );
+				}
+				_mm256_storeu_si256( reinterpret_cast<__m256i *>( out + n ),
+				                     _mm256_xor_si256( avg, bias ) );
+			}
+		}
+#endif
+		for( ; n < count; ++n ) {
+			out[n] = a[n].avg_rounded( b[n] );
+		}
+	}
+
+	/// @brief avg_rounded over ranges.  b and out must be at least as large as
+	/// a, otherwise it is reported via on_signed_integer_out_of_range and
+	/// nothing is written
+	template<typename A, typename B, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<A const> and
+	                            sint_impl::is_contiguous_range_v<B const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	void avg_rounded( A const &a, B const &b, Out &&out ) {
+		static_assert(
+		  std::is_same_v<sint_impl::range_value_t<A const>,
+		                 sint_impl::range_value_t<B const>> and
+		    std::is_same_v<sint_impl::range_value_t<A const>,
+		                   sint_impl::range_value_t<Out>>,
+		  "avg_rounded requires ranges of the same signed_integer type" );
+		auto const count = static_cast<std::size_t>( std::size( a ) );
+		if( DAW_UNLIKELY( static_cast<std::size_t>( std::size( b ) ) < count or
+		                  static_cast<std::size_t>( std::size( out ) ) < count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			return;
+		}
+		avg_rounded( std::data( a ), std::data( b ), count, std::data( out ) );
+	}
+} // namespace daw::integers
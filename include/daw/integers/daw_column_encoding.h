@@ -0,0 +1,426 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+#include "impl/daw_signed_simd.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_cxmath.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace daw::integers {
+	/// @brief A run of length copies of value.  Lengths of encoder output are
+	/// always in [1, i32::max( )], longer runs are split
+	template<std::size_t Bits>
+	struct rle_run {
+		signed_integer<Bits> value;
+		i32 length;
+	};
+
+	namespace sint_impl {
+		/// @brief Position of the first element in [first, count) not equal to
+		/// value
+		template<typename T>
+		DAW_ATTRIB_INLINE std::size_t find_run_end( T const *values,
+		                                            std::size_t first,
+		                                            std::size_t count,
+		                                            T value ) noexcept {
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+			if constexpr( sizeof( T ) == 2 or sizeof( T ) == 4 ) {
+				auto const needle = [&] {
+					if constexpr( sizeof( T ) == 2 ) {
+						return _mm256_set1_epi16( value );
+					} else {
+						return _mm256_set1_epi32( value );
+					}
+				}( );
+				constexpr std::size_t width = 32 / sizeof( T );
+				for( ; first + width <= count; first += width ) {
+					auto const block = _mm256_loadu_si256(
+					  reinterpret_cast<__m256i const *>( values + first ) );
+					auto const eq = [&] {
+						if constexpr( sizeof( T ) == 2 ) {
+							return _mm256_cmpeq_epi16( block, needle );
+						} else {
+							return _mm256_cmpeq_epi32( block, needle );
+						}
+					}( );
+					auto const mask =
+					  static_cast<std::uint32_t>( _mm256_movemask_epi8( eq ) );
+					if( mask != 0xFFFF'FFFFU ) {
+						return first + daw::cxmath::count_trailing_zeros( ~mask ) /
+						                 sizeof( T );
+					}
+				}
+			}
+#endif
+			constexpr std::size_t block_size = 32;
+			for( ; first + block_size <= count; first += block_size ) {
+				bool all_equal = true;
+				for( std::size_t n = 0; n < block_size; ++n ) {
+					all_equal &= values[first + n] == value;
+				}
+				if( not all_equal ) {
+					break;
+				}
+			}
+			while( first < count and values[first] == value ) {
+				++first;
+			}
+			return first;
+		}
+
+		/// @brief Open addressing hash map from integer keys to dictionary
+		/// codes.  Linear probing over a power of two table with a
+		/// multiplicative hash, kept at most half full
+		template<typename T, typename Code>
+		struct integer_code_map {
+			struct slot_t {
+				T key;
+				// code + 1, 0 is an empty slot
+				std::uint64_t code;
+			};
+			std::vector<slot_t> m_slots = std::vector<slot_t>( 16 );
+			std::size_t m_size = 0;
+
+			[[nodiscard]] DAW_ATTRIB_INLINE std::size_t
+			slot_for( T key ) const noexcept {
+				auto const h = static_cast<std::uint64_t>(
+				                 static_cast<std::make_unsigned_t<T>>( key ) ) *
+				               0x9E37'79B9'7F4A'7C15ULL;
+				return static_cast<std::size_t>( h >> 32U ) & ( m_slots.size( ) - 1 );
+			}
+
+			void grow( ) {
+				auto old = std::move( m_slots );
+				m_slots = std::vector<slot_t>( old.size( ) * 2 );
+				for( auto const &s : old ) {
+					if( s.code != 0 ) {
+						auto pos = slot_for( s.key );
+						while( m_slots[pos].code != 0 ) {
+							pos = ( pos + 1 ) & ( m_slots.size( ) - 1 );
+						}
+						m_slots[pos] = s;
+					}
+				}
+			}
+
+			/// @return The code for key, inserting next_code when key is new.
+			/// inserted is set when key was added
+			DAW_ATTRIB_INLINE std::uint64_t find_or_insert( T key,
+			                                                std::uint64_t next_code,
+			                                                bool &inserted ) {
+				auto pos = slot_for( key );
+				while( m_slots[pos].code != 0 ) {
+					if( m_slots[pos].key == key ) {
+						inserted = false;
+						return m_slots[pos].code - 1;
+					}
+					pos = ( pos + 1 ) & ( m_slots.size( ) - 1 );
+				}
+				inserted = true;
+				m_slots[pos] = slot_t{ key, next_code + 1 };
+				if( ++m_size * 2 > m_slots.size( ) ) {
+					grow( );
+				}
+				return next_code;
+			}
+		};
+	} // namespace sint_impl
+
+	/// @brief Run length encode values.  Run boundaries are found with packed
+	/// compares, a block at a time.  Runs longer than i32::max( ) are split
+	template<std::size_t Bits>
+	[[nodiscard]] std::vector<rle_run<Bits>>
+	rle_encode( signed_integer<Bits> const *values, std::size_t count ) {
+		auto const *const raw = sint_impl::raw_ptr( values );
+		auto result = std::vector<rle_run<Bits>>( );
+		constexpr auto max_length = static_cast<std::size_t>(
+		  daw::numeric_limits<std::int32_t>::max( ) );
+		std::size_t first = 0;
+		while( first < count ) {
+			auto const last =
+			  sint_impl::find_run_end( raw, first, count, raw[first] );
+			for( auto length = last - first; length > 0; ) {
+				auto const part = ( std::min )( length, max_length );
+				result.push_back( rle_run<Bits>{ values[first], i32( part ) } );
+				length -= part;
+			}
+			first = last;
+		}
+		return result;
+	}
+
+	template<typename Values,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Values const>,
+	                          std::nullptr_t> = nullptr>
+	[[nodiscard]] auto rle_encode( Values const &values ) {
+		return rle_encode( std::data( values ), std::size( values ) );
+	}
+
+	namespace sint_impl {
+		/// @brief Report a run length that is not positive via
+		/// on_signed_integer_out_of_range
+		template<std::size_t Bits>
+		DAW_ATTRIB_INLINE bool is_valid_run( rle_run<Bits> const &run ) {
+			if( DAW_UNLIKELY( run.length <= 0 ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				return false;
+			}
+			return true;
+		}
+	} // namespace sint_impl
+
+	/// @brief The number of values runs decode to.  This is summed with checked
+	/// arithmetic and each length must be positive, so untrusted runs cannot
+	/// wrap the total.  Invalid lengths are reported via
+	/// on_signed_integer_out_of_range and the sum via
+	/// on_signed_integer_overflow
+	/// @return The total, or 0 when any length is invalid
+	template<std::size_t Bits>
+	[[nodiscard]] i64 rle_decoded_size( rle_run<Bits> const *runs,
+	                                    std::size_t run_count ) {
+		auto result = i64( 0 );
+		for( std::size_t n = 0; n < run_count; ++n ) {
+			if( not sint_impl::is_valid_run( runs[n] ) ) {
+				return i64( 0 );
+			}
+			result = result.add_checked( i64( runs[n].length ) );
+		}
+		return result;
+	}
+
+	/// @brief Expand runs into out.  The run lengths are validated first with
+	/// rle_decoded_size; when any is not positive or their sum is larger than
+	/// out_size, on_signed_integer_out_of_range is called and nothing is
+	/// written
+	/// @return The number of values written
+	template<std::size_t Bits>
+	std::size_t rle_decode( rle_run<Bits> const *runs, std::size_t run_count,
+	                        signed_integer<Bits> *out, std::size_t out_size ) {
+		auto const size = rle_decoded_size( runs, run_count );
+		if( DAW_UNLIKELY( size < 0 or
+		                  static_cast<std::uint64_t>( size.value( ) ) >
+		                    out_size ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			return 0;
+		}
+		if( size == 0 ) {
+			return 0;
+		}
+		std::size_t pos = 0;
+		for( std::size_t n = 0; n < run_count; ++n ) {
+			auto const length = static_cast<std::size_t>( runs[n].length.value( ) );
+			std::fill_n( out + pos, length, runs[n].value );
+			pos += length;
+		}
+		return pos;
+	}
+
+	template<typename Runs, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Runs const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	std::size_t rle_decode( Runs const &runs, Out &&out ) {
+		return rle_decode( std::data( runs ), std::size( runs ), std::data( out ),
+		                   std::size( out ) );
+	}
+
+	/// @brief Count the decoded values equal to value without decoding.  The
+	/// count is accumulated with checked arithmetic.  Invalid lengths are
+	/// reported as in rle_decoded_size
+	/// @return The count, or 0 when any length is invalid
+	template<std::size_t Bits>
+	[[nodiscard]] i64 rle_count_equal( rle_run<Bits> const *runs,
+	                                   std::size_t run_count,
+	                                   signed_integer<Bits> value ) {
+		auto result = i64( 0 );
+		for( std::size_t n = 0; n < run_count; ++n ) {
+			if( not sint_impl::is_valid_run( runs[n] ) ) {
+				return i64( 0 );
+			}
+			if( runs[n].value == value ) {
+				result = result.add_checked( i64( runs[n].length ) );
+			}
+		}
+		return result;
+	}
+
+	/// @brief Sum the decoded values without decoding, one checked multiply
+	/// and add per run.  Invalid lengths are reported as in rle_decoded_size
+	/// @return The sum, or 0 when any length is invalid
+	template<std::size_t Bits>
+	[[nodiscard]] i64 rle_sum( rle_run<Bits> const *runs,
+	                           std::size_t run_count ) {
+		auto result = i64( 0 );
+		for( std::size_t n = 0; n < run_count; ++n ) {
+			if( not sint_impl::is_valid_run( runs[n] ) ) {
+				return i64( 0 );
+			}
+			result = result.add_checked(
+			  i64( runs[n].value ).mul_checked( i64( runs[n].length ) ) );
+		}
+		return result;
+	}
+
+	/// @brief A column stored as codes into a table of its distinct values
+	/// @tparam Code Unsigned integer type of the codes.  The dictionary holds
+	/// at most numeric_limits<Code>::max( ) + 1 values
+	template<std::size_t Bits, typename Code = std::uint16_t>
+	struct dictionary_column {
+		static_assert( std::is_unsigned_v<Code> and
+		                 sizeof( Code ) <= sizeof( std::uint32_t ),
+		               "Code must be an unsigned integer of at most 32 bits" );
+		using value_type = signed_integer<Bits>;
+		using code_type = Code;
+
+		/// Distinct values in order of first appearance
+		std::vector<value_type> dictionary{ };
+		std::vector<code_type> codes{ };
+
+		[[nodiscard]] std::size_t size( ) const noexcept {
+			return codes.size( );
+		}
+
+		/// @brief The code of value, or dictionary.size( ) when value does not
+		/// appear in the column
+		[[nodiscard]] std::size_t code_of( value_type value ) const noexcept {
+			return static_cast<std::size_t>(
+			  std::find( dictionary.begin( ), dictionary.end( ), value ) -
+			  dictionary.begin( ) );
+		}
+
+		/// @brief Count the values equal to value by comparing codes, without
+		/// decoding
+		[[nodiscard]] std::size_t count_equal( value_type value ) const noexcept {
+			auto const code = code_of( value );
+			if( code == dictionary.size( ) ) {
+				return 0;
+			}
+			std::size_t result = 0;
+			for( auto c : codes ) {
+				result += static_cast<std::size_t>( c == code );
+			}
+			return result;
+		}
+
+		/// @brief Check that every code indexes the dictionary.  The members are
+		/// public, so this is not an invariant; the first invalid code is
+		/// reported via on_signed_integer_out_of_range
+		[[nodiscard]] bool is_valid( ) const {
+			auto const dict_size = dictionary.size( );
+			for( auto c : codes ) {
+				if( DAW_UNLIKELY( static_cast<std::size_t>( c ) >= dict_size ) ) {
+					DAW_UNLIKELY_BRANCH
+					on_signed_integer_out_of_range( );
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/// @brief Sum the column from a histogram of the codes, one checked
+		/// multiply and add per dictionary entry.  The codes are validated with
+		/// is_valid first and 0 is returned when any is out of range
+		[[nodiscard]] i64 sum( ) const {
+			if( not is_valid( ) ) {
+				return i64( 0 );
+			}
+			auto counts = std::vector<std::uint64_t>( dictionary.size( ) );
+			for( auto c : codes ) {
+				++counts[c];
+			}
+			auto result = i64( 0 );
+			for( std::size_t n = 0; n < dictionary.size( ); ++n ) {
+				result = result.add_checked(
+				  i64( dictionary[n] ).mul_checked( i64( counts[n] ) ) );
+			}
+			return result;
+		}
+
+		/// @brief Expand the codes into out.  When out_size is smaller than
+		/// size( ) or a code is out of range, on_signed_integer_out_of_range is
+		/// called and nothing is written
+		/// @return The number of values written
+		std::size_t decode( value_type *out, std::size_t out_size ) const {
+			if( DAW_UNLIKELY( out_size < codes.size( ) ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				return 0;
+			}
+			if( not is_valid( ) ) {
+				return 0;
+			}
+			auto const *const dict = dictionary.data( );
+			for( std::size_t n = 0; n < codes.size( ); ++n ) {
+				out[n] = dict[codes[n]];
+			}
+			return codes.size( );
+		}
+
+		template<typename Out,
+		         std::enable_if_t<sint_impl::is_contiguous_range_v<Out>,
+		                          std::nullptr_t> = nullptr>
+		std::size_t decode( Out &&out ) const {
+			return decode( std::data( out ), std::size( out ) );
+		}
+	};
+
+	/// @brief Dictionary encode values, assigning codes with an integer hash
+	/// table.  When there are more distinct values than Code can represent,
+	/// on_signed_integer_overflow is called and the values from that point on
+	/// are not encoded
+	template<typename Code = std::uint16_t, std::size_t Bits>
+	[[nodiscard]] dictionary_column<Bits, Code>
+	dictionary_encode( signed_integer<Bits> const *values, std::size_t count ) {
+		auto result = dictionary_column<Bits, Code>{ };
+		using raw_t = sint_impl::signed_integer_type_t<Bits>;
+		auto map = sint_impl::integer_code_map<raw_t, Code>{ };
+		constexpr auto max_codes =
+		  static_cast<std::uint64_t>( daw::numeric_limits<Code>::max( ) ) + 1U;
+		auto const *const raw = sint_impl::raw_ptr( values );
+		result.codes.reserve( count );
+		for( std::size_t n = 0; n < count; ++n ) {
+			bool inserted = false;
+			auto const code =
+			  map.find_or_insert( raw[n], result.dictionary.size( ), inserted );
+			if( inserted ) {
+				if( DAW_UNLIKELY( code >= max_codes ) ) {
+					DAW_UNLIKELY_BRANCH
+					on_signed_integer_overflow( );
+					break;
+				}
+				result.dictionary.push_back( values[n] );
+			}
+			result.codes.push_back( static_cast<Code>( code ) );
+		}
+		return result;
+	}
+
+	template<typename Code = std::uint16_t, typename Values,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Values const>,
+	                          std::nullptr_t> = nullptr>
+	[[nodiscard]] auto dictionary_encode( Values const &values ) {
+		return dictionary_encode<Code>( std::data( values ), std::size( values ) );
+	}
+} // namespace daw::integers
@@ -0,0 +1,211 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+#include "impl/daw_signed_simd.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace daw::integers {
+	/// @brief How count_min_sketch::increment updates the rows
+	enum class count_min_update {
+		/// Every row's counter is incremented
+		standard,
+		/// Counters are only raised as far as the new estimate, which reduces
+		/// the over estimate of infrequent keys
+		conservative
+	};
+
+	/// @brief The largest number of rows a count_min_sketch can have
+	inline constexpr std::size_t count_min_max_depth = 16;
+
+	/// @brief A count-min frequency sketch with narrow counters.  Counters
+	/// saturate at max( ) instead of wrapping, so a hot key can make its
+	/// estimate stick at max( ) but never makes it small; estimates remain
+	/// upper bounds of the true count up to max( ).
+	/// @tparam CounterBits The width of each counter, narrow counters such as 8
+	/// or 16 bits fit more columns in the same memory
+	template<std::size_t CounterBits>
+	struct count_min_sketch {
+		using counter_type = signed_integer<CounterBits>;
+		using size_type = std::size_t;
+
+	private:
+		using raw_t = sint_impl::signed_integer_type_t<CounterBits>;
+		using indices_t = std::array<std::uint32_t, count_min_max_depth>;
+
+		std::vector<raw_t> m_counters{ };
+		size_type m_width_bits = 0;
+		size_type m_depth = 0;
+		count_min_update m_update = count_min_update::standard;
+		std::uint64_t m_seed = 0;
+
+		/// Column of key in every row.  The rows use double hashing from the two
+		/// halves of one 64 bit mix, 32 bit lanes that the compiler vectorizes
+		/// across the rows
+		DAW_ATTRIB_INLINE void indices_of( std::uint64_t key,
+		                                   indices_t &out ) const noexcept {
+			auto h = key ^ m_seed;
+			h = ( h ^ ( h >> 30U ) ) * 0xBF58'476D'1CE4'E5B9ULL;
+			h = ( h ^ ( h >> 27U ) ) * 0x94D0'49BB'1331'11EBULL;
+			h ^= h >> 31U;
+			auto const h1 = static_cast<std::uint32_t>( h );
+			auto const h2 = static_cast<std::uint32_t>( h >> 32U ) | 1U;
+			auto const shift = static_cast<std::uint32_t>( 32U - m_width_bits );
+			for( std::uint32_t r = 0; r < count_min_max_depth; ++r ) {
+				auto const g = ( h1 + r * h2 ) * 0x9E37'79B1U;
+				out[r] = m_width_bits == 0 ? 0U : g >> shift;
+			}
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE raw_t &
+		counter( size_type row, std::uint32_t column ) noexcept {
+			return m_counters[( row << m_width_bits ) + column];
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE raw_t
+		counter( size_type row, std::uint32_t column ) const noexcept {
+			return m_counters[( row << m_width_bits ) + column];
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE raw_t
+		estimate_raw( indices_t const &idx ) const noexcept {
+			auto result = counter( 0, idx[0] );
+			for( size_type r = 1; r < m_depth; ++r ) {
+				result = ( std::min )( result, counter( r, idx[r] ) );
+			}
+			return result;
+		}
+
+		DAW_ATTRIB_INLINE void increment_raw( std::uint64_t key, raw_t amount ) {
+			auto idx = indices_t{ };
+			indices_of( key, idx );
+			if( m_update == count_min_update::conservative ) {
+				auto const target = sint_impl::sat_add( estimate_raw( idx ), amount );
+				for( size_type r = 0; r < m_depth; ++r ) {
+					auto &c = counter( r, idx[r] );
+					c = ( std::max )( c, target );
+				}
+			} else {
+				for( size_type r = 0; r < m_depth; ++r ) {
+					auto &c = counter( r, idx[r] );
+					c = sint_impl::sat_add( c, amount );
+				}
+			}
+		}
+
+		// Sign extended, so equal keys of different widths hash the same
+		template<std::size_t KeyBits>
+		[[nodiscard]] static DAW_ATTRIB_INLINE std::uint64_t
+		key_bits( signed_integer<KeyBits> key ) noexcept {
+			return static_cast<std::uint64_t>(
+			  static_cast<std::int64_t>( key.value( ) ) );
+		}
+
+	public:
+		count_min_sketch( ) = default;
+
+		/// @param width Columns per row, rounded up to a power of two
+		/// @param depth Number of rows, from 1 to count_min_max_depth.  Other
+		/// values are reported via on_signed_integer_out_of_range and clamped
+		/// @param update The update rule used by increment
+		/// @param seed Seed for the row hashes
+		explicit count_min_sketch(
+		  size_type width, size_type depth = 4,
+		  count_min_update update = count_min_update::standard,
+		  std::uint64_t seed = 0x2545'F491'4F6C'DD1DULL )
+		  : m_update( update )
+		  , m_seed( seed ) {
+			if( DAW_UNLIKELY( depth == 0 or depth > count_min_max_depth or
+			                  width > ( size_type{ 1 } << 31U ) ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				depth = ( std::clamp )( depth, size_type{ 1 }, count_min_max_depth );
+				width = ( std::min )( width, size_type{ 1 } << 31U );
+			}
+			while( ( size_type{ 1 } << m_width_bits ) < width ) {
+				++m_width_bits;
+			}
+			m_depth = depth;
+			m_counters.resize( m_depth << m_width_bits );
+		}
+
+		[[nodiscard]] size_type width( ) const noexcept {
+			return m_counters.empty( ) ? 0 : size_type{ 1 } << m_width_bits;
+		}
+
+		[[nodiscard]] size_type depth( ) const noexcept {
+			return m_depth;
+		}
+
+		[[nodiscard]] count_min_update update_mode( ) const noexcept {
+			return m_update;
+		}
+
+		/// @brief Add amount to the count of key, saturating at
+		/// counter_type::max( ).  A negative amount is reported via
+		/// on_signed_integer_out_of_range and ignored
+		template<std::size_t KeyBits>
+		void increment( signed_integer<KeyBits> key,
+		                counter_type amount = counter_type( 1 ) ) {
+			if( DAW_UNLIKELY( amount < 0 ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				return;
+			}
+			increment_raw( key_bits( key ), amount.value( ) );
+		}
+
+		/// @brief Increment the count of each of count keys by one
+		template<std::size_t KeyBits>
+		void increment( signed_integer<KeyBits> const *keys, size_type count ) {
+			for( size_type n = 0; n < count; ++n ) {
+				increment_raw( key_bits( keys[n] ), raw_t{ 1 } );
+			}
+		}
+
+		template<typename Keys,
+		         std::enable_if_t<sint_impl::is_contiguous_range_v<Keys const> and
+		                            sint_impl::is_signed_integer_v<
+		                              sint_impl::range_value_t<Keys const>>,
+		                          std::nullptr_t> = nullptr>
+		void increment( Keys const &keys ) {
+			increment( std::data( keys ), std::size( keys ) );
+		}
+
+		/// @brief An upper bound of the count of key, the smallest of its
+		/// counters
+		template<std::size_t KeyBits>
+		[[nodiscard]] counter_type
+		estimate( signed_integer<KeyBits> key ) const noexcept {
+			if( m_counters.empty( ) ) {
+				return counter_type( 0 );
+			}
+			auto idx = indices_t{ };
+			indices_of( key_bits( key ), idx );
+			return counter_type( estimate_raw( idx ) );
+		}
+
+		void clear( ) noexcept {
+			std::fill( m_counters.begin( ), m_counters.end( ), raw_t{ 0 } );
+		}
+	};
+} // namespace daw::integers
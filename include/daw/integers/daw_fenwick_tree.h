@@ -0,0 +1,256 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace daw::integers {
+	/// @brief A Fenwick(binary indexed) tree of signed_integer weights giving
+	/// O(log n) point updates and prefix sums.  All node arithmetic is
+	/// checked.  An update that would overflow any node is reported via
+	/// on_signed_integer_overflow and leaves the tree unchanged, so a
+	/// rejected update never corrupts later queries.
+	template<std::size_t Bits>
+	struct fenwick_tree {
+		using value_type = signed_integer<Bits>;
+		using size_type = std::size_t;
+
+	private:
+		using raw_t = sint_impl::signed_integer_type_t<Bits>;
+
+		// 1 based, element 0 is unused.  Node i holds the sum of the
+		// ( i & -i ) weights ending at i
+		std::vector<raw_t> m_tree = std::vector<raw_t>( 1 );
+
+		static DAW_ATTRIB_INLINE constexpr size_type
+		lowbit( size_type i ) noexcept {
+			return i & ( ~i + 1U );
+		}
+
+		/// Turn the weights in tree[1..] into a Fenwick tree in place, each node
+		/// is added to its parent once
+		[[nodiscard]] static bool build_in_place( std::vector<raw_t> &tree ) {
+			auto const n = tree.size( ) - 1;
+			for( size_type i = 1; i <= n; ++i ) {
+				auto const parent = i + lowbit( i );
+				if( parent <= n and
+				    DAW_UNLIKELY( sint_impl::wrapping_add( tree[parent], tree[i],
+				                                           tree[parent] ) ) ) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+	public:
+		fenwick_tree( ) = default;
+
+		/// @brief A tree of size weights that are all zero
+		explicit fenwick_tree( size_type size )
+		  : m_tree( size + 1 ) {}
+
+		/// @brief Build from count weights in O(n).  When a node would overflow
+		/// on_signed_integer_overflow is called and the tree is left with all
+		/// weights zero
+		fenwick_tree( value_type const *weights, size_type count )
+		  : m_tree( count + 1 ) {
+			auto const *const raw = sint_impl::raw_ptr( weights );
+			for( size_type i = 0; i < count; ++i ) {
+				m_tree[i + 1] = raw[i];
+			}
+			if( DAW_UNLIKELY( not build_in_place( m_tree ) ) ) {
+				DAW_UNLIKELY_BRANCH
+				m_tree.assign( count + 1, raw_t{ 0 } );
+				on_signed_integer_overflow( );
+			}
+		}
+
+		template<typename Range,
+		         std::enable_if_t<
+		           sint_impl::is_contiguous_range_v<Range const> and
+		             std::is_same_v<sint_impl::range_value_t<Range const>,
+		                            value_type>,
+		           std::nullptr_t> = nullptr>
+		explicit fenwick_tree( Range const &weights )
+		  : fenwick_tree( std::data( weights ), std::size( weights ) ) {}
+
+		[[nodiscard]] size_type size( ) const noexcept {
+			return m_tree.size( ) - 1;
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return size( ) == 0;
+		}
+
+		/// @brief Add delta to the weight at index.  An index past the end is
+		/// reported via on_signed_integer_out_of_range
+		/// @return true when the update was applied
+		bool add( size_type index, value_type delta ) {
+			auto const n = size( );
+			if( DAW_UNLIKELY( index >= n ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				return false;
+			}
+			// Validate the whole path before writing so that a failure leaves
+			// every node as it was.  The path has at most one node per bit
+			raw_t updated[sizeof( size_type ) * 8];
+			size_type len = 0;
+			for( auto i = index + 1; i <= n; i += lowbit( i ) ) {
+				if( DAW_UNLIKELY( sint_impl::wrapping_add( m_tree[i], delta.value( ),
+				                                           updated[len++] ) ) ) {
+					DAW_UNLIKELY_BRANCH
+					on_signed_integer_overflow( );
+					return false;
+				}
+			}
+			len = 0;
+			for( auto i = index + 1; i <= n; i += lowbit( i ) ) {
+				m_tree[i] = updated[len++];
+			}
+			return true;
+		}
+
+		/// @brief Apply count updates, deltas[k] to the weight at indices[k].
+		/// Small batches are applied one at a time; large ones are built into a
+		/// tree of deltas in O(n) and added node by node.  Either the whole
+		/// batch is applied or, on overflow or an invalid index, none of it is
+		/// @return true when the batch was applied
+		bool add( size_type const *indices, value_type const *deltas,
+		          size_type count ) {
+			auto const n = size( );
+			for( size_type k = 0; k < count; ++k ) {
+				if( DAW_UNLIKELY( indices[k] >= n ) ) {
+					DAW_UNLIKELY_BRANCH
+					on_signed_integer_out_of_range( );
+					return false;
+				}
+			}
+			size_type log_n = 1;
+			while( ( size_type{ 1 } << log_n ) < n ) {
+				++log_n;
+			}
+			auto next = std::vector<raw_t>( );
+			if( count * log_n < n ) {
+				next = m_tree;
+				for( size_type k = 0; k < count; ++k ) {
+					for( auto i = indices[k] + 1; i <= n; i += lowbit( i ) ) {
+						if( DAW_UNLIKELY( sint_impl::wrapping_add(
+						      next[i], deltas[k].value( ), next[i] ) ) ) {
+							DAW_UNLIKELY_BRANCH
+							on_signed_integer_overflow( );
+							return false;
+						}
+					}
+				}
+			} else {
+				next = std::vector<raw_t>( n + 1 );
+				for( size_type k = 0; k < count; ++k ) {
+					auto &w = next[indices[k] + 1];
+					if( DAW_UNLIKELY(
+					      sint_impl::wrapping_add( w, deltas[k].value( ), w ) ) ) {
+						DAW_UNLIKELY_BRANCH
+						on_signed_integer_overflow( );
+						return false;
+					}
+				}
+				// A Fenwick tree is linear in its weights
+				bool ok = build_in_place( next );
+				for( size_type i = 1; ok and i <= n; ++i ) {
+					ok = not sint_impl::wrapping_add( next[i], m_tree[i], next[i] );
+				}
+				if( DAW_UNLIKELY( not ok ) ) {
+					DAW_UNLIKELY_BRANCH
+					on_signed_integer_overflow( );
+					return false;
+				}
+			}
+			m_tree = std::move( next );
+			return true;
+		}
+
+		template<
+		  typename Indices, typename Deltas,
+		  std::enable_if_t<sint_impl::is_contiguous_range_v<Indices const> and
+		                     sint_impl::is_contiguous_range_v<Deltas const>,
+		                   std::nullptr_t> = nullptr>
+		bool add( Indices const &indices, Deltas const &deltas ) {
+			if( DAW_UNLIKELY( std::size( indices ) != std::size( deltas ) ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				return false;
+			}
+			return add( std::data( indices ), std::data( deltas ),
+			            std::size( indices ) );
+		}
+
+		/// @brief The sum of the first count weights.  A count past the end is
+		/// reported via on_signed_integer_out_of_range and treated as size( )
+		[[nodiscard]] value_type prefix_sum( size_type count ) const {
+			if( DAW_UNLIKELY( count > size( ) ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				count = size( );
+			}
+			auto result = value_type( 0 );
+			for( auto i = count; i > 0; i -= lowbit( i ) ) {
+				result = result.add_checked( value_type( m_tree[i] ) );
+			}
+			return result;
+		}
+
+		/// @brief The sum of the weights in [first, last)
+		[[nodiscard]] value_type range_sum( size_type first,
+		                                    size_type last ) const {
+			return prefix_sum( last ).sub_checked( prefix_sum( first ) );
+		}
+
+		/// @brief The weight at index
+		[[nodiscard]] value_type operator[]( size_type index ) const {
+			return range_sum( index, index + 1 );
+		}
+
+		/// @brief The smallest count such that prefix_sum( count + 1 ) >= target,
+		/// or size( ) when there is none.  Found in one top down pass over the
+		/// tree, this requires all weights to be non-negative
+		[[nodiscard]] size_type lower_bound( value_type target ) const noexcept {
+			auto const n = size( );
+			auto remaining = target.value( );
+			size_type pos = 0;
+			size_type step = 1;
+			while( ( step << 1U ) <= n ) {
+				step <<= 1U;
+			}
+			for( ; step != 0; step >>= 1U ) {
+				auto const next = pos + step;
+				if( next <= n and m_tree[next] < remaining ) {
+					pos = next;
+					remaining = static_cast<raw_t>( remaining - m_tree[next] );
+				}
+			}
+			return pos;
+		}
+	};
+
+	template<typename Range,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Range const>,
+	                          std::nullptr_t> = nullptr>
+	fenwick_tree( Range const & )
+	  -> fenwick_tree<sizeof( sint_impl::range_value_t<Range const> ) * 8>;
+} // namespace daw::integers
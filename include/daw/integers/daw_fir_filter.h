@@ -0,0 +1,253 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+#include "impl/daw_signed_simd.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace daw::integers {
+	namespace sint_impl {
+		/// @brief floor( ( acc + 2^( shift - 1 ) ) / 2^shift ) without the add,
+		/// so it cannot overflow
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr T rounding_shift( T acc, int shift ) noexcept {
+			if( shift == 0 ) {
+				return acc;
+			}
+			return static_cast<T>( ( acc >> shift ) +
+			                       ( ( acc >> ( shift - 1 ) ) & 1 ) );
+		}
+	} // namespace sint_impl
+
+	/// @brief A streaming FIR filter over i16 samples with i16 fixed point
+	/// coefficients, y[n] = sum( h[j] * x[n - j] ) rounded and shifted right
+	/// by shift bits and saturated to i16.  The sum is exact: the result is
+	/// i16::conversion_saturated of the rounded exact sum, and the samples
+	/// before the first one are 0.  Blocks passed to process continue the
+	/// same signal, the last taps - 1 samples are kept between calls.
+	///
+	/// When the absolute values of the coefficients add up to less than 2^16
+	/// no i32 sum can overflow, and with AVX2 sixteen outputs are computed at
+	/// once from pairs of taps with pmaddwd, narrowed with a saturating pack.
+	/// Other filters accumulate in i64.
+	struct fir_filter {
+		using size_type = std::size_t;
+
+	private:
+		static constexpr size_type chunk_size = 2048;
+		static constexpr size_type lanes = 16;
+
+		std::vector<std::int16_t> m_taps{ };
+		// Coefficient pairs h[2p] | h[2p + 1] << 16 for pmaddwd
+		std::vector<std::int32_t> m_pairs{ };
+		// m_history samples of state followed by the chunk being filtered
+		std::vector<std::int16_t> m_buffer{ };
+		size_type m_history = 0;
+		int m_shift = 0;
+		bool m_fits_i32 = true;
+
+		template<typename Acc>
+		DAW_ATTRIB_INLINE std::int16_t
+		filter_one( std::int16_t const *x ) const noexcept {
+			Acc acc = 0;
+			for( size_type j = 0; j < m_taps.size( ); ++j ) {
+				acc += static_cast<Acc>( m_taps[j] ) * static_cast<Acc>( *( x - j ) );
+			}
+			return i16::conversion_saturated(
+			         sint_impl::rounding_shift( acc, m_shift ) )
+			  .value( );
+		}
+
+		/// Filter count samples stored at m_buffer[m_history, m_history + count)
+		void filter_chunk( size_type count, std::int16_t *out ) const noexcept {
+			auto const *const x = m_buffer.data( ) + m_history;
+			size_type n = 0;
+			if( not m_fits_i32 ) {
+				for( ; n < count; ++n ) {
+					out[n] = filter_one<std::int64_t>( x + n );
+				}
+				return;
+			}
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+			auto const shift = _mm_cvtsi32_si128( m_shift );
+			auto const round_shift = _mm_cvtsi32_si128( m_shift - 1 );
+			auto const one = _mm256_set1_epi32( 1 );
+			for( ; n + lanes <= count; n += lanes ) {
+				// lo holds outputs 0-3 and 8-11, hi 4-7 and 12-15, the order
+				// packs_epi32 puts back together
+				auto lo = _mm256_setzero_si256( );
+				auto hi = _mm256_setzero_si256( );
+				auto const *xp = x + n;
+				for( auto pair : m_pairs ) {
+					auto const a =
+					  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( xp ) );
+					auto const b =
+					  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( xp - 1 ) );
+					auto const h = _mm256_set1_epi32( pair );
+					lo = _mm256_add_epi32(
+					  lo, _mm256_madd_epi16( _mm256_unpacklo_epi16( a, b ), h ) );
+					hi = _mm256_add_epi32(
+					  hi, _mm256_madd_epi16( _mm256_unpackhi_epi16( a, b ), h ) );
+					xp -= 2;
+				}
+				if( m_shift > 0 ) {
+					auto const round = [&]( __m256i acc ) {
+						return _mm256_add_epi32(
+						  _mm256_sra_epi32( acc, shift ),
+						  _mm256_and_si256( _mm256_sra_epi32( acc, round_shift ), one ) );
+					};
+					lo = round( lo );
+					hi = round( hi );
+				}
+				_mm256_storeu_si256( reinterpret_cast<__m256i *>( out + n ),
+				                     _mm256_packs_epi32( lo, hi ) );
+			}
+#else
+			// A fixed number of outputs per tap keeps the inner loop simple
+			// enough for the compiler to vectorize
+			for( ; n + lanes <= count; n += lanes ) {
+				std::int32_t acc[lanes]{ };
+				for( size_type j = 0; j < m_taps.size( ); ++j ) {
+					auto const h = static_cast<std::int32_t>( m_taps[j] );
+					auto const *const xp = x + n - j;
+					for( size_type i = 0; i < lanes; ++i ) {
+						acc[i] += h * static_cast<std::int32_t>( xp[i] );
+					}
+				}
+				for( size_type i = 0; i < lanes; ++i ) {
+					out[n + i] = i16::conversion_saturated(
+					               sint_impl::rounding_shift( acc[i], m_shift ) )
+					               .value( );
+				}
+			}
+#endif
+			for( ; n < count; ++n ) {
+				out[n] = filter_one<std::int32_t>( x + n );
+			}
+		}
+
+	public:
+		/// @param coefficients The taps h[0], h[1], ...  At least one is required
+		/// @param taps The number of coefficients
+		/// @param shift The right shift applied to the sums, in [0, 31].  A
+		/// shift outside of it or an empty filter is reported via
+		/// on_signed_integer_out_of_range; the shift is clamped and an empty
+		/// filter outputs 0
+		fir_filter( i16 const *coefficients, size_type taps, i32 shift ) {
+			if( DAW_UNLIKELY( taps == 0 or shift < 0 or shift > 31 ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+			}
+			m_shift = static_cast<int>( ( std::clamp )( shift.value( ), 0, 31 ) );
+			auto const *const h = sint_impl::raw_ptr( coefficients );
+			m_taps.assign( h, h + taps );
+			if( m_taps.empty( ) ) {
+				m_taps.push_back( 0 );
+			}
+			std::int64_t magnitude = 0;
+			for( auto t : m_taps ) {
+				magnitude += t < 0 ? -std::int64_t{ t } : std::int64_t{ t };
+			}
+			// |sum| <= magnitude * 2^15, and so is every pair pmaddwd adds
+			m_fits_i32 = magnitude < 65536;
+			auto const padded = m_taps.size( ) + m_taps.size( ) % 2;
+			for( size_type j = 0; j < padded; j += 2 ) {
+				auto const h0 = static_cast<std::uint16_t>( m_taps[j] );
+				auto const h1 = static_cast<std::uint16_t>(
+				  j + 1 < m_taps.size( ) ? m_taps[j + 1] : 0 );
+				m_pairs.push_back( static_cast<std::int32_t>(
+				  static_cast<std::uint32_t>( h0 ) |
+				  ( static_cast<std::uint32_t>( h1 ) << 16U ) ) );
+			}
+			m_history = padded;
+			m_buffer.assign( m_history + chunk_size, 0 );
+		}
+
+		template<typename Range,
+		         std::enable_if_t<sint_impl::is_contiguous_range_v<Range const>,
+		                          std::nullptr_t> = nullptr>
+		fir_filter( Range const &coefficients, i32 shift )
+		  : fir_filter( std::data( coefficients ),
+		                static_cast<size_type>( std::size( coefficients ) ),
+		                shift ) {
+			static_assert(
+			  std::is_same_v<sint_impl::range_value_t<Range const>, i16>,
+			  "fir_filter requires a range of i16 coefficients" );
+		}
+
+		[[nodiscard]] size_type taps( ) const noexcept {
+			return m_taps.size( );
+		}
+
+		[[nodiscard]] i32 shift( ) const noexcept {
+			return i32( m_shift );
+		}
+
+		/// @brief Forget the previous samples, as if the filter was new
+		void reset( ) noexcept {
+			std::fill( m_buffer.begin( ), m_buffer.end( ), std::int16_t{ 0 } );
+		}
+
+		/// @brief Filter the next count samples of the signal.  in and out may
+		/// be the same array
+		void process( i16 const *in, size_type count, i16 *out ) {
+			auto const *src = sint_impl::raw_ptr( in );
+			auto *dst = sint_impl::raw_ptr( out );
+			auto *const state = m_buffer.data( );
+			while( count > 0 ) {
+				auto const chunk = ( std::min )( count, chunk_size );
+				std::copy( src, src + chunk, state + m_history );
+				filter_chunk( chunk, dst );
+				// The last m_history samples are the state for the next chunk
+				std::copy( state + chunk, state + chunk + m_history, state );
+				src += chunk;
+				dst += chunk;
+				count -= chunk;
+			}
+		}
+
+		template<typename In, typename Out,
+		         std::enable_if_t<sint_impl::is_contiguous_range_v<In const> and
+		                            sint_impl::is_contiguous_range_v<Out>,
+		                          std::nullptr_t> = nullptr>
+		void process( In const &in, Out &&out ) {
+			static_assert(
+			  std::is_same_v<sint_impl::range_value_t<In const>, i16> and
+			    std::is_same_v<sint_impl::range_value_t<Out>, i16>,
+			  "fir_filter::process requires ranges of i16" );
+			auto const count = static_cast<size_type>( std::size( in ) );
+			if( DAW_UNLIKELY( static_cast<size_type>( std::size( out ) ) < count ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				return;
+			}
+			process( std::data( in ), count, std::data( out ) );
+		}
+	};
+
+	/// @brief Convolve count samples of x with the taps coefficients h,
+	/// starting from a zero state.  See fir_filter
+	inline void fir_convolve( i16 const *x, std::size_t count, i16 const *h,
+	                          std::size_t taps, i32 shift, i16 *y ) {
+		auto filter = fir_filter( h, taps, shift );
+		filter.process( x, count, y );
+	}
+} // namespace daw::integers
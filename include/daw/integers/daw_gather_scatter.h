@@ -0,0 +1,339 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+#include "impl/daw_signed_simd.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace daw::integers {
+	/// @brief How many elements ahead of the current one the gather/scatter
+	/// kernels prefetch.  0 disables software prefetching
+	inline constexpr std::size_t default_gather_prefetch_distance = 16;
+
+	namespace sint_impl {
+		/// Indices are validated a block at a time so that the validation pass
+		/// stays in cache for the access pass that follows it
+		inline constexpr std::size_t gather_block_size = 512;
+
+		/// @brief Position of the first index in [0, count) that is not in [0,
+		/// size), or count when all are valid.  The common all valid case is a
+		/// branch free reduction that compilers lower to packed compares
+		template<typename Index>
+		DAW_ATTRIB_INLINE std::size_t
+		find_invalid_index( Index const *idx, std::size_t count,
+		                    std::size_t size ) noexcept {
+			using unsigned_t = std::make_unsigned_t<Index>;
+			// Negative indices become values larger than any valid limit
+			auto const limit = static_cast<unsigned_t>( ( std::min )(
+			  size, static_cast<std::size_t>(
+			          daw::numeric_limits<Index>::max( ) ) +
+			          1U ) );
+			bool any_invalid = false;
+			for( std::size_t n = 0; n < count; ++n ) {
+				any_invalid |= static_cast<unsigned_t>( idx[n] ) >= limit;
+			}
+			if( DAW_LIKELY( not any_invalid ) ) {
+				return count;
+			}
+			DAW_UNLIKELY_BRANCH
+			for( std::size_t n = 0; n < count; ++n ) {
+				if( static_cast<unsigned_t>( idx[n] ) >= limit ) {
+					return n;
+				}
+			}
+			return count;
+		}
+
+		/// @brief Prefetch the elements of data referenced by idx[first,
+		/// first + width) that are within the validated count
+		template<bool Write, typename T, typename Index>
+		DAW_ATTRIB_INLINE void
+		prefetch_indexed( T const *data, Index const *idx, std::size_t first,
+		                  std::size_t width, std::size_t count ) noexcept {
+			auto const last = ( std::min )( first + width, count );
+			for( ; first < last; ++first ) {
+				if constexpr( Write ) {
+					prefetch_write( data + static_cast<std::size_t>( idx[first] ) );
+				} else {
+					prefetch_read( data + static_cast<std::size_t>( idx[first] ) );
+				}
+			}
+		}
+
+		template<typename T, typename Index>
+		DAW_ATTRIB_INLINE void
+		gather_block( T const *data, Index const *idx, std::size_t count, T *out,
+		              std::size_t prefetch_distance ) noexcept {
+			std::size_t n = 0;
+#if defined( DAW_INTEGERS_HAS_AVX512F )
+			// The masked gathers with a zeroed source, because the unmasked ones
+			// pass an undefined source that gcc warns may be uninitialized
+			if constexpr( sizeof( T ) == 4 and sizeof( Index ) == 4 ) {
+				for( ; n + 16 <= count; n += 16 ) {
+					if( prefetch_distance > 0 ) {
+						prefetch_indexed<false>( data, idx, n + prefetch_distance, 16,
+						                         count );
+					}
+					auto const vidx = _mm512_loadu_si512( idx + n );
+					auto const vals = _mm512_mask_i32gather_epi32(
+					  _mm512_setzero_si512( ), 0xFFFF, vidx, data, 4 );
+					_mm512_storeu_si512( out + n, vals );
+				}
+			} else if constexpr( sizeof( T ) == 8 and sizeof( Index ) == 4 ) {
+				for( ; n + 8 <= count; n += 8 ) {
+					if( prefetch_distance > 0 ) {
+						prefetch_indexed<false>( data, idx, n + prefetch_distance, 8,
+						                         count );
+					}
+					auto const vidx = _mm256_loadu_si256(
+					  reinterpret_cast<__m256i const *>( idx + n ) );
+					auto const vals = _mm512_mask_i32gather_epi64(
+					  _mm512_setzero_si512( ), 0xFF, vidx, data, 8 );
+					_mm512_storeu_si512( out + n, vals );
+				}
+			} else if constexpr( sizeof( T ) == 8 and sizeof( Index ) == 8 ) {
+				for( ; n + 8 <= count; n += 8 ) {
+					if( prefetch_distance > 0 ) {
+						prefetch_indexed<false>( data, idx, n + prefetch_distance, 8,
+						                         count );
+					}
+					auto const vidx = _mm512_loadu_si512( idx + n );
+					auto const vals = _mm512_mask_i64gather_epi64(
+					  _mm512_setzero_si512( ), 0xFF, vidx, data, 8 );
+					_mm512_storeu_si512( out + n, vals );
+				}
+			}
+#elif defined( DAW_INTEGERS_HAS_AVX2 )
+			if constexpr( sizeof( T ) == 4 and sizeof( Index ) == 4 ) {
+				for( ; n + 8 <= count; n += 8 ) {
+					if( prefetch_distance > 0 ) {
+						prefetch_indexed<false>( data, idx, n + prefetch_distance, 8,
+						                         count );
+					}
+					auto const vidx = _mm256_loadu_si256(
+					  reinterpret_cast<__m256i const *>( idx + n ) );
+					auto const vals = _mm256_i32gather_epi32(
+					  reinterpret_cast<int const *>( data ), vidx, 4 );
+					_mm256_storeu_si256( reinterpret_cast<__m256i *>( out + n ), vals );
+				}
+			} else if constexpr( sizeof( T ) == 8 and sizeof( Index ) == 4 ) {
+				for( ; n + 4 <= count; n += 4 ) {
+					if( prefetch_distance > 0 ) {
+						prefetch_indexed<false>( data, idx, n + prefetch_distance, 4,
+						                         count );
+					}
+					auto const vidx =
+					  _mm_loadu_si128( reinterpret_cast<__m128i const *>( idx + n ) );
+					auto const vals = _mm256_i32gather_epi64(
+					  reinterpret_cast<long long const *>( data ), vidx, 8 );
+					_mm256_storeu_si256( reinterpret_cast<__m256i *>( out + n ), vals );
+				}
+			} else if constexpr( sizeof( T ) == 8 and sizeof( Index ) == 8 ) {
+				for( ; n + 4 <= count; n += 4 ) {
+					if( prefetch_distance > 0 ) {
+						prefetch_indexed<false>( data, idx, n + prefetch_distance, 4,
+						                         count );
+					}
+					auto const vidx = _mm256_loadu_si256(
+					  reinterpret_cast<__m256i const *>( idx + n ) );
+					auto const vals = _mm256_i64gather_epi64(
+					  reinterpret_cast<long long const *>( data ), vidx, 8 );
+					_mm256_storeu_si256( reinterpret_cast<__m256i *>( out + n ), vals );
+				}
+			}
+#endif
+			for( ; n < count; ++n ) {
+				if( prefetch_distance > 0 ) {
+					prefetch_indexed<false>( data, idx, n + prefetch_distance, 1, count );
+				}
+				out[n] = data[static_cast<std::size_t>( idx[n] )];
+			}
+		}
+
+		template<typename T, typename Index>
+		DAW_ATTRIB_INLINE void
+		scatter_block( T const *data, Index const *idx, std::size_t count, T *out,
+		               std::size_t prefetch_distance ) noexcept {
+			std::size_t n = 0;
+#if defined( DAW_INTEGERS_HAS_AVX512F )
+			// Conflicting lanes are written from lowest to highest so the last
+			// duplicate index wins, the same as the scalar loop
+			if constexpr( sizeof( T ) == 4 and sizeof( Index ) == 4 ) {
+				for( ; n + 16 <= count; n += 16 ) {
+					if( prefetch_distance > 0 ) {
+						prefetch_indexed<true>( out, idx, n + prefetch_distance, 16,
+						                        count );
+					}
+					auto const vidx = _mm512_loadu_si512( idx + n );
+					auto const vals = _mm512_loadu_si512( data + n );
+					_mm512_i32scatter_epi32( out, vidx, vals, 4 );
+				}
+			} else if constexpr( sizeof( T ) == 8 and sizeof( Index ) == 4 ) {
+				for( ; n + 8 <= count; n += 8 ) {
+					if( prefetch_distance > 0 ) {
+						prefetch_indexed<true>( out, idx, n + prefetch_distance, 8,
+						                        count );
+					}
+					auto const vidx = _mm256_loadu_si256(
+					  reinterpret_cast<__m256i const *>( idx + n ) );
+					auto const vals = _mm512_loadu_si512( data + n );
+					_mm512_i32scatter_epi64( out, vidx, vals, 8 );
+				}
+			} else if constexpr( sizeof( T ) == 8 and sizeof( Index ) == 8 ) {
+				for( ; n + 8 <= count; n += 8 ) {
+					if( prefetch_distance > 0 ) {
+						prefetch_indexed<true>( out, idx, n + prefetch_distance, 8,
+						                        count );
+					}
+					auto const vidx = _mm512_loadu_si512( idx + n );
+					auto const vals = _mm512_loadu_si512( data + n );
+					_mm512_i64scatter_epi64( out, vidx, vals, 8 );
+				}
+			}
+#endif
+			for( ; n < count; ++n ) {
+				if( prefetch_distance > 0 ) {
+					prefetch_indexed<true>( out, idx, n + prefetch_distance, 1, count );
+				}
+				out[static_cast<std::size_t>( idx[n] )] = data[n];
+			}
+		}
+	} // namespace sint_impl
+
+	/// @brief Perform out[n] = data[idx[n]] for each n in [0, count).  Indices
+	/// are validated in bulk before use; the first index outside of [0,
+	/// data_size) is reported via on_signed_integer_out_of_range and stops the
+	/// gather.
+	/// @param prefetch_distance How far ahead, in elements, to prefetch data.
+	/// 0 disables prefetching
+	/// @return The number of elements of out written.  This is count unless an
+	/// invalid index was found, in which case it is the position of that index
+	template<typename T, std::size_t IndexBits>
+	std::size_t
+	gather_checked( T const *data, std::size_t data_size,
+	                signed_integer<IndexBits> const *idx, std::size_t count,
+	                T *out,
+	                std::size_t prefetch_distance =
+	                  default_gather_prefetch_distance ) {
+		static_assert( std::is_trivially_copyable_v<T>,
+		               "gather_checked requires trivially copyable elements" );
+		auto const *const raw_idx = sint_impl::raw_ptr( idx );
+		for( std::size_t first = 0; first < count;
+		     first += sint_impl::gather_block_size ) {
+			auto const block_size =
+			  ( std::min )( sint_impl::gather_block_size, count - first );
+			auto const valid_size = sint_impl::find_invalid_index(
+			  raw_idx + first, block_size, data_size );
+			sint_impl::gather_block( data, raw_idx + first, valid_size, out + first,
+			                         prefetch_distance );
+			if( DAW_UNLIKELY( valid_size != block_size ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				return first + valid_size;
+			}
+		}
+		return count;
+	}
+
+	/// @brief Perform out[n] = data[idx[n]] for each element of idx.  See the
+	/// pointer overload for details.  An out range that is smaller than idx is
+	/// reported via on_signed_integer_out_of_range and only the elements that
+	/// fit are gathered
+	template<typename Data, typename Indices, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Data const> and
+	                            sint_impl::is_contiguous_range_v<Indices const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	std::size_t
+	gather_checked( Data const &data, Indices const &idx, Out &&out,
+	                std::size_t prefetch_distance =
+	                  default_gather_prefetch_distance ) {
+		auto count = static_cast<std::size_t>( std::size( idx ) );
+		if( DAW_UNLIKELY( std::size( out ) < count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			count = static_cast<std::size_t>( std::size( out ) );
+		}
+		return gather_checked( std::data( data ),
+		                       static_cast<std::size_t>( std::size( data ) ),
+		                       std::data( idx ), count, std::data( out ),
+		                       prefetch_distance );
+	}
+
+	/// @brief Perform out[idx[n]] = data[n] for each n in [0, count).  Indices
+	/// are validated in bulk before use; the first index outside of [0,
+	/// out_size) is reported via on_signed_integer_out_of_range and stops the
+	/// scatter.  When an index repeats, the last write wins.
+	/// @param prefetch_distance How far ahead, in elements, to prefetch the
+	/// destination.  0 disables prefetching
+	/// @return The number of elements of data written.  This is count unless an
+	/// invalid index was found, in which case it is the position of that index
+	template<typename T, std::size_t IndexBits>
+	std::size_t
+	scatter_checked( T const *data, signed_integer<IndexBits> const *idx,
+	                 std::size_t count, T *out, std::size_t out_size,
+	                 std::size_t prefetch_distance =
+	                   default_gather_prefetch_distance ) {
+		static_assert( std::is_trivially_copyable_v<T>,
+		               "scatter_checked requires trivially copyable elements" );
+		auto const *const raw_idx = sint_impl::raw_ptr( idx );
+		for( std::size_t first = 0; first < count;
+		     first += sint_impl::gather_block_size ) {
+			auto const block_size =
+			  ( std::min )( sint_impl::gather_block_size, count - first );
+			auto const valid_size =
+			  sint_impl::find_invalid_index( raw_idx + first, block_size, out_size );
+			sint_impl::scatter_block( data + first, raw_idx + first, valid_size,
+			                          out, prefetch_distance );
+			if( DAW_UNLIKELY( valid_size != block_size ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				return first + valid_size;
+			}
+		}
+		return count;
+	}
+
+	/// @brief Perform out[idx[n]] = data[n] for each element of idx.  See the
+	/// pointer overload for details.  A data range that is smaller than idx is
+	/// reported via on_signed_integer_out_of_range and only the elements
+	/// available are scattered
+	template<typename Data, typename Indices, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Data const> and
+	                            sint_impl::is_contiguous_range_v<Indices const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	std::size_t
+	scatter_checked( Data const &data, Indices const &idx, Out &&out,
+	                 std::size_t prefetch_distance =
+	                   default_gather_prefetch_distance ) {
+		auto count = static_cast<std::size_t>( std::size( idx ) );
+		if( DAW_UNLIKELY( std::size( data ) < count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			count = static_cast<std::size_t>( std::size( data ) );
+		}
+		return scatter_checked( std::data( data ), std::data( idx ), count,
+		                        std::data( out ),
+		                        static_cast<std::size_t>( std::size( out ) ),
+		                        prefetch_distance );
+	}
+} // namespace daw::integers
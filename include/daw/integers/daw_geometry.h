@@ -0,0 +1,432 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "daw_wide_arithmetic.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+#include "impl/daw_signed_simd.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace daw::integers {
+	template<typename T>
+	struct vec2 {
+		T x{ };
+		T y{ };
+
+		[[nodiscard]] friend constexpr bool operator==( vec2 const &lhs,
+		                                                vec2 const &rhs ) {
+			return lhs.x == rhs.x and lhs.y == rhs.y;
+		}
+
+		[[nodiscard]] friend constexpr bool operator!=( vec2 const &lhs,
+		                                                vec2 const &rhs ) {
+			return not( lhs == rhs );
+		}
+	};
+
+	template<typename T>
+	struct vec3 {
+		T x{ };
+		T y{ };
+		T z{ };
+
+		[[nodiscard]] friend constexpr bool operator==( vec3 const &lhs,
+		                                                vec3 const &rhs ) {
+			return lhs.x == rhs.x and lhs.y == rhs.y and lhs.z == rhs.z;
+		}
+
+		[[nodiscard]] friend constexpr bool operator!=( vec3 const &lhs,
+		                                                vec3 const &rhs ) {
+			return not( lhs == rhs );
+		}
+	};
+
+	namespace sint_impl {
+		/// @brief A two's complement integer of Words 64 bit words, least
+		/// significant first.  The intermediates of the predicates are built up
+		/// from i64 differences to 2 and 3 words
+		template<std::size_t Words>
+		struct wide_int {
+			std::uint64_t words[Words];
+		};
+
+		template<std::size_t Words>
+		DAW_ATTRIB_INLINE constexpr wide_int<Words>
+		widen( std::int64_t v ) noexcept {
+			auto result = wide_int<Words>{ };
+			result.words[0] = static_cast<std::uint64_t>( v );
+			for( std::size_t n = 1; n < Words; ++n ) {
+				result.words[n] = v < 0 ? ~std::uint64_t{ 0 } : std::uint64_t{ 0 };
+			}
+			return result;
+		}
+
+		template<std::size_t Words, std::size_t From>
+		DAW_ATTRIB_INLINE constexpr wide_int<Words>
+		widen( wide_int<From> const &v ) noexcept {
+			static_assert( Words >= From );
+			auto result = wide_int<Words>{ };
+			for( std::size_t n = 0; n < From; ++n ) {
+				result.words[n] = v.words[n];
+			}
+			auto const negative = ( v.words[From - 1] >> 63U ) != 0;
+			for( std::size_t n = From; n < Words; ++n ) {
+				result.words[n] = negative ? ~std::uint64_t{ 0 } : std::uint64_t{ 0 };
+			}
+			return result;
+		}
+
+		/// @brief The exact product of two i64
+		DAW_ATTRIB_INLINE constexpr wide_int<2>
+		wide_mul( std::int64_t a, std::int64_t b ) noexcept {
+			auto const p = mul_wide( i64( a ), i64( b ) );
+			return { { p.low, static_cast<std::uint64_t>( p.high.value( ) ) } };
+		}
+
+		/// @brief The product modulo 2^( 64 * Words ), exact when it fits
+		template<std::size_t Words>
+		DAW_ATTRIB_INLINE constexpr wide_int<Words>
+		wide_mul( wide_int<Words> const &a, wide_int<Words> const &b ) noexcept {
+			auto result = wide_int<Words>{ };
+			for( std::size_t i = 0; i < Words; ++i ) {
+				std::uint64_t carry = 0;
+				for( std::size_t j = 0; i + j < Words; ++j ) {
+					std::uint64_t hi = 0;
+					auto const lo = umul_wide( a.words[i], b.words[j], hi );
+					auto const s0 = add_carry( result.words[i + j], lo, false );
+					auto const s1 = add_carry( s0.value, carry, false );
+					result.words[i + j] = s1.value;
+					// a * b + r + carry < 2^128, so this cannot wrap
+					carry = hi + s0.carry + s1.carry;
+				}
+			}
+			return result;
+		}
+
+		template<std::size_t Words>
+		DAW_ATTRIB_INLINE constexpr wide_int<Words>
+		wide_add( wide_int<Words> const &a, wide_int<Words> const &b ) noexcept {
+			auto result = wide_int<Words>{ };
+			bool carry = false;
+			for( std::size_t n = 0; n < Words; ++n ) {
+				auto const s = add_carry( a.words[n], b.words[n], carry );
+				result.words[n] = s.value;
+				carry = s.carry;
+			}
+			return result;
+		}
+
+		template<std::size_t Words>
+		DAW_ATTRIB_INLINE constexpr wide_int<Words>
+		wide_sub( wide_int<Words> const &a, wide_int<Words> const &b ) noexcept {
+			auto result = wide_int<Words>{ };
+			bool borrow = false;
+			for( std::size_t n = 0; n < Words; ++n ) {
+				auto const d = sub_borrow( a.words[n], b.words[n], borrow );
+				result.words[n] = d.value;
+				borrow = d.carry;
+			}
+			return result;
+		}
+
+		/// @brief -1, 0 or 1
+		template<std::size_t Words>
+		DAW_ATTRIB_INLINE constexpr int
+		wide_sign( wide_int<Words> const &v ) noexcept {
+			if( ( v.words[Words - 1] >> 63U ) != 0 ) {
+				return -1;
+			}
+			for( std::size_t n = 0; n < Words; ++n ) {
+				if( v.words[n] != 0 ) {
+					return 1;
+				}
+			}
+			return 0;
+		}
+
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr std::int64_t wide( T v ) noexcept {
+			return static_cast<std::int64_t>( v.value( ) );
+		}
+
+		/// @brief orient2d( a, b, p ) for many p.  The determinant is
+		/// dx * p.y - dy * p.x - k with the segment's dx and dy split into a
+		/// signed high part and a 16 bit low part, so that every product with a
+		/// coordinate fits in 64 bits, and k is split the same way
+		struct orient2d_line {
+			std::int64_t dx_hi;
+			std::int64_t dx_lo;
+			std::int64_t dy_hi;
+			std::int64_t dy_lo;
+			std::int64_t k_hi;
+			std::int64_t k_lo;
+
+			template<std::size_t Bits>
+			constexpr orient2d_line( vec2<signed_integer<Bits>> a,
+			                         vec2<signed_integer<Bits>> b ) noexcept
+			  : dx_hi{ }
+			  , dx_lo{ }
+			  , dy_hi{ }
+			  , dy_lo{ }
+			  , k_hi{ }
+			  , k_lo{ } {
+				static_assert( Bits <= 32 );
+				auto const dx = wide( b.x ) - wide( a.x );
+				auto const dy = wide( b.y ) - wide( a.y );
+				dx_hi = dx >> 16;
+				dx_lo = dx & 0xFFFF;
+				dy_hi = dy >> 16;
+				dy_lo = dy & 0xFFFF;
+				// |k| < 2^66, so k >> 16 fits in 64 bits
+				auto const k =
+				  wide_sub( wide_mul( dx, wide( a.y ) ), wide_mul( dy, wide( a.x ) ) );
+				k_hi = static_cast<std::int64_t>( ( k.words[0] >> 16U ) |
+				                                  ( k.words[1] << 48U ) );
+				k_lo = static_cast<std::int64_t>( k.words[0] & 0xFFFFU );
+			}
+
+			/// |l| < 2^49, so l + 2^49 is positive and the carry from the low
+			/// part into the high part is a logical shift
+			static constexpr std::int64_t low_bias = std::int64_t{ 1 } << 49;
+
+			[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::int8_t
+			operator( )( std::int64_t px, std::int64_t py ) const noexcept {
+				auto const h = dx_hi * py - dy_hi * px - k_hi;
+				auto const l = dx_lo * py - dy_lo * px - k_lo;
+				auto const hi =
+				  h + static_cast<std::int64_t>(
+				        static_cast<std::uint64_t>( l + low_bias ) >> 16U ) -
+				  ( low_bias >> 16 );
+				auto const lo = l & 0xFFFF;
+				return static_cast<std::int8_t>( hi < 0 ? -1 : ( hi > 0 or lo > 0 ) );
+			}
+		};
+	} // namespace sint_impl
+
+	/// @brief The z of the cross product, a.x * b.y - a.y * b.x.  It is exact,
+	/// the magnitude is less than 2^63 for coordinates of at most 32 bits
+	template<std::size_t Bits>
+	[[nodiscard]] constexpr i64 cross( vec2<signed_integer<Bits>> a,
+	                                   vec2<signed_integer<Bits>> b ) noexcept {
+		static_assert( Bits <= 32, "Coordinates may have at most 32 bits" );
+		using sint_impl::wide;
+		return i64( wide( a.x ) * wide( b.y ) - wide( a.y ) * wide( b.x ) );
+	}
+
+	/// @brief The exact cross product
+	template<std::size_t Bits>
+	[[nodiscard]] constexpr vec3<i64>
+	cross( vec3<signed_integer<Bits>> a, vec3<signed_integer<Bits>> b ) noexcept {
+		static_assert( Bits <= 32, "Coordinates may have at most 32 bits" );
+		using sint_impl::wide;
+		return { i64( wide( a.y ) * wide( b.z ) - wide( a.z ) * wide( b.y ) ),
+		         i64( wide( a.z ) * wide( b.x ) - wide( a.x ) * wide( b.z ) ),
+		         i64( wide( a.x ) * wide( b.y ) - wide( a.y ) * wide( b.x ) ) };
+	}
+
+	/// @brief The dot product.  Each product is exact, a sum that does not fit
+	/// in i64 is reported via on_signed_integer_overflow
+	template<std::size_t Bits>
+	[[nodiscard]] constexpr i64 dot( vec2<signed_integer<Bits>> a,
+	                                 vec2<signed_integer<Bits>> b ) {
+		static_assert( Bits <= 32, "Coordinates may have at most 32 bits" );
+		using sint_impl::wide;
+		return i64( wide( a.x ) * wide( b.x ) )
+		  .add_checked( i64( wide( a.y ) * wide( b.y ) ) );
+	}
+
+	/// @brief The dot product.  Each product is exact, a sum that does not fit
+	/// in i64 is reported via on_signed_integer_overflow
+	template<std::size_t Bits>
+	[[nodiscard]] constexpr i64 dot( vec3<signed_integer<Bits>> a,
+	                                 vec3<signed_integer<Bits>> b ) {
+		static_assert( Bits <= 32, "Coordinates may have at most 32 bits" );
+		using sint_impl::wide;
+		return i64( wide( a.x ) * wide( b.x ) )
+		  .add_checked( i64( wide( a.y ) * wide( b.y ) ) )
+		  .add_checked( i64( wide( a.z ) * wide( b.z ) ) );
+	}
+
+	/// @brief The exact sign of ( b - a ) x ( c - a ).  1 when a, b, c turn
+	/// counterclockwise, -1 when clockwise and 0 when they are collinear
+	template<std::size_t Bits>
+	[[nodiscard]] constexpr int
+	orient2d( vec2<signed_integer<Bits>> a,
+	          vec2<signed_integer<Bits>> b,
+	          vec2<signed_integer<Bits>> c ) noexcept {
+		static_assert( Bits <= 32, "Coordinates may have at most 32 bits" );
+		using namespace sint_impl;
+		// The differences take 33 bits and their products 66
+		auto const l =
+		  wide_mul( wide( b.x ) - wide( a.x ), wide( c.y ) - wide( a.y ) );
+		auto const r =
+		  wide_mul( wide( b.y ) - wide( a.y ), wide( c.x ) - wide( a.x ) );
+		return wide_sign( wide_sub( l, r ) );
+	}
+
+	/// @brief The exact sign of the determinant of [ a - d, b - d, c - d ].  1
+	/// when d is below the plane through a, b, c, that is a, b, c appear
+	/// counterclockwise seen from above it, -1 when above and 0 when coplanar
+	template<std::size_t Bits>
+	[[nodiscard]] constexpr int
+	orient3d( vec3<signed_integer<Bits>> a,
+	          vec3<signed_integer<Bits>> b,
+	          vec3<signed_integer<Bits>> c,
+	          vec3<signed_integer<Bits>> d ) noexcept {
+		static_assert( Bits <= 32, "Coordinates may have at most 32 bits" );
+		using namespace sint_impl;
+		auto const adx = wide( a.x ) - wide( d.x );
+		auto const ady = wide( a.y ) - wide( d.y );
+		auto const adz = wide( a.z ) - wide( d.z );
+		auto const bdx = wide( b.x ) - wide( d.x );
+		auto const bdy = wide( b.y ) - wide( d.y );
+		auto const bdz = wide( b.z ) - wide( d.z );
+		auto const cdx = wide( c.x ) - wide( d.x );
+		auto const cdy = wide( c.y ) - wide( d.y );
+		auto const cdz = wide( c.z ) - wide( d.z );
+		// 67 bit minors times 33 bit differences fit in two words
+		auto const term = [&]( std::int64_t s, std::int64_t p0, std::int64_t p1,
+		                       std::int64_t q0, std::int64_t q1 ) {
+			return wide_mul( widen<2>( s ),
+			                 wide_sub( wide_mul( p0, p1 ), wide_mul( q0, q1 ) ) );
+		};
+		return wide_sign(
+		  wide_add( wide_add( term( adx, bdy, cdz, bdz, cdy ),
+		                      term( bdx, cdy, adz, cdz, ady ) ),
+		            term( cdx, ady, bdz, adz, bdy ) ) );
+	}
+
+	/// @brief The exact in-circle test.  For a, b, c in counterclockwise order
+	/// it is 1 when d is inside the circle through them, -1 when outside and 0
+	/// when on it.  The sign is flipped when a, b, c are clockwise
+	template<std::size_t Bits>
+	[[nodiscard]] constexpr int
+	in_circle( vec2<signed_integer<Bits>> a,
+	           vec2<signed_integer<Bits>> b,
+	           vec2<signed_integer<Bits>> c,
+	           vec2<signed_integer<Bits>> d ) noexcept {
+		static_assert( Bits <= 32, "Coordinates may have at most 32 bits" );
+		using namespace sint_impl;
+		auto const adx = wide( a.x ) - wide( d.x );
+		auto const ady = wide( a.y ) - wide( d.y );
+		auto const bdx = wide( b.x ) - wide( d.x );
+		auto const bdy = wide( b.y ) - wide( d.y );
+		auto const cdx = wide( c.x ) - wide( d.x );
+		auto const cdy = wide( c.y ) - wide( d.y );
+		// The 67 bit lifts and minors multiply to 134 bits, so three words
+		auto const term = [&]( std::int64_t lx, std::int64_t ly, std::int64_t p0,
+		                       std::int64_t p1, std::int64_t q0, std::int64_t q1 ) {
+			auto const lift = wide_add( wide_mul( lx, lx ), wide_mul( ly, ly ) );
+			auto const minor = wide_sub( wide_mul( p0, p1 ), wide_mul( q0, q1 ) );
+			return wide_mul( widen<3>( lift ), widen<3>( minor ) );
+		};
+		return wide_sign( wide_add(
+		  wide_add( term( adx, ady, bdx, cdy, cdx, bdy ),
+		            term( bdx, bdy, cdx, ady, adx, cdy ) ),
+		  term( cdx, cdy, adx, bdy, bdx, ady ) ) );
+	}
+
+	/// @brief out[i] = orient2d( a, b, points[i] ) for count points, the side
+	/// of the line through a and b that each point is on.  It is exact, and
+	/// with AVX2 four i32 points are classified at once
+	template<std::size_t Bits>
+	void orient2d( vec2<signed_integer<Bits>> a, vec2<signed_integer<Bits>> b,
+	               vec2<signed_integer<Bits>> const *points, std::size_t count,
+	               i8 *out ) noexcept {
+		static_assert( Bits <= 32, "Coordinates may have at most 32 bits" );
+		auto const line = sint_impl::orient2d_line( a, b );
+		auto *const result = sint_impl::raw_ptr( out );
+		std::size_t n = 0;
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+		if constexpr( Bits == 32 ) {
+			static_assert( sizeof( vec2<i32> ) == 2 * sizeof( std::int32_t ) );
+			// _mm256_mul_epi32 multiplies the signed low half of each 64 bit lane,
+			// which is x for a point loaded as is and y once shifted down
+			auto const dx_hi = _mm256_set1_epi64x( line.dx_hi );
+			auto const dx_lo = _mm256_set1_epi64x( line.dx_lo );
+			auto const dy_hi = _mm256_set1_epi64x( line.dy_hi );
+			auto const dy_lo = _mm256_set1_epi64x( line.dy_lo );
+			auto const k_hi = _mm256_set1_epi64x( line.k_hi );
+			auto const k_lo = _mm256_set1_epi64x( line.k_lo );
+			auto const bias = _mm256_set1_epi64x( line.low_bias );
+			auto const bias_hi = _mm256_set1_epi64x( line.low_bias >> 16 );
+			auto const low_mask = _mm256_set1_epi64x( 0xFFFF );
+			auto const zero = _mm256_setzero_si256( );
+			auto const low_dwords = _mm256_setr_epi32( 0, 2, 4, 6, 0, 2, 4, 6 );
+			for( ; n + 4 <= count; n += 4 ) {
+				auto const px = _mm256_loadu_si256(
+				  reinterpret_cast<__m256i const *>( points + n ) );
+				auto const py = _mm256_srli_epi64( px, 32 );
+				auto const h = _mm256_sub_epi64(
+				  _mm256_sub_epi64( _mm256_mul_epi32( dx_hi, py ),
+				                    _mm256_mul_epi32( dy_hi, px ) ),
+				  k_hi );
+				auto const l = _mm256_sub_epi64(
+				  _mm256_sub_epi64( _mm256_mul_epi32( dx_lo, py ),
+				                    _mm256_mul_epi32( dy_lo, px ) ),
+				  k_lo );
+				auto const hi = _mm256_sub_epi64(
+				  _mm256_add_epi64(
+				    h, _mm256_srli_epi64( _mm256_add_epi64( l, bias ), 16 ) ),
+				  bias_hi );
+				auto const lo = _mm256_and_si256( l, low_mask );
+				auto const positive = _mm256_or_si256(
+				  _mm256_cmpgt_epi64( hi, zero ),
+				  _mm256_and_si256( _mm256_cmpeq_epi64( hi, zero ),
+				                    _mm256_cmpgt_epi64( lo, zero ) ) );
+				auto const negative = _mm256_cmpgt_epi64( zero, hi );
+				// -1 - 0 for negative lanes and 0 - -1 for positive ones
+				auto const sign = _mm256_castsi256_si128( _mm256_permutevar8x32_epi32(
+				  _mm256_sub_epi64( negative, positive ), low_dwords ) );
+				auto const bytes =
+				  _mm_cvtsi128_si32( _mm_packs_epi16( _mm_packs_epi32( sign, sign ),
+				                                      _mm_setzero_si128( ) ) );
+				std::memcpy( result + n, &bytes, 4 );
+			}
+		}
+#endif
+		for( ; n < count; ++n ) {
+			result[n] = line( sint_impl::wide( points[n].x ),
+			                  sint_impl::wide( points[n].y ) );
+		}
+	}
+
+	/// @brief orient2d over a range of points.  out must be at least as large
+	/// as points, otherwise it is reported via on_signed_integer_out_of_range
+	/// and nothing is written
+	template<std::size_t Bits, typename Points, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Points const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	void orient2d( vec2<signed_integer<Bits>> a, vec2<signed_integer<Bits>> b,
+	               Points const &points, Out &&out ) {
+		static_assert(
+		  std::is_same_v<sint_impl::range_value_t<Points const>,
+		                 vec2<signed_integer<Bits>>> and
+		    std::is_same_v<sint_impl::range_value_t<Out>, i8>,
+		  "orient2d requires a range of points and a range of i8" );
+		auto const count = static_cast<std::size_t>( std::size( points ) );
+		if( DAW_UNLIKELY( static_cast<std::size_t>( std::size( out ) ) < count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			return;
+		}
+		orient2d( a, b, std::data( points ), count, std::data( out ) );
+	}
+} // namespace daw::integers
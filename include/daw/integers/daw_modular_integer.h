@@ -0,0 +1,410 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "daw_wide_arithmetic.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_cpp_feature_check.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace daw::integers {
+	namespace sint_impl {
+		/// Montgomery reduction works on words of 32 or 64 bits
+		template<std::size_t Bits>
+		using modular_word_t =
+		  std::conditional_t<( Bits <= 32 ), std::uint32_t, std::uint64_t>;
+
+		/// @brief ( a * b ) % m with a division.  Used for even moduli and to
+		/// set up Montgomery constants
+		template<typename U>
+		DAW_ATTRIB_INLINE constexpr U mulmod_plain( U a, U b, U m ) noexcept {
+			if constexpr( sizeof( U ) < 8 ) {
+				auto const p =
+				  static_cast<std::uint64_t>( a ) * static_cast<std::uint64_t>( b );
+				return static_cast<U>( p % m );
+			} else {
+#if defined( DAW_HAS_INT128 )
+				auto const p =
+				  static_cast<daw::uint128_t>( a ) * static_cast<daw::uint128_t>( b );
+				return static_cast<U>( p % m );
+#else
+				// Double and add, a and b are less than m < 2^63 so nothing wraps
+				U result = 0;
+				for( ; b != 0; b >>= 1U ) {
+					if( b & 1U ) {
+						result += a;
+						result = result >= m ? result - m : result;
+					}
+					a += a;
+					a = a >= m ? a - m : a;
+				}
+				return result;
+#endif
+			}
+		}
+	} // namespace sint_impl
+
+	/// @brief A positive modulus with precomputed reduction constants.  Odd
+	/// moduli use Montgomery multiplication, a multiply by a word constant
+	/// and a wide multiply instead of a division; even moduli fall back to a
+	/// wide product and a division.  A modulus can be built at compile time
+	/// and shared by any number of modular_integer values.
+	template<std::size_t Bits>
+	struct modulus {
+		using value_type = signed_integer<Bits>;
+		using word_type = sint_impl::modular_word_t<Bits>;
+
+	private:
+		static constexpr std::size_t word_bits = sizeof( word_type ) * CHAR_BIT;
+
+		word_type m_mod = 2;
+		// -m^-1 mod 2^word_bits
+		word_type m_neg_inv = 0;
+		// 2^word_bits mod m, the Montgomery form of 1
+		word_type m_r1 = 0;
+		// 2^( 2 * word_bits ) mod m
+		word_type m_r2 = 0;
+
+		/// @brief Montgomery reduction of hi * 2^word_bits + lo, hi < m
+		DAW_ATTRIB_INLINE constexpr word_type redc( word_type hi,
+		                                            word_type lo ) const noexcept {
+			auto const q = static_cast<word_type>( lo * m_neg_inv );
+			auto q_hi = word_type{ };
+			(void)sint_impl::umul_wide( q, m_mod, q_hi );
+			// lo + low( q * m ) is 0 mod 2^word_bits, it carries unless lo is 0
+			auto const t = static_cast<word_type>(
+			  hi + q_hi + static_cast<word_type>( lo != 0 ) );
+			return t >= m_mod ? static_cast<word_type>( t - m_mod ) : t;
+		}
+
+	public:
+		constexpr modulus( ) = default;
+
+		/// @param m The modulus.  A value less than 2 is reported via
+		/// on_signed_integer_out_of_range and 2 is used
+		explicit constexpr modulus( value_type m ) {
+			if( DAW_UNLIKELY( m < 2 ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				m = value_type( 2 );
+			}
+			m_mod = static_cast<word_type>( m.value( ) );
+			if( is_montgomery( ) ) {
+				// Newton's iteration doubles the correct low bits each step, m is
+				// its own inverse to 3 bits
+				auto inv = m_mod;
+				for( std::size_t bits = 3; bits < word_bits; bits *= 2 ) {
+					inv = static_cast<word_type>( inv * ( 2U - m_mod * inv ) );
+				}
+				m_neg_inv = static_cast<word_type>( word_type{ 0 } - inv );
+				m_r1 = static_cast<word_type>( static_cast<word_type>( 0U - m_mod ) %
+				                               m_mod );
+				m_r2 = sint_impl::mulmod_plain( m_r1, m_r1, m_mod );
+			}
+		}
+
+		[[nodiscard]] constexpr value_type value( ) const noexcept {
+			return value_type::conversion_unchecked(
+			  static_cast<sint_impl::signed_integer_type_t<Bits>>( m_mod ) );
+		}
+
+		/// @brief true when multiplication uses Montgomery reduction
+		[[nodiscard]] constexpr bool is_montgomery( ) const noexcept {
+			return ( m_mod & 1U ) != 0;
+		}
+
+		/// @brief Reduce value into [0, m) and convert it to the internal form
+		[[nodiscard]] constexpr word_type to_form( value_type value ) const {
+			auto const m = static_cast<sint_impl::signed_integer_type_t<Bits>>(
+			  m_mod );
+			auto r = static_cast<sint_impl::signed_integer_type_t<Bits>>(
+			  value.value( ) % m );
+			if( r < 0 ) {
+				r = static_cast<sint_impl::signed_integer_type_t<Bits>>( r + m );
+			}
+			auto const w = static_cast<word_type>( r );
+			return is_montgomery( ) ? mul( w, m_r2 ) : w;
+		}
+
+		/// @brief Convert from the internal form to a value in [0, m)
+		[[nodiscard]] constexpr value_type
+		from_form( word_type a ) const noexcept {
+			auto const w = is_montgomery( ) ? redc( 0, a ) : a;
+			return value_type::conversion_unchecked(
+			  static_cast<sint_impl::signed_integer_type_t<Bits>>( w ) );
+		}
+
+		/// @brief The internal form of 1
+		[[nodiscard]] constexpr word_type one( ) const noexcept {
+			return is_montgomery( ) ? m_r1 : word_type{ 1 };
+		}
+
+		/// @brief Product of two values in the internal form, for callers that
+		/// have already tested is_montgomery( ) outside of a loop
+		template<bool Montgomery>
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr word_type
+		mul_as( word_type a, word_type b ) const noexcept {
+			if constexpr( Montgomery ) {
+				auto hi = word_type{ };
+				auto const lo = sint_impl::umul_wide( a, b, hi );
+				return redc( hi, lo );
+			} else {
+				return sint_impl::mulmod_plain( a, b, m_mod );
+			}
+		}
+
+		/// @brief Product of two values in the internal form
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr word_type
+		mul( word_type a, word_type b ) const noexcept {
+			if( DAW_LIKELY( is_montgomery( ) ) ) {
+				return mul_as<true>( a, b );
+			}
+			return mul_as<false>( a, b );
+		}
+
+		/// @brief Sum of two values in the internal form
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr word_type
+		add( word_type a, word_type b ) const noexcept {
+			// m < 2^( word_bits - 1 ) so the sum cannot wrap
+			auto const s = static_cast<word_type>( a + b );
+			return s >= m_mod ? static_cast<word_type>( s - m_mod ) : s;
+		}
+
+		/// @brief Difference of two values in the internal form
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr word_type
+		sub( word_type a, word_type b ) const noexcept {
+			return a >= b ? static_cast<word_type>( a - b )
+			              : static_cast<word_type>( a + m_mod - b );
+		}
+
+		/// @brief base^exponent in the internal form, exponent >= 0
+		[[nodiscard]] constexpr word_type pow( word_type base,
+		                                       std::uint64_t exponent ) const {
+			auto result = one( );
+			for( ; exponent != 0; exponent >>= 1U ) {
+				if( exponent & 1U ) {
+					result = mul( result, base );
+				}
+				base = mul( base, base );
+			}
+			return result;
+		}
+
+		[[nodiscard]] constexpr bool
+		operator==( modulus const &rhs ) const noexcept {
+			return m_mod == rhs.m_mod;
+		}
+
+		[[nodiscard]] constexpr bool
+		operator!=( modulus const &rhs ) const noexcept {
+			return m_mod != rhs.m_mod;
+		}
+	};
+
+	template<std::size_t Bits>
+	modulus( signed_integer<Bits> ) -> modulus<Bits>;
+
+	/// @brief An integer modulo a shared modulus.  The modulus is referenced,
+	/// not copied, and must outlive the value.  Values combined by an
+	/// operator must use equal moduli.
+	template<std::size_t Bits>
+	struct modular_integer {
+		using value_type = signed_integer<Bits>;
+		using modulus_type = modulus<Bits>;
+
+	private:
+		using word_type = typename modulus_type::word_type;
+
+		modulus_type const *m_mod;
+		word_type m_value;
+
+		constexpr modular_integer( modulus_type const &mod,
+		                           word_type form ) noexcept
+		  : m_mod( &mod )
+		  , m_value( form ) {}
+
+	public:
+		/// @brief value reduced into [0, m)
+		constexpr modular_integer( value_type value, modulus_type const &mod )
+		  : m_mod( &mod )
+		  , m_value( mod.to_form( value ) ) {}
+
+		/// @brief The value in [0, m)
+		[[nodiscard]] constexpr value_type value( ) const noexcept {
+			return m_mod->from_form( m_value );
+		}
+
+		[[nodiscard]] constexpr modulus_type const &mod( ) const noexcept {
+			return *m_mod;
+		}
+
+		constexpr modular_integer &operator+=( modular_integer const &rhs ) {
+			assert( *m_mod == *rhs.m_mod );
+			m_value = m_mod->add( m_value, rhs.m_value );
+			return *this;
+		}
+
+		constexpr modular_integer &operator-=( modular_integer const &rhs ) {
+			assert( *m_mod == *rhs.m_mod );
+			m_value = m_mod->sub( m_value, rhs.m_value );
+			return *this;
+		}
+
+		constexpr modular_integer &operator*=( modular_integer const &rhs ) {
+			assert( *m_mod == *rhs.m_mod );
+			m_value = m_mod->mul( m_value, rhs.m_value );
+			return *this;
+		}
+
+		[[nodiscard]] constexpr modular_integer operator-( ) const {
+			return modular_integer( *m_mod,
+			                        m_mod->sub( word_type{ 0 }, m_value ) );
+		}
+
+		/// @brief this^exponent.  A negative exponent is reported via
+		/// on_signed_integer_out_of_range and 1 is returned
+		[[nodiscard]] constexpr modular_integer pow( i64 exponent ) const {
+			if( DAW_UNLIKELY( exponent < 0 ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				return modular_integer( *m_mod, m_mod->one( ) );
+			}
+			return modular_integer(
+			  *m_mod, m_mod->pow( m_value, static_cast<std::uint64_t>(
+			                                 exponent.value( ) ) ) );
+		}
+
+		[[nodiscard]] friend constexpr modular_integer
+		operator+( modular_integer lhs, modular_integer const &rhs ) {
+			lhs += rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr modular_integer
+		operator-( modular_integer lhs, modular_integer const &rhs ) {
+			lhs -= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr modular_integer
+		operator*( modular_integer lhs, modular_integer const &rhs ) {
+			lhs *= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator==( modular_integer const &lhs,
+		            modular_integer const &rhs ) noexcept {
+			return lhs.m_value == rhs.m_value;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator!=( modular_integer const &lhs,
+		            modular_integer const &rhs ) noexcept {
+			return lhs.m_value != rhs.m_value;
+		}
+	};
+
+	template<std::size_t Bits>
+	modular_integer( signed_integer<Bits>, modulus<Bits> const & )
+	  -> modular_integer<Bits>;
+
+	/// @brief base^exponent mod m.  A negative exponent is reported via
+	/// on_signed_integer_out_of_range and 1 % m is returned
+	template<std::size_t Bits>
+	[[nodiscard]] constexpr signed_integer<Bits>
+	pow_mod( signed_integer<Bits> base, i64 exponent,
+	         modulus<Bits> const &mod ) {
+		return modular_integer<Bits>( base, mod ).pow( exponent ).value( );
+	}
+
+	/// @brief Number of bases pow_mod raises in lock step.  Their multiplies are
+	/// independent, so they overlap in the pipeline
+	inline constexpr std::size_t pow_mod_batch_width = 8;
+
+	/// @brief out[i] = bases[i]^exponent mod m for count bases.  A negative
+	/// exponent is reported via on_signed_integer_out_of_range and nothing is
+	/// written
+	template<std::size_t Bits>
+	void pow_mod( signed_integer<Bits> const *bases, std::size_t count,
+	              i64 exponent, modulus<Bits> const &mod,
+	              signed_integer<Bits> *out ) {
+		using word_t = typename modulus<Bits>::word_type;
+		if( DAW_UNLIKELY( exponent < 0 ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			return;
+		}
+		auto const e = static_cast<std::uint64_t>( exponent.value( ) );
+		std::size_t top_bit = 0;
+		while( top_bit < 63 and ( e >> ( top_bit + 1 ) ) != 0 ) {
+			++top_bit;
+		}
+		auto const run = [&]( auto montgomery ) {
+			constexpr bool is_montgomery = decltype( montgomery )::value;
+			for( std::size_t first = 0; first < count;
+			     first += pow_mod_batch_width ) {
+				auto const width = ( std::min )( pow_mod_batch_width, count - first );
+				word_t base[pow_mod_batch_width];
+				word_t acc[pow_mod_batch_width];
+				for( std::size_t n = 0; n < width; ++n ) {
+					base[n] = mod.to_form( bases[first + n] );
+					acc[n] = mod.one( );
+				}
+				// Left to right binary exponentiation, every lane takes the same
+				// steps
+				for( auto bit = top_bit + 1; bit-- > 0; ) {
+					for( std::size_t n = 0; n < width; ++n ) {
+						acc[n] = mod.template mul_as<is_montgomery>( acc[n], acc[n] );
+					}
+					if( ( e >> bit ) & 1U ) {
+						for( std::size_t n = 0; n < width; ++n ) {
+							acc[n] = mod.template mul_as<is_montgomery>( acc[n], base[n] );
+						}
+					}
+				}
+				for( std::size_t n = 0; n < width; ++n ) {
+					out[first + n] = mod.from_form( acc[n] );
+				}
+			}
+		};
+		if( mod.is_montgomery( ) ) {
+			run( std::true_type{ } );
+		} else {
+			run( std::false_type{ } );
+		}
+	}
+
+	template<std::size_t Bits, typename Bases, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Bases const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	void pow_mod( Bases const &bases, i64 exponent, modulus<Bits> const &mod,
+	              Out &&out ) {
+		auto count = static_cast<std::size_t>( std::size( bases ) );
+		if( DAW_UNLIKELY( std::size( out ) < count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			count = static_cast<std::size_t>( std::size( out ) );
+		}
+		pow_mod( std::data( bases ), count, exponent, mod, std::data( out ) );
+	}
+} // namespace daw::integers
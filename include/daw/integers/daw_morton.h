@@ -0,0 +1,366 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+#include "impl/daw_signed_simd.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace daw::integers {
+	/// 3D codes hold 21 bits per coordinate
+	inline constexpr i32 morton_3d_min = i32( -( 1 << 20 ) );
+	inline constexpr i32 morton_3d_max = i32( ( 1 << 20 ) - 1 );
+
+	namespace sint_impl {
+		inline constexpr std::uint64_t morton_2d_x_mask = 0x5555'5555'5555'5555ULL;
+		inline constexpr std::uint64_t morton_3d_x_mask = 0x1249'2492'4924'9249ULL;
+		inline constexpr std::uint32_t morton_3d_sign = 1U << 20U;
+		inline constexpr std::uint32_t morton_3d_bits = ( 1U << 21U ) - 1U;
+
+		// Flipping the sign bit maps signed order onto unsigned order, so that
+		// codes sort the same way their coordinates do
+		DAW_ATTRIB_INLINE constexpr std::uint32_t
+		order_key( std::int32_t v ) noexcept {
+			return static_cast<std::uint32_t>( v ) ^ 0x8000'0000U;
+		}
+
+		DAW_ATTRIB_INLINE constexpr std::int32_t
+		from_order_key( std::uint32_t key ) noexcept {
+			return static_cast<std::int32_t>( key ^ 0x8000'0000U );
+		}
+
+		/// @brief Move bit n of v to bit 2n.  The shift/mask form is used over a
+		/// general deposit_bits without BMI2, as it has no loop
+		DAW_ATTRIB_INLINE constexpr std::uint64_t
+		spread_by_1( std::uint32_t v ) noexcept {
+#if defined( DAW_INTEGERS_HAS_BMI2 )
+			if( not __builtin_is_constant_evaluated( ) ) {
+				return _pdep_u64( v, morton_2d_x_mask );
+			}
+#endif
+			auto x = static_cast<std::uint64_t>( v );
+			x = ( x | ( x << 16U ) ) & 0x0000'FFFF'0000'FFFFULL;
+			x = ( x | ( x << 8U ) ) & 0x00FF'00FF'00FF'00FFULL;
+			x = ( x | ( x << 4U ) ) & 0x0F0F'0F0F'0F0F'0F0FULL;
+			x = ( x | ( x << 2U ) ) & 0x3333'3333'3333'3333ULL;
+			x = ( x | ( x << 1U ) ) & morton_2d_x_mask;
+			return x;
+		}
+
+		/// @brief Move bit 2n of v to bit n, the inverse of spread_by_1
+		DAW_ATTRIB_INLINE constexpr std::uint32_t
+		compact_by_1( std::uint64_t v ) noexcept {
+#if defined( DAW_INTEGERS_HAS_BMI2 )
+			if( not __builtin_is_constant_evaluated( ) ) {
+				return static_cast<std::uint32_t>( _pext_u64( v, morton_2d_x_mask ) );
+			}
+#endif
+			auto x = v & morton_2d_x_mask;
+			x = ( x | ( x >> 1U ) ) & 0x3333'3333'3333'3333ULL;
+			x = ( x | ( x >> 2U ) ) & 0x0F0F'0F0F'0F0F'0F0FULL;
+			x = ( x | ( x >> 4U ) ) & 0x00FF'00FF'00FF'00FFULL;
+			x = ( x | ( x >> 8U ) ) & 0x0000'FFFF'0000'FFFFULL;
+			x = ( x | ( x >> 16U ) ) & 0x0000'0000'FFFF'FFFFULL;
+			return static_cast<std::uint32_t>( x );
+		}
+
+		/// @brief Move bit n of the low 21 bits of v to bit 3n
+		DAW_ATTRIB_INLINE constexpr std::uint64_t
+		spread_by_2( std::uint32_t v ) noexcept {
+#if defined( DAW_INTEGERS_HAS_BMI2 )
+			if( not __builtin_is_constant_evaluated( ) ) {
+				return _pdep_u64( v, morton_3d_x_mask );
+			}
+#endif
+			auto x = static_cast<std::uint64_t>( v & morton_3d_bits );
+			x = ( x | ( x << 32U ) ) & 0x001F'0000'0000'FFFFULL;
+			x = ( x | ( x << 16U ) ) & 0x001F'0000'FF00'00FFULL;
+			x = ( x | ( x << 8U ) ) & 0x100F'00F0'0F00'F00FULL;
+			x = ( x | ( x << 4U ) ) & 0x10C3'0C30'C30C'30C3ULL;
+			x = ( x | ( x << 2U ) ) & morton_3d_x_mask;
+			return x;
+		}
+
+		/// @brief Move bit 3n of v to bit n, the inverse of spread_by_2
+		DAW_ATTRIB_INLINE constexpr std::uint32_t
+		compact_by_2( std::uint64_t v ) noexcept {
+#if defined( DAW_INTEGERS_HAS_BMI2 )
+			if( not __builtin_is_constant_evaluated( ) ) {
+				return static_cast<std::uint32_t>( _pext_u64( v, morton_3d_x_mask ) );
+			}
+#endif
+			auto x = v & morton_3d_x_mask;
+			x = ( x | ( x >> 2U ) ) & 0x10C3'0C30'C30C'30C3ULL;
+			x = ( x | ( x >> 4U ) ) & 0x100F'00F0'0F00'F00FULL;
+			x = ( x | ( x >> 8U ) ) & 0x001F'0000'FF00'00FFULL;
+			x = ( x | ( x >> 16U ) ) & 0x001F'0000'0000'FFFFULL;
+			x = ( x | ( x >> 32U ) ) & morton_3d_bits;
+			return static_cast<std::uint32_t>( x );
+		}
+
+		DAW_ATTRIB_INLINE constexpr std::int64_t
+		encode_2d( std::int32_t x, std::int32_t y ) noexcept {
+			// Flipping the top bit again keeps the order when the code is viewed
+			// as signed
+			auto const code = spread_by_1( order_key( x ) ) |
+			                  ( spread_by_1( order_key( y ) ) << 1U );
+			return static_cast<std::int64_t>( code ^ ( 1ULL << 63U ) );
+		}
+
+		DAW_ATTRIB_INLINE constexpr bool in_morton_3d_range( std::int32_t v ) {
+			return v >= morton_3d_min.value( ) and v <= morton_3d_max.value( );
+		}
+
+		/// @brief The 3D code, the coordinates must be in range
+		DAW_ATTRIB_INLINE constexpr std::int64_t
+		encode_3d( std::int32_t x, std::int32_t y, std::int32_t z ) noexcept {
+			auto const key = []( std::int32_t v ) {
+				return ( static_cast<std::uint32_t>( v ) ^ morton_3d_sign ) &
+				       morton_3d_bits;
+			};
+			return static_cast<std::int64_t>( spread_by_2( key( x ) ) |
+			                                  ( spread_by_2( key( y ) ) << 1U ) |
+			                                  ( spread_by_2( key( z ) ) << 2U ) );
+		}
+
+		DAW_ATTRIB_INLINE constexpr std::int32_t
+		from_morton_3d_key( std::uint32_t key ) noexcept {
+			// Flip the sign back and sign extend from bit 20
+			return static_cast<std::int32_t>( ( key ^ morton_3d_sign ) << 11U ) >>
+			       11;
+		}
+	} // namespace sint_impl
+
+	/// @brief Interleave x and y into a Z-order code, x in the even bits.
+	/// Sorting codes sorts points along the Z curve and the order holds for
+	/// negative coordinates too
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr i64 morton_encode_2d( i32 x,
+	                                                               i32 y ) {
+		return i64( sint_impl::encode_2d( x.value( ), y.value( ) ) );
+	}
+
+	/// @brief Split a code from morton_encode_2d into { x, y }
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::array<i32, 2>
+	morton_decode_2d( i64 code ) {
+		auto const bits = static_cast<std::uint64_t>( code.value( ) ) ^
+		                  ( 1ULL << 63U );
+		auto const x = sint_impl::compact_by_1( bits );
+		auto const y = sint_impl::compact_by_1( bits >> 1U );
+		return { i32( sint_impl::from_order_key( x ) ),
+		         i32( sint_impl::from_order_key( y ) ) };
+	}
+
+	/// @brief Interleave x, y and z into a Z-order code, x in bits 0, 3, 6....
+	/// Each coordinate must be in [morton_3d_min, morton_3d_max], otherwise
+	/// on_signed_integer_out_of_range is called and the coordinate is clamped.
+	/// Codes are never negative and sort along the Z curve
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr i64 morton_encode_3d( i32 x, i32 y,
+	                                                               i32 z ) {
+		if( DAW_UNLIKELY( not( sint_impl::in_morton_3d_range( x.value( ) ) and
+		                       sint_impl::in_morton_3d_range( y.value( ) ) and
+		                       sint_impl::in_morton_3d_range( z.value( ) ) ) ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			auto const clamp = []( i32 v ) {
+				return ( std::min )( ( std::max )( v, morton_3d_min ), morton_3d_max );
+			};
+			x = clamp( x );
+			y = clamp( y );
+			z = clamp( z );
+		}
+		return i64( sint_impl::encode_3d( x.value( ), y.value( ), z.value( ) ) );
+	}
+
+	/// @brief Split a code from morton_encode_3d into { x, y, z }.  Bit 63 is
+	/// not used by codes and is ignored
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::array<i32, 3>
+	morton_decode_3d( i64 code ) {
+		auto const bits = static_cast<std::uint64_t>( code.value( ) );
+		return { i32( sint_impl::from_morton_3d_key(
+		           sint_impl::compact_by_2( bits ) ) ),
+		         i32( sint_impl::from_morton_3d_key(
+		           sint_impl::compact_by_2( bits >> 1U ) ) ),
+		         i32( sint_impl::from_morton_3d_key(
+		           sint_impl::compact_by_2( bits >> 2U ) ) ) };
+	}
+
+	/// @brief Perform out[n] = morton_encode_2d( x[n], y[n] ) for n in [0,
+	/// count)
+	inline void morton_encode_2d( i32 const *x, i32 const *y, std::size_t count,
+	                              i64 *out ) {
+		auto const *const xs = sint_impl::raw_ptr( x );
+		auto const *const ys = sint_impl::raw_ptr( y );
+		auto *const codes = sint_impl::raw_ptr( out );
+		for( std::size_t n = 0; n < count; ++n ) {
+			codes[n] = sint_impl::encode_2d( xs[n], ys[n] );
+		}
+	}
+
+	/// @brief Perform out[n] = morton_encode_3d( x[n], y[n], z[n] ) for n in [0,
+	/// count).  The coordinates are validated first; the first point outside of
+	/// [morton_3d_min, morton_3d_max] is reported via
+	/// on_signed_integer_out_of_range and stops the encoding
+	/// @return The number of elements of out written.  This is count unless a
+	/// point was out of range, in which case it is the position of that point
+	inline std::size_t morton_encode_3d( i32 const *x, i32 const *y,
+	                                     i32 const *z, std::size_t count,
+	                                     i64 *out ) {
+		auto const *const xs = sint_impl::raw_ptr( x );
+		auto const *const ys = sint_impl::raw_ptr( y );
+		auto const *const zs = sint_impl::raw_ptr( z );
+		auto *const codes = sint_impl::raw_ptr( out );
+		std::size_t valid = 0;
+		while( valid < count and sint_impl::in_morton_3d_range( xs[valid] ) and
+		       sint_impl::in_morton_3d_range( ys[valid] ) and
+		       sint_impl::in_morton_3d_range( zs[valid] ) ) {
+			++valid;
+		}
+		for( std::size_t n = 0; n < valid; ++n ) {
+			codes[n] = sint_impl::encode_3d( xs[n], ys[n], zs[n] );
+		}
+		if( DAW_UNLIKELY( valid != count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+		}
+		return valid;
+	}
+
+	/// @brief Split codes[n] from morton_encode_2d into x[n] and y[n] for n in
+	/// [0, count)
+	inline void morton_decode_2d( i64 const *codes, std::size_t count, i32 *x,
+	                              i32 *y ) {
+		auto const *const raw_codes = sint_impl::raw_ptr( codes );
+		auto *const xs = sint_impl::raw_ptr( x );
+		auto *const ys = sint_impl::raw_ptr( y );
+		for( std::size_t n = 0; n < count; ++n ) {
+			auto const bits =
+			  static_cast<std::uint64_t>( raw_codes[n] ) ^ ( 1ULL << 63U );
+			xs[n] = sint_impl::from_order_key( sint_impl::compact_by_1( bits ) );
+			ys[n] =
+			  sint_impl::from_order_key( sint_impl::compact_by_1( bits >> 1U ) );
+		}
+	}
+
+	/// @brief Split codes[n] from morton_encode_3d into x[n], y[n] and z[n] for
+	/// n in [0, count)
+	inline void morton_decode_3d( i64 const *codes, std::size_t count, i32 *x,
+	                              i32 *y, i32 *z ) {
+		auto const *const raw_codes = sint_impl::raw_ptr( codes );
+		auto *const xs = sint_impl::raw_ptr( x );
+		auto *const ys = sint_impl::raw_ptr( y );
+		auto *const zs = sint_impl::raw_ptr( z );
+		for( std::size_t n = 0; n < count; ++n ) {
+			auto const bits = static_cast<std::uint64_t>( raw_codes[n] );
+			xs[n] = sint_impl::from_morton_3d_key( sint_impl::compact_by_2( bits ) );
+			ys[n] =
+			  sint_impl::from_morton_3d_key( sint_impl::compact_by_2( bits >> 1U ) );
+			zs[n] =
+			  sint_impl::from_morton_3d_key( sint_impl::compact_by_2( bits >> 2U ) );
+		}
+	}
+
+	/// @brief Perform out[n] = morton_encode_2d( x[n], y[n] ) for each element
+	/// of x.  y or out ranges that are smaller than x are reported via
+	/// on_signed_integer_out_of_range and only the elements available are
+	/// encoded
+	template<typename X, typename Y, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<X const> and
+	                            sint_impl::is_contiguous_range_v<Y const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	void morton_encode_2d( X const &x, Y const &y, Out &&out ) {
+		auto count = static_cast<std::size_t>( std::size( x ) );
+		if( DAW_UNLIKELY( std::size( y ) < count or std::size( out ) < count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			count = static_cast<std::size_t>(
+			  ( std::min )( std::size( y ), std::size( out ) ) );
+		}
+		morton_encode_2d( std::data( x ), std::data( y ), count, std::data( out ) );
+	}
+
+	/// @brief Perform out[n] = morton_encode_3d( x[n], y[n], z[n] ) for each
+	/// element of x.  See the pointer overload for details.  y, z or out ranges
+	/// that are smaller than x are reported via on_signed_integer_out_of_range
+	/// and only the elements available are encoded
+	template<typename X, typename Y, typename Z, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<X const> and
+	                            sint_impl::is_contiguous_range_v<Y const> and
+	                            sint_impl::is_contiguous_range_v<Z const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	std::size_t morton_encode_3d( X const &x, Y const &y, Z const &z,
+	                              Out &&out ) {
+		auto count = static_cast<std::size_t>( std::size( x ) );
+		if( DAW_UNLIKELY( std::size( y ) < count or std::size( z ) < count or
+		                  std::size( out ) < count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			count = static_cast<std::size_t>( ( std::min )(
+			  { std::size( y ), std::size( z ), std::size( out ) } ) );
+		}
+		return morton_encode_3d( std::data( x ), std::data( y ), std::data( z ),
+		                         count, std::data( out ) );
+	}
+
+	/// @brief Split each code from morton_encode_2d into x and y.  x or y
+	/// ranges that are smaller than codes are reported via
+	/// on_signed_integer_out_of_range and only the elements that fit are
+	/// decoded
+	template<typename Codes, typename X, typename Y,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Codes const> and
+	                            sint_impl::is_contiguous_range_v<X> and
+	                            sint_impl::is_contiguous_range_v<Y>,
+	                          std::nullptr_t> = nullptr>
+	void morton_decode_2d( Codes const &codes, X &&x, Y &&y ) {
+		auto count = static_cast<std::size_t>( std::size( codes ) );
+		if( DAW_UNLIKELY( std::size( x ) < count or std::size( y ) < count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			count = static_cast<std::size_t>(
+			  ( std::min )( std::size( x ), std::size( y ) ) );
+		}
+		morton_decode_2d( std::data( codes ), count, std::data( x ),
+		                  std::data( y ) );
+	}
+
+	/// @brief Split each code from morton_encode_3d into x, y and z.  x, y or
+	/// z ranges that are smaller than codes are reported via
+	/// on_signed_integer_out_of_range and only the elements that fit are
+	/// decoded
+	template<typename Codes, typename X, typename Y, typename Z,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Codes const> and
+	                            sint_impl::is_contiguous_range_v<X> and
+	                            sint_impl::is_contiguous_range_v<Y> and
+	                            sint_impl::is_contiguous_range_v<Z>,
+	                          std::nullptr_t> = nullptr>
+	void morton_decode_3d( Codes const &codes, X &&x, Y &&y, Z &&z ) {
+		auto count = static_cast<std::size_t>( std::size( codes ) );
+		if( DAW_UNLIKELY( std::size( x ) < count or std::size( y ) < count or
+		                  std::size( z ) < count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			count = static_cast<std::size_t>(
+			  ( std::min )( { std::size( x ), std::size( y ), std::size( z ) } ) );
+		}
+		morton_decode_3d( std::data( codes ), count, std::data( x ), std::data( y ),
+		                  std::data( z ) );
+	}
+} // namespace daw::integers
@@ -0,0 +1,414 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_shift.h"
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+#include "impl/daw_signed_simd.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace daw::integers {
+	namespace sint_impl {
+		enum class mul_kind {
+			// Keep the low bits of each product
+			wrapped,
+			// As wrapped, and record which lanes overflowed
+			flagged,
+			// Stop at the first product that overflows
+			checked,
+			// Clamp products that overflow to min( ) or max( )
+			saturated
+		};
+
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+		/// @brief The low 64 bits of each product.  AVX2 has no 64 bit
+		/// multiply so it is built from the 32 bit halves with vpmuludq
+		DAW_ATTRIB_INLINE __m256i mullo_epi64( __m256i a, __m256i b ) {
+#if defined( DAW_INTEGERS_HAS_AVX512DQ ) and \
+  defined( DAW_INTEGERS_HAS_AVX512VL )
+			return _mm256_mullo_epi64( a, b );
+#else
+			auto const cross =
+			  _mm256_add_epi64( _mm256_mul_epu32( a, _mm256_srli_epi64( b, 32 ) ),
+			                    _mm256_mul_epu32( _mm256_srli_epi64( a, 32 ), b ) );
+			return _mm256_add_epi64( _mm256_mul_epu32( a, b ),
+			                         _mm256_slli_epi64( cross, 32 ) );
+#endif
+		}
+
+		template<std::size_t Bits>
+		DAW_ATTRIB_INLINE __m256i mul_lanes_wrapped( __m256i a, __m256i b ) {
+			if constexpr( Bits == 16 ) {
+				return _mm256_mullo_epi16( a, b );
+			} else if constexpr( Bits == 32 ) {
+				return _mm256_mullo_epi32( a, b );
+			} else {
+				return mullo_epi64( a, b );
+			}
+		}
+
+		/// @brief The low half of each product, with fits set to all ones in
+		/// the lanes where that is the whole product.  A product fits when its
+		/// high half is the sign extension of the low half.  NarrowFirst tries
+		/// the cheaper 64 bit path for operands that fit in 32 bits first, which
+		/// only pays when that is predictable
+		template<std::size_t Bits, bool NarrowFirst = false>
+		DAW_ATTRIB_INLINE __m256i mul_lanes_exact( __m256i a, __m256i b,
+		                                           __m256i &fits ) {
+			if constexpr( Bits == 16 ) {
+				auto const lo = _mm256_mullo_epi16( a, b );
+				fits = _mm256_cmpeq_epi16( _mm256_mulhi_epi16( a, b ),
+				                           _mm256_srai_epi16( lo, 15 ) );
+				return lo;
+			} else if constexpr( Bits == 32 ) {
+				// vpmuldq gives the full 64 bit product of the even lanes.  Shift
+				// the odd lanes down to get theirs, then interleave the halves
+				auto const even = _mm256_mul_epi32( a, b );
+				auto const odd = _mm256_mul_epi32( _mm256_srli_epi64( a, 32 ),
+				                                   _mm256_srli_epi64( b, 32 ) );
+				auto const lo =
+				  _mm256_blend_epi32( even, _mm256_slli_epi64( odd, 32 ), 0xAA );
+				auto const hi =
+				  _mm256_blend_epi32( _mm256_srli_epi64( even, 32 ), odd, 0xAA );
+				fits = _mm256_cmpeq_epi32( hi, _mm256_srai_epi32( lo, 31 ) );
+				return lo;
+			} else {
+				if constexpr( NarrowFirst ) {
+					// When every operand fits in 32 bits the products from vpmuldq
+					// are exact
+					auto const bias = _mm256_set1_epi64x( 0x8000'0000LL );
+					auto const wide = _mm256_or_si256(
+					  _mm256_srli_epi64( _mm256_add_epi64( a, bias ), 32 ),
+					  _mm256_srli_epi64( _mm256_add_epi64( b, bias ), 32 ) );
+					if( DAW_LIKELY( _mm256_testz_si256( wide, wide ) ) ) {
+						fits = _mm256_set1_epi64x( -1 );
+						return _mm256_mul_epi32( a, b );
+					}
+				}
+				// Otherwise the unsigned 128 bit product from the four 32 bit
+				// partial products, corrected to signed by subtracting b when a is
+				// negative and a when b is negative
+				auto const low_half = _mm256_set1_epi64x( 0xFFFF'FFFFLL );
+				auto const a_hi = _mm256_srli_epi64( a, 32 );
+				auto const b_hi = _mm256_srli_epi64( b, 32 );
+				auto const ll = _mm256_mul_epu32( a, b );
+				auto const lh = _mm256_mul_epu32( a, b_hi );
+				auto const hl = _mm256_mul_epu32( a_hi, b );
+				auto const hh = _mm256_mul_epu32( a_hi, b_hi );
+				auto const mid = _mm256_add_epi64(
+				  _mm256_srli_epi64( ll, 32 ),
+				  _mm256_add_epi64( _mm256_and_si256( lh, low_half ),
+				                    _mm256_and_si256( hl, low_half ) ) );
+				auto const lo =
+				  _mm256_blend_epi32( ll, _mm256_slli_epi64( mid, 32 ), 0xAA );
+				auto const hi_unsigned = _mm256_add_epi64(
+				  _mm256_add_epi64( hh, _mm256_srli_epi64( mid, 32 ) ),
+				  _mm256_add_epi64( _mm256_srli_epi64( lh, 32 ),
+				                    _mm256_srli_epi64( hl, 32 ) ) );
+				auto const correction = _mm256_add_epi64(
+				  _mm256_and_si256( sign_lanes<64>( a ), b ),
+				  _mm256_and_si256( sign_lanes<64>( b ), a ) );
+				auto const hi = _mm256_sub_epi64( hi_unsigned, correction );
+				fits = _mm256_cmpeq_epi64( hi, sign_lanes<64>( lo ) );
+				return lo;
+			}
+		}
+
+		/// @brief One bit per lane, set when the lane of fits is all ones
+		template<std::size_t Bits>
+		DAW_ATTRIB_INLINE unsigned lane_bits( __m256i fits ) {
+			if constexpr( Bits == 16 ) {
+				return static_cast<unsigned>( _mm_movemask_epi8(
+				  _mm_packs_epi16( _mm256_castsi256_si128( fits ),
+				                   _mm256_extracti128_si256( fits, 1 ) ) ) );
+			} else if constexpr( Bits == 32 ) {
+				return static_cast<unsigned>(
+				  _mm256_movemask_ps( _mm256_castsi256_ps( fits ) ) );
+			} else {
+				return static_cast<unsigned>(
+				  _mm256_movemask_pd( _mm256_castsi256_pd( fits ) ) );
+			}
+		}
+#endif
+
+		/// @brief Perform out[n] = a[n] * b[n] for each n in [0, size) as
+		/// described by Kind.  flagged sets overflowed[n] for each n
+		/// @return checked returns the number of elements written, which is the
+		/// position of the first overflow if there is one.  flagged returns the
+		/// number of products that overflowed.  Otherwise size
+		template<mul_kind Kind, std::size_t Bits>
+		std::size_t mul_block( signed_integer_type_t<Bits> const *a,
+		                       signed_integer_type_t<Bits> const *b,
+		                       std::size_t size, signed_integer_type_t<Bits> *out,
+		                       bool *overflowed ) noexcept {
+			using value_type = signed_integer_type_t<Bits>;
+			std::size_t n = 0;
+			std::size_t overflow_count = 0;
+			(void)overflowed;
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+			// Record the lanes that did not fit in overflowed
+			auto const flag_lanes = [&]( std::size_t first, std::size_t lanes,
+			                             unsigned fit_bits ) {
+				for( std::size_t l = 0; l < lanes; ++l ) {
+					bool const lane_overflowed = ( ( fit_bits >> l ) & 1U ) == 0;
+					overflowed[first + l] = lane_overflowed;
+					overflow_count += lane_overflowed ? 1U : 0U;
+				}
+			};
+			if constexpr( Bits == 8 ) {
+				// There is no 8 bit multiply.  The products of sign extended 16 bit
+				// lanes are exact, and packing them back down with signed
+				// saturation is exactly the saturating multiply
+				auto const low_byte = _mm_set1_epi16( 0xFF );
+				for( ; n + 16 <= size; n += 16 ) {
+					auto const a16 = _mm256_cvtepi8_epi16(
+					  _mm_loadu_si128( reinterpret_cast<__m128i const *>( a + n ) ) );
+					auto const b16 = _mm256_cvtepi8_epi16(
+					  _mm_loadu_si128( reinterpret_cast<__m128i const *>( b + n ) ) );
+					auto const p = _mm256_mullo_epi16( a16, b16 );
+					auto const p_lo = _mm256_castsi256_si128( p );
+					auto const p_hi = _mm256_extracti128_si256( p, 1 );
+					auto *const dst = reinterpret_cast<__m128i *>( out + n );
+					if constexpr( Kind == mul_kind::saturated ) {
+						_mm_storeu_si128( dst, _mm_packs_epi16( p_lo, p_hi ) );
+					} else {
+						auto const wrapped =
+						  _mm_packus_epi16( _mm_and_si128( p_lo, low_byte ),
+						                    _mm_and_si128( p_hi, low_byte ) );
+						if constexpr( Kind != mul_kind::wrapped ) {
+							auto const fits16 = _mm256_cmpeq_epi16(
+							  p, _mm256_srai_epi16( _mm256_slli_epi16( p, 8 ), 8 ) );
+							auto const fit_bits =
+							  static_cast<unsigned>( _mm_movemask_epi8( _mm_packs_epi16(
+							    _mm256_castsi256_si128( fits16 ),
+							    _mm256_extracti128_si256( fits16, 1 ) ) ) );
+							if constexpr( Kind == mul_kind::checked ) {
+								if( DAW_UNLIKELY( fit_bits != 0xFFFFU ) ) {
+									break;
+								}
+							} else {
+								flag_lanes( n, 16, fit_bits );
+							}
+						}
+						_mm_storeu_si128( dst, wrapped );
+					}
+				}
+			} else {
+				constexpr std::size_t lanes = 32 / sizeof( value_type );
+				constexpr unsigned all_fit = ( 1U << lanes ) - 1U;
+				auto const max =
+				  set1_lanes<Bits>( daw::numeric_limits<value_type>::max( ) );
+				for( ; n + lanes <= size; n += lanes ) {
+					auto const va =
+					  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( a + n ) );
+					auto const vb =
+					  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( b + n ) );
+					auto *const dst = reinterpret_cast<__m256i *>( out + n );
+					if constexpr( Kind == mul_kind::wrapped ) {
+						_mm256_storeu_si256( dst, mul_lanes_wrapped<Bits>( va, vb ) );
+					} else {
+						auto fits = __m256i{ };
+						// Products that are checked are expected to fit
+						constexpr bool narrow_first = Kind == mul_kind::checked;
+						auto const product =
+						  mul_lanes_exact<Bits, narrow_first>( va, vb, fits );
+						if constexpr( Kind == mul_kind::saturated ) {
+							// max( ) when the signs match, otherwise min( )
+							auto const saturated = _mm256_xor_si256(
+							  sign_lanes<Bits>( _mm256_xor_si256( va, vb ) ), max );
+							_mm256_storeu_si256(
+							  dst, _mm256_blendv_epi8( saturated, product, fits ) );
+						} else if constexpr( Kind == mul_kind::checked ) {
+							if( DAW_UNLIKELY( _mm256_movemask_epi8( fits ) != -1 ) ) {
+								break;
+							}
+							_mm256_storeu_si256( dst, product );
+						} else {
+							auto const fit_bits = lane_bits<Bits>( fits );
+							if( fit_bits == all_fit ) {
+								std::fill_n( overflowed + n, lanes, false );
+							} else {
+								flag_lanes( n, lanes, fit_bits );
+							}
+							_mm256_storeu_si256( dst, product );
+						}
+					}
+				}
+			}
+#endif
+			for( ; n < size; ++n ) {
+				auto result = value_type{ };
+				if constexpr( Kind == mul_kind::saturated ) {
+					result = sat_mul_branchless( a[n], b[n] );
+				} else {
+					bool const overflow = wrapping_mul( a[n], b[n], result );
+					if constexpr( Kind == mul_kind::checked ) {
+						if( DAW_UNLIKELY( overflow ) ) {
+							return n;
+						}
+					} else if constexpr( Kind == mul_kind::flagged ) {
+						overflowed[n] = overflow;
+						overflow_count += overflow ? 1U : 0U;
+					}
+				}
+				out[n] = result;
+			}
+			if constexpr( Kind == mul_kind::flagged ) {
+				return overflow_count;
+			} else {
+				return size;
+			}
+		}
+	} // namespace sint_impl
+
+	/// @brief Perform out[n] = a[n].mul_wrapped( b[n] ) for each n in [0,
+	/// size).  out may alias a or b
+	template<std::size_t Bits>
+	void mul_wrapped( signed_integer<Bits> const *a,
+	                  signed_integer<Bits> const *b, std::size_t size,
+	                  signed_integer<Bits> *out ) {
+		(void)sint_impl::mul_block<sint_impl::mul_kind::wrapped, Bits>(
+		  sint_impl::raw_ptr( a ), sint_impl::raw_ptr( b ), size,
+		  sint_impl::raw_ptr( out ), nullptr );
+	}
+
+	/// @brief Perform out[n] = a[n].mul_wrapped( b[n] ) for each n in [0,
+	/// size), setting overflowed[n] when the product did not fit.  Overflow is
+	/// not reported via on_signed_integer_overflow.  out may alias a or b
+	/// @return The number of products that overflowed
+	template<std::size_t Bits>
+	std::size_t mul_wrapped( signed_integer<Bits> const *a,
+	                         signed_integer<Bits> const *b, std::size_t size,
+	                         signed_integer<Bits> *out, bool *overflowed ) {
+		return sint_impl::mul_block<sint_impl::mul_kind::flagged, Bits>(
+		  sint_impl::raw_ptr( a ), sint_impl::raw_ptr( b ), size,
+		  sint_impl::raw_ptr( out ), overflowed );
+	}
+
+	/// @brief Perform out[n] = a[n] * b[n] for each n in [0, size).  The first
+	/// product that overflows is reported via on_signed_integer_overflow and
+	/// stops the multiplication.  out may alias a or b
+	/// @return The number of elements of out written.  This is size unless a
+	/// product overflowed, in which case it is the position of that element
+	template<std::size_t Bits>
+	std::size_t mul_checked( signed_integer<Bits> const *a,
+	                         signed_integer<Bits> const *b, std::size_t size,
+	                         signed_integer<Bits> *out ) {
+		auto const written =
+		  sint_impl::mul_block<sint_impl::mul_kind::checked, Bits>(
+		    sint_impl::raw_ptr( a ), sint_impl::raw_ptr( b ), size,
+		    sint_impl::raw_ptr( out ), nullptr );
+		if( DAW_UNLIKELY( written != size ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_overflow( );
+		}
+		return written;
+	}
+
+	/// @brief Perform out[n] = a[n].mul_saturated( b[n] ) for each n in [0,
+	/// size).  out may alias a or b
+	template<std::size_t Bits>
+	void mul_saturated( signed_integer<Bits> const *a,
+	                    signed_integer<Bits> const *b, std::size_t size,
+	                    signed_integer<Bits> *out ) {
+		(void)sint_impl::mul_block<sint_impl::mul_kind::saturated, Bits>(
+		  sint_impl::raw_ptr( a ), sint_impl::raw_ptr( b ), size,
+		  sint_impl::raw_ptr( out ), nullptr );
+	}
+
+	namespace sint_impl {
+		/// @brief The number of elements available in every range.  Ranges that
+		/// are smaller than a are reported via on_signed_integer_out_of_range
+		template<typename A, typename... Ranges>
+		std::size_t mul_span_size( A const &a, Ranges const &...ranges ) {
+			auto size = static_cast<std::size_t>( std::size( a ) );
+			if( DAW_UNLIKELY(
+			      ( ( static_cast<std::size_t>( std::size( ranges ) ) < size ) or
+			        ... ) ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				size = ( std::min )(
+				  { size, static_cast<std::size_t>( std::size( ranges ) )... } );
+			}
+			return size;
+		}
+	} // namespace sint_impl
+
+	/// @brief Perform out[n] = a[n].mul_wrapped( b[n] ) for each element of a.
+	/// b or out ranges that are smaller than a are reported via
+	/// on_signed_integer_out_of_range and only the elements available are
+	/// multiplied
+	template<typename A, typename B, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<A const> and
+	                            sint_impl::is_contiguous_range_v<B const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	void mul_wrapped( A const &a, B const &b, Out &&out ) {
+		auto const size = sint_impl::mul_span_size( a, b, out );
+		mul_wrapped( std::data( a ), std::data( b ), size, std::data( out ) );
+	}
+
+	/// @brief Perform out[n] = a[n].mul_wrapped( b[n] ) for each element of a,
+	/// setting overflowed[n] when the product did not fit.  b, out, or
+	/// overflowed ranges that are smaller than a are reported via
+	/// on_signed_integer_out_of_range and only the elements available are
+	/// multiplied
+	/// @return The number of products that overflowed
+	template<typename A, typename B, typename Out, typename Flags,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<A const> and
+	                            sint_impl::is_contiguous_range_v<B const> and
+	                            sint_impl::is_contiguous_range_v<Out> and
+	                            sint_impl::is_contiguous_range_v<Flags>,
+	                          std::nullptr_t> = nullptr>
+	std::size_t mul_wrapped( A const &a, B const &b, Out &&out,
+	                         Flags &&overflowed ) {
+		auto const size = sint_impl::mul_span_size( a, b, out, overflowed );
+		return mul_wrapped( std::data( a ), std::data( b ), size,
+		                    std::data( out ), std::data( overflowed ) );
+	}
+
+	/// @brief Perform out[n] = a[n] * b[n] for each element of a.  See the
+	/// pointer overload for details.  b or out ranges that are smaller than a
+	/// are reported via on_signed_integer_out_of_range and only the elements
+	/// available are multiplied
+	template<typename A, typename B, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<A const> and
+	                            sint_impl::is_contiguous_range_v<B const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	std::size_t mul_checked( A const &a, B const &b, Out &&out ) {
+		auto const size = sint_impl::mul_span_size( a, b, out );
+		return mul_checked( std::data( a ), std::data( b ), size,
+		                    std::data( out ) );
+	}
+
+	/// @brief Perform out[n] = a[n].mul_saturated( b[n] ) for each element of
+	/// a.  b or out ranges that are smaller than a are reported via
+	/// on_signed_integer_out_of_range and only the elements available are
+	/// multiplied
+	template<typename A, typename B, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<A const> and
+	                            sint_impl::is_contiguous_range_v<B const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	void mul_saturated( A const &a, B const &b, Out &&out ) {
+		auto const size = sint_impl::mul_span_size( a, b, out );
+		mul_saturated( std::data( a ), std::data( b ), size, std::data( out ) );
+	}
+} // namespace daw::integers
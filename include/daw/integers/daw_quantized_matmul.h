@@ -0,0 +1,287 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+#include "impl/daw_signed_simd.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace daw::integers {
+	/// @brief The number of k values summed into an i32 before the partial
+	/// sum is added to the output.  Every i8 product is at most 2^14 in
+	/// magnitude, and the unsigned by signed VNNI form at most 255 * 128, so a
+	/// block cannot overflow an i32; only the adds between blocks are checked
+	inline constexpr std::size_t quantized_block_k = 4096;
+
+	/// @brief The number of weight rows whose block of k values is kept in
+	/// cache while every activation row is multiplied by them
+	inline constexpr std::size_t quantized_block_n = 64;
+
+	namespace sint_impl {
+		static_assert( quantized_block_k * 255 * 128 <=
+		               static_cast<std::size_t>(
+		                 daw::numeric_limits<std::int32_t>::max( ) ) );
+
+		/// The VNNI instructions multiply unsigned by signed bytes.  The
+		/// activations are biased by 128 to make them unsigned and 128 times the
+		/// sum of the weights is subtracted afterwards
+#if defined( DAW_INTEGERS_HAS_VNNI )
+		inline constexpr std::int32_t qdot_bias = 128;
+#else
+		inline constexpr std::int32_t qdot_bias = 0;
+#endif
+
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+		DAW_ATTRIB_INLINE std::int32_t hsum_epi32( __m256i v ) noexcept {
+			auto s = _mm_add_epi32( _mm256_castsi256_si128( v ),
+			                        _mm256_extracti128_si256( v, 1 ) );
+			s = _mm_add_epi32( s, _mm_shuffle_epi32( s, 0x4E ) );
+			s = _mm_add_epi32( s, _mm_shuffle_epi32( s, 0xB1 ) );
+			return _mm_cvtsi128_si32( s );
+		}
+#endif
+
+		/// @brief out[r] = sum( ( a[i] + qdot_bias ) * w[r][i] ) for i < count
+		/// and r < Rows.  a is loaded once for all of the rows
+		template<std::size_t Rows>
+		DAW_ATTRIB_INLINE void qdot( std::int8_t const *a,
+		                             std::int8_t const *const *w,
+		                             std::size_t count,
+		                             std::int32_t *out ) noexcept {
+			std::size_t i = 0;
+#if defined( DAW_INTEGERS_HAS_VNNI )
+			__m256i acc[Rows];
+			for( auto &v : acc ) {
+				v = _mm256_setzero_si256( );
+			}
+			auto const flip = _mm256_set1_epi8( -128 );
+			for( ; i + 32 <= count; i += 32 ) {
+				auto const va = _mm256_xor_si256(
+				  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( a + i ) ),
+				  flip );
+				for( std::size_t r = 0; r < Rows; ++r ) {
+					auto const vw =
+					  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( w[r] + i ) );
+#if defined( DAW_INTEGERS_HAS_AVX512VNNI )
+					acc[r] = _mm256_dpbusd_epi32( acc[r], va, vw );
+#else
+					acc[r] = _mm256_dpbusd_avx_epi32( acc[r], va, vw );
+#endif
+				}
+			}
+			for( std::size_t r = 0; r < Rows; ++r ) {
+				out[r] = hsum_epi32( acc[r] );
+			}
+#elif defined( DAW_INTEGERS_HAS_AVX2 )
+			// Widened to 16 bits, pmaddwd sums pairs of exact 32 bit products
+			__m256i acc[Rows];
+			for( auto &v : acc ) {
+				v = _mm256_setzero_si256( );
+			}
+			for( ; i + 16 <= count; i += 16 ) {
+				auto const va = _mm256_cvtepi8_epi16(
+				  _mm_loadu_si128( reinterpret_cast<__m128i const *>( a + i ) ) );
+				for( std::size_t r = 0; r < Rows; ++r ) {
+					auto const vw = _mm256_cvtepi8_epi16(
+					  _mm_loadu_si128( reinterpret_cast<__m128i const *>( w[r] + i ) ) );
+					acc[r] = _mm256_add_epi32( acc[r], _mm256_madd_epi16( va, vw ) );
+				}
+			}
+			for( std::size_t r = 0; r < Rows; ++r ) {
+				out[r] = hsum_epi32( acc[r] );
+			}
+#else
+			// One row at a time so that the loop over i vectorizes
+			for( std::size_t r = 0; r < Rows; ++r ) {
+				std::int32_t sum = 0;
+				for( std::size_t j = 0; j < count; ++j ) {
+					sum += static_cast<std::int32_t>( a[j] ) *
+					       static_cast<std::int32_t>( w[r][j] );
+				}
+				out[r] = sum;
+			}
+			i = count;
+#endif
+			for( ; i < count; ++i ) {
+				auto const av = static_cast<std::int32_t>( a[i] ) + qdot_bias;
+				for( std::size_t r = 0; r < Rows; ++r ) {
+					out[r] += av * static_cast<std::int32_t>( w[r][i] );
+				}
+			}
+		}
+
+		/// @brief Multiply the activation rows by one block of weight rows and k
+		/// values, adding the exact block results to c
+		template<std::size_t Rows>
+		DAW_ATTRIB_INLINE void
+		qgemm_rows( std::int8_t const *a, std::size_t m, std::size_t k,
+		            std::int8_t const *const *w, std::int32_t const *w_sums,
+		            std::size_t k_offset, std::size_t k_count, bool first_block,
+		            std::int32_t *c, std::size_t ldc ) {
+			std::int32_t partial[Rows];
+			for( std::size_t row = 0; row < m; ++row ) {
+				qdot<Rows>( a + row * k + k_offset, w, k_count, partial );
+				auto *const c_row = c + row * ldc;
+				for( std::size_t r = 0; r < Rows; ++r ) {
+					// Exact and within 2^14 * quantized_block_k
+					auto const block = static_cast<std::int32_t>(
+					  static_cast<std::int64_t>( partial[r] ) -
+					  static_cast<std::int64_t>( qdot_bias ) * w_sums[r] );
+					c_row[r] = first_block ? block : checked_add( c_row[r], block );
+				}
+			}
+		}
+	} // namespace sint_impl
+
+	/// @brief c = a * transpose( w ) for i8 matrices with i32 results.  a is m
+	/// rows of k activations and w is n rows of k weights, the layout of a
+	/// linear layer's weights; both are row major.  c is m rows of n.
+	///
+	/// The weights are processed in blocks of quantized_block_n rows by
+	/// quantized_block_k columns that stay in cache while every activation row
+	/// is multiplied by them, four weight rows at a time.  Products use
+	/// vpdpbusd with AVX-512 VNNI or AVX-VNNI and pmaddwd with AVX2.  Sums within
+	/// a block cannot overflow; adding blocks together is checked and an
+	/// overflow is reported via on_signed_integer_overflow.
+	inline void quantized_gemm( i8 const *a, std::size_t m, i8 const *w,
+	                            std::size_t n, std::size_t k, i32 *c ) {
+		auto const *const ra = sint_impl::raw_ptr( a );
+		auto const *const rw = sint_impl::raw_ptr( w );
+		auto *const rc = sint_impl::raw_ptr( c );
+		if( k == 0 ) {
+			std::fill( rc, rc + m * n, std::int32_t{ 0 } );
+			return;
+		}
+		std::int32_t w_sums[quantized_block_n]{ };
+		for( std::size_t k0 = 0; k0 < k; k0 += quantized_block_k ) {
+			auto const kc = ( std::min )( quantized_block_k, k - k0 );
+			for( std::size_t n0 = 0; n0 < n; n0 += quantized_block_n ) {
+				auto const nb = ( std::min )( quantized_block_n, n - n0 );
+				if constexpr( sint_impl::qdot_bias != 0 ) {
+					for( std::size_t j = 0; j < nb; ++j ) {
+						auto const *const row = rw + ( n0 + j ) * k + k0;
+						std::int32_t sum = 0;
+						for( std::size_t i = 0; i < kc; ++i ) {
+							sum += row[i];
+						}
+						w_sums[j] = sum;
+					}
+				}
+				std::size_t j = 0;
+				for( ; j + 4 <= nb; j += 4 ) {
+					std::int8_t const *rows[4];
+					for( std::size_t r = 0; r < 4; ++r ) {
+						rows[r] = rw + ( n0 + j + r ) * k + k0;
+					}
+					sint_impl::qgemm_rows<4>( ra, m, k, rows, w_sums + j, k0, kc,
+					                          k0 == 0, rc + n0 + j, n );
+				}
+				for( ; j < nb; ++j ) {
+					std::int8_t const *rows[1] = { rw + ( n0 + j ) * k + k0 };
+					sint_impl::qgemm_rows<1>( ra, m, k, rows, w_sums + j, k0, kc,
+					                          k0 == 0, rc + n0 + j, n );
+				}
+			}
+		}
+	}
+
+	/// @brief y = w * x for an i8 matrix w of n rows of k weights and an i8
+	/// vector x of k activations, with i32 results.  See quantized_gemm
+	inline void quantized_gemv( i8 const *w, std::size_t n, std::size_t k,
+	                            i8 const *x, i32 *y ) {
+		quantized_gemm( x, 1, w, n, k, y );
+	}
+
+	/// @brief A fixed point scale from i32 accumulators to i8 outputs,
+	/// round( acc * multiplier / 2^shift ) + zero_point
+	struct requantize_params {
+		i32 multiplier = i32( 1 );
+		/// A right shift in [0, 62]
+		i32 shift = i32( 0 );
+		i32 zero_point = i32( 0 );
+	};
+
+	namespace sint_impl {
+		/// @brief The shift of params limited to [0, 62].  A shift outside of it
+		/// is reported via on_signed_integer_out_of_range
+		DAW_ATTRIB_INLINE constexpr int
+		requantize_shift( requantize_params const &params ) {
+			auto const shift = params.shift.value( );
+			if( DAW_UNLIKELY( shift < 0 or shift > 62 ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				return shift < 0 ? 0 : 62;
+			}
+			return static_cast<int>( shift );
+		}
+
+		DAW_ATTRIB_INLINE constexpr i8 requantize( i32 acc, i32 multiplier,
+		                                           int shift,
+		                                           i32 zero_point ) noexcept {
+			// An i32 by i32 product cannot saturate an i64, nor can adding half of
+			// the divisor to it
+			auto product = i64( acc ).mul_saturated( i64( multiplier ) );
+			if( shift > 0 ) {
+				product = product.add_saturated(
+				  i64( std::int64_t{ 1 } << static_cast<unsigned>( shift - 1 ) ) );
+			}
+			auto const scaled =
+			  i32::conversion_saturated( product.value( ) >> shift );
+			return i8::conversion_saturated( scaled.add_saturated( zero_point ) );
+		}
+	} // namespace sint_impl
+
+	/// @brief Scale an accumulator to i8, rounding half way values up and
+	/// saturating at the limits of i8
+	[[nodiscard]] constexpr i8 requantize( i32 acc,
+	                                       requantize_params const &params ) {
+		return sint_impl::requantize( acc, params.multiplier,
+		                              sint_impl::requantize_shift( params ),
+		                              params.zero_point );
+	}
+
+	/// @brief out[i] = requantize( acc[i], params ) for i < count
+	inline void requantize( i32 const *acc, std::size_t count,
+	                        requantize_params const &params, i8 *out ) {
+		auto const shift = sint_impl::requantize_shift( params );
+		for( std::size_t i = 0; i < count; ++i ) {
+			out[i] = sint_impl::requantize( acc[i], params.multiplier, shift,
+			                                params.zero_point );
+		}
+	}
+
+	template<typename Acc, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Acc const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	void requantize( Acc const &acc, requantize_params const &params,
+	                 Out &&out ) {
+		static_assert(
+		  std::is_same_v<sint_impl::range_value_t<Acc const>, i32> and
+		    std::is_same_v<sint_impl::range_value_t<Out>, i8>,
+		  "requantize requires a range of i32 and a range of i8" );
+		auto const count = static_cast<std::size_t>( std::size( acc ) );
+		if( DAW_UNLIKELY( static_cast<std::size_t>( std::size( out ) ) < count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			return;
+		}
+		requantize( std::data( acc ), count, params, std::data( out ) );
+	}
+} // namespace daw::integers
@@ -0,0 +1,419 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "daw_wide_arithmetic.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+#include "impl/daw_signed_simd.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_cxmath.h>
+#include <daw/daw_likely.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace daw::integers {
+	namespace sint_impl {
+		DAW_ATTRIB_INLINE constexpr std::uint64_t
+		splitmix64_next( std::uint64_t &state ) noexcept {
+			state += 0x9E37'79B9'7F4A'7C15ULL;
+			auto z = state;
+			z = ( z ^ ( z >> 30U ) ) * 0xBF58'476D'1CE4'E5B9ULL;
+			z = ( z ^ ( z >> 27U ) ) * 0x94D0'49BB'1331'11EBULL;
+			return z ^ ( z >> 31U );
+		}
+
+		DAW_ATTRIB_INLINE constexpr std::uint64_t rotl64( std::uint64_t x,
+		                                                 unsigned k ) noexcept {
+			return ( x << k ) | ( x >> ( 64U - k ) );
+		}
+
+		/// Offsets in a range of i8, i16 and i32 values are drawn from 32 bits of
+		/// randomness, i64 from 64 bits
+		template<std::size_t Bits>
+		using random_word_t =
+		  std::conditional_t<( Bits <= 32 ), std::uint32_t, std::uint64_t>;
+
+		template<typename URBG>
+		inline constexpr bool is_full_u64_urbg_v =
+		  std::is_same_v<typename URBG::result_type, std::uint64_t> and
+		  URBG::min( ) == 0 and
+		  URBG::max( ) == std::numeric_limits<std::uint64_t>::max( );
+
+		/// @brief A random word from the high bits of a 64 bit draw, the best
+		/// bits of xoshiro style generators
+		template<typename Word, typename URBG>
+		DAW_ATTRIB_INLINE constexpr Word random_word( URBG &rng ) {
+			return static_cast<Word>( rng( ) >> ( 64U - sizeof( Word ) * 8U ) );
+		}
+
+		/// @brief Lemire's multiply shift: the high word of x * s is in [0, s)
+		/// and is unbiased once the draws whose low word is below
+		/// threshold = 2^word_bits % s are rejected.  s must not be 0
+		template<typename Word, typename URBG>
+		DAW_ATTRIB_INLINE constexpr Word lemire_bounded( URBG &rng, Word s,
+		                                                 Word threshold ) {
+			while( true ) {
+				auto hi = Word{ };
+				auto const lo = umul_wide( random_word<Word>( rng ), s, hi );
+				if( DAW_LIKELY( lo >= threshold ) ) {
+					return hi;
+				}
+			}
+		}
+
+		/// @brief The number of values in [lo, hi] as a word, 0 when it is
+		/// 2^word_bits.  hi - lo is taken on the unsigned bit patterns, which is
+		/// exact for any lo <= hi including min( ) and max( )
+		template<std::size_t Bits>
+		DAW_ATTRIB_INLINE constexpr random_word_t<Bits>
+		random_span_size( signed_integer<Bits> lo,
+		                  signed_integer<Bits> hi ) noexcept {
+			using unsigned_t = std::make_unsigned_t<signed_integer_type_t<Bits>>;
+			auto const width = static_cast<unsigned_t>(
+			  static_cast<unsigned_t>( hi.value( ) ) -
+			  static_cast<unsigned_t>( lo.value( ) ) );
+			return static_cast<random_word_t<Bits>>(
+			  static_cast<random_word_t<Bits>>( width ) + 1U );
+		}
+
+		template<typename Word>
+		DAW_ATTRIB_INLINE constexpr Word lemire_threshold( Word s ) noexcept {
+			return s == 0 ? Word{ 0 } : static_cast<Word>( Word( 0U - s ) % s );
+		}
+
+		/// @brief lo + offset, where offset is less than the span size
+		template<std::size_t Bits, typename Word>
+		DAW_ATTRIB_INLINE constexpr signed_integer<Bits>
+		random_from_offset( signed_integer<Bits> lo, Word offset ) noexcept {
+			using raw_t = signed_integer_type_t<Bits>;
+			using unsigned_t = std::make_unsigned_t<raw_t>;
+			return signed_integer<Bits>::conversion_unchecked(
+			  static_cast<raw_t>( static_cast<unsigned_t>(
+			    static_cast<unsigned_t>( lo.value( ) ) +
+			    static_cast<unsigned_t>( offset ) ) ) );
+		}
+	} // namespace sint_impl
+
+	/// @brief The xoshiro256++ generator.  A 64 bit UniformRandomBitGenerator
+	/// with 256 bits of state, seeded from a 64 bit value with splitmix64
+	struct xoshiro256pp {
+		using result_type = std::uint64_t;
+
+	private:
+		friend struct xoshiro256pp_x4;
+		std::uint64_t m_s[4]{ };
+
+	public:
+		explicit constexpr xoshiro256pp( std::uint64_t seed = 0 ) noexcept {
+			for( auto &word : m_s ) {
+				word = sint_impl::splitmix64_next( seed );
+			}
+		}
+
+		[[nodiscard]] static constexpr result_type min( ) noexcept {
+			return 0;
+		}
+
+		[[nodiscard]] static constexpr result_type max( ) noexcept {
+			return std::numeric_limits<result_type>::max( );
+		}
+
+		DAW_ATTRIB_INLINE constexpr result_type operator( )( ) noexcept {
+			auto const result = sint_impl::rotl64( m_s[0] + m_s[3], 23U ) + m_s[0];
+			auto const t = m_s[1] << 17U;
+			m_s[2] ^= m_s[0];
+			m_s[3] ^= m_s[1];
+			m_s[1] ^= m_s[2];
+			m_s[0] ^= m_s[3];
+			m_s[2] ^= t;
+			m_s[3] = sint_impl::rotl64( m_s[3], 45U );
+			return result;
+		}
+
+		/// @brief Advance by 2^128 draws, giving a stream that does not overlap
+		/// the current one for 2^128 draws
+		constexpr void jump( ) noexcept {
+			constexpr std::uint64_t polynomial[4] = {
+			  0x180E'C6D3'3CFD'0ABAULL, 0xD5A6'1266'F0C9'392CULL,
+			  0xA958'2618'E03F'C9AAULL, 0x39AB'DC45'29B1'661CULL };
+			std::uint64_t s[4]{ };
+			for( auto word : polynomial ) {
+				for( unsigned b = 0; b < 64U; ++b ) {
+					if( ( word >> b ) & 1U ) {
+						for( std::size_t n = 0; n < 4; ++n ) {
+							s[n] ^= m_s[n];
+						}
+					}
+					(void)operator( )( );
+				}
+			}
+			for( std::size_t n = 0; n < 4; ++n ) {
+				m_s[n] = s[n];
+			}
+		}
+	};
+
+	/// @brief Four interleaved xoshiro256++ streams stepped together, one per
+	/// 64 bit lane of an AVX2 register.  Lane k is xoshiro256pp( seed ) jumped
+	/// k times.  next_block returns one draw of every lane; the call operator
+	/// hands out the lanes of a block one at a time so it is also a
+	/// UniformRandomBitGenerator.  The output for a seed is the same with and
+	/// without SIMD.
+	struct xoshiro256pp_x4 {
+		using result_type = std::uint64_t;
+		static constexpr std::size_t lanes = 4;
+
+	private:
+		// m_s[word][lane]
+		alignas( 32 ) std::uint64_t m_s[4][lanes]{ };
+		std::uint64_t m_buffer[lanes]{ };
+		std::size_t m_buffered = 0;
+
+	public:
+		explicit xoshiro256pp_x4( std::uint64_t seed = 0 ) noexcept {
+			auto lane = xoshiro256pp( seed );
+			for( std::size_t k = 0; k < lanes; ++k ) {
+				for( std::size_t w = 0; w < 4; ++w ) {
+					m_s[w][k] = lane.m_s[w];
+				}
+				lane.jump( );
+			}
+		}
+
+		[[nodiscard]] static constexpr result_type min( ) noexcept {
+			return 0;
+		}
+
+		[[nodiscard]] static constexpr result_type max( ) noexcept {
+			return std::numeric_limits<result_type>::max( );
+		}
+
+		/// @brief Store the next draw of each lane in out[0, lanes)
+		DAW_ATTRIB_INLINE void next_block( std::uint64_t *out ) noexcept {
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+			auto const load = [&]( std::size_t w ) {
+				return _mm256_load_si256( reinterpret_cast<__m256i const *>( m_s[w] ) );
+			};
+			auto const rotl = []( __m256i x, int k ) {
+				return _mm256_or_si256( _mm256_slli_epi64( x, k ),
+				                        _mm256_srli_epi64( x, 64 - k ) );
+			};
+			auto s0 = load( 0 );
+			auto s1 = load( 1 );
+			auto s2 = load( 2 );
+			auto s3 = load( 3 );
+			auto const result =
+			  _mm256_add_epi64( rotl( _mm256_add_epi64( s0, s3 ), 23 ), s0 );
+			auto const t = _mm256_slli_epi64( s1, 17 );
+			s2 = _mm256_xor_si256( s2, s0 );
+			s3 = _mm256_xor_si256( s3, s1 );
+			s1 = _mm256_xor_si256( s1, s2 );
+			s0 = _mm256_xor_si256( s0, s3 );
+			s2 = _mm256_xor_si256( s2, t );
+			s3 = rotl( s3, 45 );
+			_mm256_store_si256( reinterpret_cast<__m256i *>( m_s[0] ), s0 );
+			_mm256_store_si256( reinterpret_cast<__m256i *>( m_s[1] ), s1 );
+			_mm256_store_si256( reinterpret_cast<__m256i *>( m_s[2] ), s2 );
+			_mm256_store_si256( reinterpret_cast<__m256i *>( m_s[3] ), s3 );
+			_mm256_storeu_si256( reinterpret_cast<__m256i *>( out ), result );
+#else
+			// Stepping into a local block keeps out from aliasing the state, so
+			// the lanes vectorize
+			std::uint64_t result[lanes];
+			for( std::size_t k = 0; k < lanes; ++k ) {
+				result[k] = sint_impl::rotl64( m_s[0][k] + m_s[3][k], 23U ) + m_s[0][k];
+				auto const t = m_s[1][k] << 17U;
+				m_s[2][k] ^= m_s[0][k];
+				m_s[3][k] ^= m_s[1][k];
+				m_s[1][k] ^= m_s[2][k];
+				m_s[0][k] ^= m_s[3][k];
+				m_s[2][k] ^= t;
+				m_s[3][k] = sint_impl::rotl64( m_s[3][k], 45U );
+			}
+			for( std::size_t k = 0; k < lanes; ++k ) {
+				out[k] = result[k];
+			}
+#endif
+		}
+
+		DAW_ATTRIB_INLINE result_type operator( )( ) noexcept {
+			if( m_buffered == 0 ) {
+				next_block( m_buffer );
+				m_buffered = lanes;
+			}
+			return m_buffer[lanes - m_buffered--];
+		}
+	};
+
+	/// @brief A uniformly distributed value in [lo, hi] using Lemire's
+	/// multiply shift method, with no division in the common case and no
+	/// bias.  The width of the range is computed on the unsigned bit patterns
+	/// so [min( ), max( )] does not overflow.  hi < lo is reported via
+	/// on_signed_integer_out_of_range and lo is returned.
+	/// @param rng A UniformRandomBitGenerator producing 64 bit values over the
+	/// full range, such as xoshiro256pp or std::mt19937_64
+	template<std::size_t Bits, typename URBG>
+	[[nodiscard]] constexpr signed_integer<Bits>
+	uniform_int( URBG &rng, signed_integer<Bits> lo, signed_integer<Bits> hi ) {
+		static_assert( sint_impl::is_full_u64_urbg_v<URBG>,
+		               "uniform_int requires a full range 64 bit generator" );
+		using word_t = sint_impl::random_word_t<Bits>;
+		if( DAW_UNLIKELY( hi < lo ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			return lo;
+		}
+		auto const s = sint_impl::random_span_size( lo, hi );
+		if( s == 0 ) {
+			return sint_impl::random_from_offset(
+			  lo, sint_impl::random_word<word_t>( rng ) );
+		}
+		auto const threshold = sint_impl::lemire_threshold( s );
+		return sint_impl::random_from_offset(
+		  lo, sint_impl::lemire_bounded( rng, s, threshold ) );
+	}
+
+	namespace sint_impl {
+		/// @brief Lemire offsets for the eight 32 bit halves of a block of four
+		/// 64 bit draws.  Half 2k is the low half of draw k.  s must not be 0
+		/// @return A bit mask of the halves that must be redrawn
+		DAW_ATTRIB_INLINE std::uint32_t
+		lemire_block32( std::uint64_t const *block, std::uint32_t s,
+		                std::uint32_t threshold, std::uint32_t *out ) noexcept {
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+			auto const r =
+			  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( block ) );
+			auto const vs = _mm256_set1_epi64x( static_cast<long long>( s ) );
+			// 32 x 32 -> 64 bit products of the even and the odd halves
+			auto const even = _mm256_mul_epu32( r, vs );
+			auto const odd = _mm256_mul_epu32( _mm256_srli_epi64( r, 32 ), vs );
+			auto const high =
+			  _mm256_blend_epi32( _mm256_srli_epi64( even, 32 ), odd, 0xAA );
+			auto const low =
+			  _mm256_blend_epi32( even, _mm256_slli_epi64( odd, 32 ), 0xAA );
+			_mm256_storeu_si256( reinterpret_cast<__m256i *>( out ), high );
+			auto const vt = _mm256_set1_epi32( static_cast<int>( threshold ) );
+			auto const accepted =
+			  _mm256_cmpeq_epi32( _mm256_max_epu32( low, vt ), low );
+			return ~static_cast<std::uint32_t>(
+			         _mm256_movemask_ps( _mm256_castsi256_ps( accepted ) ) ) &
+			       0xFFU;
+#else
+			std::uint32_t rejected = 0;
+			for( std::size_t k = 0; k < 4; ++k ) {
+				auto const even = ( block[k] & 0xFFFF'FFFFU ) * s;
+				auto const odd = ( block[k] >> 32U ) * s;
+				out[2 * k] = static_cast<std::uint32_t>( even >> 32U );
+				out[2 * k + 1] = static_cast<std::uint32_t>( odd >> 32U );
+				rejected |=
+				  ( static_cast<std::uint32_t>(
+				      static_cast<std::uint32_t>( even ) < threshold ) |
+				    ( static_cast<std::uint32_t>(
+				        static_cast<std::uint32_t>( odd ) < threshold )
+				      << 1U ) )
+				  << ( 2U * k );
+			}
+			return rejected;
+#endif
+		}
+	} // namespace sint_impl
+
+	/// @brief Fill out[0, count) with uniformly distributed values in [lo, hi],
+	/// see uniform_int.  With an xoshiro256pp_x4 the draws are made four
+	/// streams at a time and, for i8, i16 and i32, the multiply shift is done
+	/// on eight values at once; the rare rejected values are redrawn one at a
+	/// time.  hi < lo is reported via on_signed_integer_out_of_range and
+	/// nothing is written.
+	template<std::size_t Bits, typename URBG>
+	void uniform_fill( URBG &rng, signed_integer<Bits> lo,
+	                   signed_integer<Bits> hi, signed_integer<Bits> *out,
+	                   std::size_t count ) {
+		static_assert( sint_impl::is_full_u64_urbg_v<URBG>,
+		               "uniform_fill requires a full range 64 bit generator" );
+		using word_t = sint_impl::random_word_t<Bits>;
+		if( DAW_UNLIKELY( hi < lo ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			return;
+		}
+		auto const s = sint_impl::random_span_size( lo, hi );
+		auto const threshold = sint_impl::lemire_threshold( s );
+		std::size_t n = 0;
+		if constexpr( std::is_same_v<URBG, xoshiro256pp_x4> ) {
+			constexpr auto lanes = xoshiro256pp_x4::lanes;
+			std::uint64_t block[lanes];
+			if constexpr( sizeof( word_t ) == 4 ) {
+				constexpr auto width = 2 * lanes;
+				std::uint32_t offsets[width];
+				for( ; n + width <= count; n += width ) {
+					rng.next_block( block );
+					if( s == 0 ) {
+						for( std::size_t k = 0; k < width; ++k ) {
+							offsets[k] = static_cast<std::uint32_t>( block[k / 2] >>
+							                                         ( 32U * ( k % 2 ) ) );
+						}
+					} else {
+						auto rejected =
+						  sint_impl::lemire_block32( block, s, threshold, offsets );
+						while( DAW_UNLIKELY( rejected != 0 ) ) {
+							auto const k = daw::cxmath::count_trailing_zeros( rejected );
+							offsets[k] = sint_impl::lemire_bounded( rng, s, threshold );
+							rejected &= rejected - 1U;
+						}
+					}
+					for( std::size_t k = 0; k < width; ++k ) {
+						out[n + k] = sint_impl::random_from_offset( lo, offsets[k] );
+					}
+				}
+			} else {
+				for( ; n + lanes <= count; n += lanes ) {
+					rng.next_block( block );
+					for( std::size_t k = 0; k < lanes; ++k ) {
+						auto offset = block[k];
+						if( s != 0 ) {
+							auto lo_word = sint_impl::umul_wide( block[k], s, offset );
+							if( DAW_UNLIKELY( lo_word < threshold ) ) {
+								offset = sint_impl::lemire_bounded( rng, s, threshold );
+							}
+						}
+						out[n + k] = sint_impl::random_from_offset( lo, offset );
+					}
+				}
+			}
+		}
+		for( ; n < count; ++n ) {
+			if( s == 0 ) {
+				out[n] = sint_impl::random_from_offset(
+				  lo, sint_impl::random_word<word_t>( rng ) );
+			} else {
+				out[n] = sint_impl::random_from_offset(
+				  lo, sint_impl::lemire_bounded( rng, s, threshold ) );
+			}
+		}
+	}
+
+	template<std::size_t Bits, typename URBG, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	void uniform_fill( URBG &rng, signed_integer<Bits> lo,
+	                   signed_integer<Bits> hi, Out &&out ) {
+		static_assert(
+		  std::is_same_v<sint_impl::range_value_t<Out>, signed_integer<Bits>>,
+		  "uniform_fill requires a range of signed_integer<Bits>" );
+		uniform_fill( rng, lo, hi, std::data( out ),
+		              static_cast<std::size_t>( std::size( out ) ) );
+	}
+} // namespace daw::integers
@@ -0,0 +1,373 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "daw_wide_arithmetic.h"
+#include "impl/daw_signed_error_handling.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_cxmath.h>
+#include <daw/daw_likely.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace daw::integers {
+	namespace sint_impl {
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr std::make_unsigned_t<T>
+		magnitude( T v ) noexcept {
+			using unsigned_t = std::make_unsigned_t<T>;
+			return v < 0 ? static_cast<unsigned_t>( unsigned_t{ 0 } -
+			                                        static_cast<unsigned_t>( v ) )
+			             : static_cast<unsigned_t>( v );
+		}
+
+		/// @brief The number of bits in |v|, 0 for 0
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr std::uint32_t
+		magnitude_bits( T v ) noexcept {
+			return static_cast<std::uint32_t>( sizeof( T ) * 8U ) -
+			       static_cast<std::uint32_t>(
+			         daw::cxmath::count_leading_zeroes( magnitude( v ) ) );
+		}
+
+		/// @brief Binary gcd, gcd( 0, 0 ) is 0
+		template<typename U>
+		constexpr U gcd( U a, U b ) noexcept {
+			static_assert( std::is_unsigned_v<U> );
+			if( a == 0 ) {
+				return b;
+			}
+			if( b == 0 ) {
+				return a;
+			}
+			auto const shift = daw::cxmath::count_trailing_zeros( a | b );
+			a = static_cast<U>( a >> daw::cxmath::count_trailing_zeros( a ) );
+			while( b != 0 ) {
+				b = static_cast<U>( b >> daw::cxmath::count_trailing_zeros( b ) );
+				if( a > b ) {
+					auto const t = a;
+					a = b;
+					b = t;
+				}
+				b = static_cast<U>( b - a );
+			}
+			return static_cast<U>( a << shift );
+		}
+
+		/// @brief -1, 0 or 1 as lhs is less than, equal to or greater than rhs
+		template<std::size_t Bits>
+		DAW_ATTRIB_INLINE constexpr int
+		compare( wide_product<Bits> const &lhs,
+		         wide_product<Bits> const &rhs ) noexcept {
+			if( lhs.high != rhs.high ) {
+				return lhs.high < rhs.high ? -1 : 1;
+			}
+			if( lhs.low != rhs.low ) {
+				return lhs.low < rhs.low ? -1 : 1;
+			}
+			return 0;
+		}
+	} // namespace sint_impl
+
+	/// @brief A fraction of two signed_integer<Bits>.  The denominator is
+	/// always positive, but the fraction is only reduced to lowest terms when
+	/// needed: arithmetic works on the raw terms while count_leading_zeros
+	/// shows enough headroom for the result.  Otherwise the operands are
+	/// reduced first and combined with the checked operations, which report
+	/// overflow via on_signed_integer_overflow when a reduced term does not
+	/// fit.  Comparisons cross multiply with mul_wide and never overflow
+	template<std::size_t Bits>
+	struct rational {
+		using integer_type = signed_integer<Bits>;
+		using value_type = sint_impl::signed_integer_type_t<Bits>;
+
+	private:
+		using unsigned_t = std::make_unsigned_t<value_type>;
+		static constexpr std::uint32_t value_bits = Bits - 1U;
+
+		value_type m_num = 0;
+		value_type m_den = 1;
+
+		struct raw_t {};
+
+		constexpr rational( raw_t, value_type num, value_type den ) noexcept
+		  : m_num( num )
+		  , m_den( den ) {}
+
+		/// @brief -v, reporting overflow for min( )
+		[[nodiscard]] static constexpr value_type negate( value_type v ) {
+			return integer_type( 0 ).sub_checked( integer_type( v ) ).value( );
+		}
+
+		[[nodiscard]] static constexpr value_type
+		raw_mul( value_type a, value_type b ) noexcept {
+			return static_cast<value_type>( a * b );
+		}
+
+		/// @brief lhs + rhs or lhs - rhs, both in lowest terms.  Knuth's form
+		/// keeps the intermediates as small as possible and gives a result in
+		/// lowest terms
+		[[nodiscard]] static constexpr rational
+		add_reduced( rational const &lhs, rational const &rhs, bool subtract ) {
+			auto const g = static_cast<value_type>( sint_impl::gcd(
+			  static_cast<unsigned_t>( lhs.m_den ),
+			  static_cast<unsigned_t>( rhs.m_den ) ) );
+			auto const l = integer_type( lhs.m_num ).mul_checked(
+			  integer_type( static_cast<value_type>( rhs.m_den / g ) ) );
+			auto const r = integer_type( rhs.m_num ).mul_checked(
+			  integer_type( static_cast<value_type>( lhs.m_den / g ) ) );
+			auto const t = subtract ? l.sub_checked( r ) : l.add_checked( r );
+			auto const g2 = static_cast<value_type>(
+			  sint_impl::gcd( sint_impl::magnitude( t.value( ) ),
+			                  static_cast<unsigned_t>( g ) ) );
+			auto const den =
+			  integer_type( static_cast<value_type>( lhs.m_den / g ) )
+			    .mul_checked(
+			      integer_type( static_cast<value_type>( rhs.m_den / g2 ) ) );
+			return rational( raw_t{ }, static_cast<value_type>( t.value( ) / g2 ),
+			                 den.value( ) );
+		}
+
+		[[nodiscard]] static constexpr rational
+		add_sub( rational const &lhs, rational const &rhs, bool subtract ) {
+			auto const nl = sint_impl::magnitude_bits( lhs.m_num );
+			auto const dl = sint_impl::magnitude_bits( lhs.m_den );
+			auto const nr = sint_impl::magnitude_bits( rhs.m_num );
+			auto const dr = sint_impl::magnitude_bits( rhs.m_den );
+			// Each cross product is below 2^( value_bits - 1 ), so their sum fits
+			if( DAW_LIKELY( nl + dr < value_bits and nr + dl < value_bits and
+			                dl + dr <= value_bits ) ) {
+				auto const l = raw_mul( lhs.m_num, rhs.m_den );
+				auto const r = raw_mul( rhs.m_num, lhs.m_den );
+				return rational( raw_t{ },
+				                 static_cast<value_type>( subtract ? l - r : l + r ),
+				                 raw_mul( lhs.m_den, rhs.m_den ) );
+			}
+			return add_reduced( lhs.normalized( ), rhs.normalized( ), subtract );
+		}
+
+		/// @brief lhs * ( num / den ) with den > 0
+		[[nodiscard]] static constexpr rational
+		mul_terms( rational const &lhs, value_type num, value_type den ) {
+			if( DAW_LIKELY( sint_impl::magnitude_bits( lhs.m_num ) +
+			                    sint_impl::magnitude_bits( num ) <=
+			                  value_bits and
+			                sint_impl::magnitude_bits( lhs.m_den ) +
+			                    sint_impl::magnitude_bits( den ) <=
+			                  value_bits ) ) {
+				return rational( raw_t{ }, raw_mul( lhs.m_num, num ),
+				                 raw_mul( lhs.m_den, den ) );
+			}
+			auto const l = lhs.normalized( );
+			auto const r = rational( raw_t{ }, num, den ).normalized( );
+			// Cross reducing two fractions in lowest terms leaves the product in
+			// lowest terms
+			auto const g1 = static_cast<value_type>(
+			  sint_impl::gcd( sint_impl::magnitude( l.m_num ),
+			                  static_cast<unsigned_t>( r.m_den ) ) );
+			auto const g2 = static_cast<value_type>(
+			  sint_impl::gcd( sint_impl::magnitude( r.m_num ),
+			                  static_cast<unsigned_t>( l.m_den ) ) );
+			auto const n = integer_type( static_cast<value_type>( l.m_num / g1 ) )
+			                 .mul_checked( integer_type(
+			                   static_cast<value_type>( r.m_num / g2 ) ) );
+			auto const d = integer_type( static_cast<value_type>( l.m_den / g2 ) )
+			                 .mul_checked( integer_type(
+			                   static_cast<value_type>( r.m_den / g1 ) ) );
+			return rational( raw_t{ }, n.value( ), d.value( ) );
+		}
+
+	public:
+		/// @brief 0
+		constexpr rational( ) noexcept = default;
+
+		/// @brief num / 1
+		constexpr rational( integer_type num ) noexcept
+		  : m_num( num.value( ) ) {}
+
+		/// @brief num / den.  A den of 0 is reported via
+		/// on_signed_integer_div_by_zero and gives 0.  A negative den is moved to
+		/// the numerator, which overflows only when one of them is min( ) in
+		/// lowest terms
+		constexpr rational( integer_type num, integer_type den )
+		  : m_num( num.value( ) )
+		  , m_den( den.value( ) ) {
+			if( DAW_UNLIKELY( m_den == 0 ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_div_by_zero( );
+				m_num = 0;
+				m_den = 1;
+				return;
+			}
+			if( m_den < 0 ) {
+				if( m_den == integer_type::min( ) or m_num == integer_type::min( ) ) {
+					reduce( );
+				}
+				m_num = negate( m_num );
+				m_den = negate( m_den );
+			}
+		}
+
+		/// @brief The numerator of the fraction as stored, which may not be in
+		/// lowest terms
+		[[nodiscard]] constexpr integer_type numerator( ) const noexcept {
+			return integer_type( m_num );
+		}
+
+		/// @brief The denominator of the fraction as stored, always positive
+		[[nodiscard]] constexpr integer_type denominator( ) const noexcept {
+			return integer_type( m_den );
+		}
+
+	private:
+		/// Reduce with the sign of the denominator unchanged
+		constexpr void reduce( ) noexcept {
+			auto const g = sint_impl::gcd( sint_impl::magnitude( m_num ),
+			                               sint_impl::magnitude( m_den ) );
+			if( g > 1 ) {
+				// Only when m_den is min( ) and m_num is 0 or min( ) is g larger
+				// than max( )
+				if( g > static_cast<unsigned_t>( integer_type::max( ).value( ) ) ) {
+					m_num = static_cast<value_type>( m_num < 0 ? -1 : 0 );
+					m_den = -1;
+					return;
+				}
+				m_num = static_cast<value_type>( m_num / static_cast<value_type>( g ) );
+				m_den = static_cast<value_type>( m_den / static_cast<value_type>( g ) );
+			}
+		}
+
+	public:
+		/// @brief Reduce to lowest terms, with 0 as 0 / 1
+		constexpr rational &normalize( ) noexcept {
+			if( m_num == 0 ) {
+				m_den = 1;
+				return *this;
+			}
+			reduce( );
+			return *this;
+		}
+
+		[[nodiscard]] constexpr rational normalized( ) const noexcept {
+			auto result = *this;
+			result.normalize( );
+			return result;
+		}
+
+		[[nodiscard]] constexpr bool is_normalized( ) const noexcept {
+			return sint_impl::gcd( sint_impl::magnitude( m_num ),
+			                       static_cast<unsigned_t>( m_den ) ) == 1;
+		}
+
+		[[nodiscard]] constexpr rational operator-( ) const {
+			if( DAW_UNLIKELY( m_num == integer_type::min( ) ) ) {
+				DAW_UNLIKELY_BRANCH
+				auto const r = normalized( );
+				return rational( raw_t{ }, negate( r.m_num ), r.m_den );
+			}
+			return rational( raw_t{ }, static_cast<value_type>( -m_num ), m_den );
+		}
+
+		[[nodiscard]] friend constexpr rational operator+( rational const &lhs,
+		                                                   rational const &rhs ) {
+			return add_sub( lhs, rhs, false );
+		}
+
+		[[nodiscard]] friend constexpr rational operator-( rational const &lhs,
+		                                                   rational const &rhs ) {
+			return add_sub( lhs, rhs, true );
+		}
+
+		[[nodiscard]] friend constexpr rational operator*( rational const &lhs,
+		                                                   rational const &rhs ) {
+			return mul_terms( lhs, rhs.m_num, rhs.m_den );
+		}
+
+		/// @brief Division by 0 is reported via on_signed_integer_div_by_zero
+		/// and returns lhs
+		[[nodiscard]] friend constexpr rational operator/( rational const &lhs,
+		                                                   rational const &rhs ) {
+			if( DAW_UNLIKELY( rhs.m_num == 0 ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_div_by_zero( );
+				return lhs;
+			}
+			if( rhs.m_num < 0 ) {
+				// Multiply by -den / -num, which needs -num to fit
+				auto const r =
+				  rhs.m_num == integer_type::min( ) ? rhs.normalized( ) : rhs;
+				return mul_terms( lhs, static_cast<value_type>( -r.m_den ),
+				                  negate( r.m_num ) );
+			}
+			return mul_terms( lhs, rhs.m_den, rhs.m_num );
+		}
+
+		constexpr rational &operator+=( rational const &rhs ) {
+			return *this = *this + rhs;
+		}
+
+		constexpr rational &operator-=( rational const &rhs ) {
+			return *this = *this - rhs;
+		}
+
+		constexpr rational &operator*=( rational const &rhs ) {
+			return *this = *this * rhs;
+		}
+
+		constexpr rational &operator/=( rational const &rhs ) {
+			return *this = *this / rhs;
+		}
+
+		/// @brief -1, 0 or 1 as lhs is less than, equal to or greater than rhs.
+		/// The terms do not need to be reduced
+		[[nodiscard]] static constexpr int compare( rational const &lhs,
+		                                            rational const &rhs ) noexcept {
+			return sint_impl::compare(
+			  mul_wide( integer_type( lhs.m_num ), integer_type( rhs.m_den ) ),
+			  mul_wide( integer_type( rhs.m_num ), integer_type( lhs.m_den ) ) );
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator==( rational const &lhs, rational const &rhs ) noexcept {
+			return compare( lhs, rhs ) == 0;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator!=( rational const &lhs, rational const &rhs ) noexcept {
+			return compare( lhs, rhs ) != 0;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator<( rational const &lhs, rational const &rhs ) noexcept {
+			return compare( lhs, rhs ) < 0;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator<=( rational const &lhs, rational const &rhs ) noexcept {
+			return compare( lhs, rhs ) <= 0;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator>( rational const &lhs, rational const &rhs ) noexcept {
+			return compare( lhs, rhs ) > 0;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator>=( rational const &lhs, rational const &rhs ) noexcept {
+			return compare( lhs, rhs ) >= 0;
+		}
+	};
+
+	using rational32 = rational<32>;
+	using rational64 = rational<64>;
+} // namespace daw::integers
@@ -0,0 +1,294 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace daw::integers {
+	namespace sint_impl {
+		inline constexpr std::size_t ring_cache_line_size = 64;
+
+		/// @brief Round a requested ring capacity up to a power of two.  A
+		/// capacity of zero or one above 2^62 is reported via
+		/// on_signed_integer_out_of_range and clamped
+		DAW_ATTRIB_INLINE std::size_t ring_capacity( std::size_t requested ) {
+			constexpr auto max_capacity = std::size_t{ 1 } << 62U;
+			if( DAW_UNLIKELY( requested == 0 or requested > max_capacity ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				requested = ( std::clamp )( requested, std::size_t{ 1 }, max_capacity );
+			}
+			std::size_t result = 1;
+			while( result < requested ) {
+				result <<= 1U;
+			}
+			return result;
+		}
+
+		DAW_ATTRIB_INLINE i64 ring_offset( std::size_t n ) noexcept {
+			return i64( static_cast<std::int64_t>( n ) );
+		}
+
+		/// @brief Slot of a position.  Positions are wrapped i64 counters; since
+		/// the capacity is a power of two the low bits are the same before and
+		/// after a wrap
+		DAW_ATTRIB_INLINE std::size_t ring_slot( i64 position,
+		                                         std::size_t mask ) noexcept {
+			return static_cast<std::size_t>(
+			         static_cast<std::uint64_t>( position.value( ) ) ) &
+			       mask;
+		}
+	} // namespace sint_impl
+
+	/// @brief A bounded single producer, single consumer queue.  The head and
+	/// tail are i64 positions advanced with add_wrapped and compared by their
+	/// wrapped difference, so wrapping the counters is harmless.  Each side
+	/// keeps a cached copy of the other's position on its own cache line and
+	/// only reloads it when the queue looks full or empty.
+	/// @tparam T A default constructible and move assignable type
+	template<typename T>
+	struct spsc_ring_buffer {
+		static_assert( std::is_default_constructible_v<T> and
+		               std::is_move_assignable_v<T> );
+		using value_type = T;
+		using size_type = std::size_t;
+
+	private:
+		static constexpr auto line_size = sint_impl::ring_cache_line_size;
+
+		size_type m_mask;
+		std::unique_ptr<T[]> m_slots;
+		// Written by the producer
+		alignas( line_size ) std::atomic<i64> m_tail = i64( 0 );
+		i64 m_cached_head = i64( 0 );
+		// Written by the consumer
+		alignas( line_size ) std::atomic<i64> m_head = i64( 0 );
+		i64 m_cached_tail = i64( 0 );
+
+	public:
+		/// @param capacity Rounded up to a power of two
+		/// @param start The initial value of the head and tail positions
+		explicit spsc_ring_buffer( size_type capacity, i64 start = i64( 0 ) )
+		  : m_mask( sint_impl::ring_capacity( capacity ) - 1 )
+		  , m_slots( std::make_unique<T[]>( m_mask + 1 ) )
+		  , m_tail( start )
+		  , m_cached_head( start )
+		  , m_head( start )
+		  , m_cached_tail( start ) {}
+
+		spsc_ring_buffer( spsc_ring_buffer const & ) = delete;
+		spsc_ring_buffer &operator=( spsc_ring_buffer const & ) = delete;
+
+		[[nodiscard]] size_type capacity( ) const noexcept {
+			return m_mask + 1;
+		}
+
+		/// @brief Number of elements in the queue.  Only approximate while the
+		/// other side is running
+		[[nodiscard]] size_type size( ) const noexcept {
+			auto const tail = m_tail.load( std::memory_order_acquire );
+			auto const head = m_head.load( std::memory_order_acquire );
+			return static_cast<size_type>( tail.sub_wrapped( head ).value( ) );
+		}
+
+		/// @brief Producer only.  Move up to count elements from values into
+		/// the queue
+		/// @return The number of elements pushed
+		size_type push( T *values, size_type count ) {
+			auto const tail = m_tail.load( std::memory_order_relaxed );
+			auto const free_slots = [&] {
+				return capacity( ) - static_cast<size_type>(
+				                       tail.sub_wrapped( m_cached_head ).value( ) );
+			};
+			auto free = free_slots( );
+			if( free < count ) {
+				m_cached_head = m_head.load( std::memory_order_acquire );
+				free = free_slots( );
+			}
+			count = ( std::min )( count, free );
+			for( size_type n = 0; n < count; ++n ) {
+				auto const pos = tail.add_wrapped( sint_impl::ring_offset( n ) );
+				m_slots[sint_impl::ring_slot( pos, m_mask )] = std::move( values[n] );
+			}
+			m_tail.store( tail.add_wrapped( sint_impl::ring_offset( count ) ),
+			              std::memory_order_release );
+			return count;
+		}
+
+		/// @brief Producer only
+		/// @return true when value was pushed
+		[[nodiscard]] bool try_push( T value ) {
+			return push( &value, 1 ) == 1;
+		}
+
+		/// @brief Consumer only.  Move up to count elements from the queue to
+		/// out
+		/// @return The number of elements popped
+		size_type pop( T *out, size_type count ) {
+			auto const head = m_head.load( std::memory_order_relaxed );
+			auto available =
+			  static_cast<size_type>( m_cached_tail.sub_wrapped( head ).value( ) );
+			if( available < count ) {
+				m_cached_tail = m_tail.load( std::memory_order_acquire );
+				available =
+				  static_cast<size_type>( m_cached_tail.sub_wrapped( head ).value( ) );
+			}
+			count = ( std::min )( count, available );
+			for( size_type n = 0; n < count; ++n ) {
+				auto const pos = head.add_wrapped( sint_impl::ring_offset( n ) );
+				out[n] = std::move( m_slots[sint_impl::ring_slot( pos, m_mask )] );
+			}
+			m_head.store( head.add_wrapped( sint_impl::ring_offset( count ) ),
+			              std::memory_order_release );
+			return count;
+		}
+
+		/// @brief Consumer only
+		/// @return true when an element was popped into out
+		[[nodiscard]] bool try_pop( T &out ) {
+			return pop( &out, 1 ) == 1;
+		}
+	};
+
+	/// @brief A bounded multi producer, multi consumer queue.  Each slot has an
+	/// i64 sequence that says which lap of the ring it is ready for;
+	/// producers and consumers claim positions with a CAS and compare
+	/// positions to slot sequences by their wrapped difference, so the
+	/// counters may wrap.
+	/// @tparam T A default constructible and move assignable type
+	template<typename T>
+	struct mpmc_ring_buffer {
+		static_assert( std::is_default_constructible_v<T> and
+		               std::is_move_assignable_v<T> );
+		using value_type = T;
+		using size_type = std::size_t;
+
+	private:
+		static constexpr auto line_size = sint_impl::ring_cache_line_size;
+
+		struct slot_t {
+			std::atomic<i64> sequence;
+			T value;
+		};
+
+		size_type m_mask;
+		std::unique_ptr<slot_t[]> m_slots;
+		alignas( line_size ) std::atomic<i64> m_tail = i64( 0 );
+		alignas( line_size ) std::atomic<i64> m_head = i64( 0 );
+
+		/// value is only moved from when it is pushed
+		[[nodiscard]] bool push_one( T &value ) {
+			auto pos = m_tail.load( std::memory_order_relaxed );
+			while( true ) {
+				auto &slot = m_slots[sint_impl::ring_slot( pos, m_mask )];
+				auto const seq = slot.sequence.load( std::memory_order_acquire );
+				auto const diff = seq.sub_wrapped( pos );
+				if( diff == 0 ) {
+					if( m_tail.compare_exchange_weak( pos, pos.add_wrapped( i64( 1 ) ),
+					                                  std::memory_order_relaxed ) ) {
+						slot.value = std::move( value );
+						slot.sequence.store( pos.add_wrapped( i64( 1 ) ),
+						                     std::memory_order_release );
+						return true;
+					}
+				} else if( diff < 0 ) {
+					return false;
+				} else {
+					pos = m_tail.load( std::memory_order_relaxed );
+				}
+			}
+		}
+
+	public:
+		/// @param capacity Rounded up to a power of two
+		/// @param start The initial value of the head and tail positions
+		explicit mpmc_ring_buffer( size_type capacity, i64 start = i64( 0 ) )
+		  : m_mask( sint_impl::ring_capacity( capacity ) - 1 )
+		  , m_slots( std::make_unique<slot_t[]>( m_mask + 1 ) )
+		  , m_tail( start )
+		  , m_head( start ) {
+			for( size_type n = 0; n <= m_mask; ++n ) {
+				auto const pos = start.add_wrapped( sint_impl::ring_offset( n ) );
+				m_slots[sint_impl::ring_slot( pos, m_mask )].sequence.store(
+				  pos, std::memory_order_relaxed );
+			}
+		}
+
+		mpmc_ring_buffer( mpmc_ring_buffer const & ) = delete;
+		mpmc_ring_buffer &operator=( mpmc_ring_buffer const & ) = delete;
+
+		[[nodiscard]] size_type capacity( ) const noexcept {
+			return m_mask + 1;
+		}
+
+		/// @return true when value was pushed, false when the queue is full
+		[[nodiscard]] bool try_push( T value ) {
+			return push_one( value );
+		}
+
+		/// @return true when an element was popped into out, false when the
+		/// queue is empty
+		[[nodiscard]] bool try_pop( T &out ) {
+			auto pos = m_head.load( std::memory_order_relaxed );
+			while( true ) {
+				auto &slot = m_slots[sint_impl::ring_slot( pos, m_mask )];
+				auto const seq = slot.sequence.load( std::memory_order_acquire );
+				auto const diff = seq.sub_wrapped( pos.add_wrapped( i64( 1 ) ) );
+				if( diff == 0 ) {
+					if( m_head.compare_exchange_weak( pos, pos.add_wrapped( i64( 1 ) ),
+					                                  std::memory_order_relaxed ) ) {
+						out = std::move( slot.value );
+						auto const next_lap =
+						  pos.add_wrapped( sint_impl::ring_offset( capacity( ) ) );
+						slot.sequence.store( next_lap, std::memory_order_release );
+						return true;
+					}
+				} else if( diff < 0 ) {
+					return false;
+				} else {
+					pos = m_head.load( std::memory_order_relaxed );
+				}
+			}
+		}
+
+		/// @brief Move up to count elements from values into the queue, stopping
+		/// when it is full
+		/// @return The number of elements pushed
+		size_type push( T *values, size_type count ) {
+			size_type n = 0;
+			while( n < count and push_one( values[n] ) ) {
+				++n;
+			}
+			return n;
+		}
+
+		/// @brief Move up to count elements from the queue to out, stopping when
+		/// it is empty
+		/// @return The number of elements popped
+		size_type pop( T *out, size_type count ) {
+			size_type n = 0;
+			while( n < count and try_pop( out[n] ) ) {
+				++n;
+			}
+			return n;
+		}
+	};
+} // namespace daw::integers
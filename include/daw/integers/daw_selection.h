@@ -0,0 +1,270 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace daw::integers {
+	namespace sint_impl {
+		/// Values are tested against the heap threshold a block at a time, the
+		/// test is a branch free reduction that compilers vectorize
+		inline constexpr std::size_t top_k_block_size = 32;
+
+		/// Below this many candidates per thread, a radix pass runs on the
+		/// calling thread
+		inline constexpr std::size_t radix_min_parallel_count = 1U << 16U;
+
+		inline constexpr std::size_t radix_digit_bits = 8;
+		inline constexpr std::size_t radix_buckets = 1U << radix_digit_bits;
+
+		using radix_histogram_t = std::array<std::size_t, radix_buckets>;
+
+		/// @brief Map a signed value to an unsigned key with the same ordering
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr std::make_unsigned_t<T>
+		order_preserving_key( T value ) noexcept {
+			using unsigned_t = std::make_unsigned_t<T>;
+			return static_cast<unsigned_t>(
+			  static_cast<unsigned_t>( value ) ^
+			  ( unsigned_t{ 1 } << ( sizeof( T ) * CHAR_BIT - 1 ) ) );
+		}
+
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr std::size_t digit_of( T value,
+		                                                  std::size_t shift ) {
+			return static_cast<std::size_t>( order_preserving_key( value ) >>
+			                                 shift ) &
+			       ( radix_buckets - 1 );
+		}
+
+		template<typename T>
+		void radix_histogram( T const *values, std::size_t count,
+		                      std::size_t shift, radix_histogram_t &hist ) {
+			hist = radix_histogram_t{ };
+			for( std::size_t n = 0; n < count; ++n ) {
+				++hist[digit_of( values[n], shift )];
+			}
+		}
+
+		template<typename T>
+		std::size_t radix_compact( T const *values, std::size_t count,
+		                           std::size_t shift, std::size_t digit,
+		                           T *out ) {
+			// Most values are rejected, so the branch predicts well
+			std::size_t pos = 0;
+			for( std::size_t n = 0; n < count; ++n ) {
+				if( digit_of( values[n], shift ) == digit ) {
+					out[pos++] = values[n];
+				}
+			}
+			return pos;
+		}
+
+		/// @brief One radix select pass.  Finds the digit holding the k'th
+		/// smallest candidate, reduces k to its rank within that digit and
+		/// moves the candidates with that digit to out.  Chunks of the input
+		/// are handled by separate threads when thread_count > 1
+		/// @return The number of candidates with that digit.  When this is
+		/// count, nothing is moved
+		template<typename T>
+		std::size_t radix_select_pass( T const *values, std::size_t count,
+		                               std::size_t shift, std::size_t &k,
+		                               std::size_t &digit, std::vector<T> &out,
+		                               std::size_t thread_count ) {
+			thread_count = ( std::max )(
+			  std::size_t{ 1 },
+			  ( std::min )( thread_count, count / radix_min_parallel_count ) );
+			auto const chunk_size = ( count + thread_count - 1 ) / thread_count;
+			auto hists = std::vector<radix_histogram_t>( thread_count );
+			auto const chunk_first = [&]( std::size_t t ) {
+				return ( std::min )( t * chunk_size, count );
+			};
+			auto const chunk_count = [&]( std::size_t t ) {
+				return chunk_first( t + 1 ) - chunk_first( t );
+			};
+			auto const run = [&]( auto const &func ) {
+				auto threads = std::vector<std::thread>( );
+				threads.reserve( thread_count - 1 );
+				for( std::size_t t = 1; t < thread_count; ++t ) {
+					threads.emplace_back( func, t );
+				}
+				func( std::size_t{ 0 } );
+				for( auto &th : threads ) {
+					th.join( );
+				}
+			};
+			run( [&]( std::size_t t ) {
+				radix_histogram( values + chunk_first( t ), chunk_count( t ), shift,
+				                 hists[t] );
+			} );
+			auto totals = radix_histogram_t{ };
+			for( auto const &hist : hists ) {
+				for( std::size_t b = 0; b < radix_buckets; ++b ) {
+					totals[b] += hist[b];
+				}
+			}
+			digit = 0;
+			while( k >= totals[digit] ) {
+				k -= totals[digit];
+				++digit;
+			}
+			if( totals[digit] == count ) {
+				// Every candidate shares the digit, nothing to move
+				return count;
+			}
+			if( out.size( ) < totals[digit] ) {
+				out.resize( totals[digit] );
+			}
+			auto offsets = std::vector<std::size_t>( thread_count );
+			for( std::size_t t = 1; t < thread_count; ++t ) {
+				offsets[t] = offsets[t - 1] + hists[t - 1][digit];
+			}
+			run( [&]( std::size_t t ) {
+				(void)radix_compact( values + chunk_first( t ), chunk_count( t ), shift,
+				                     digit, out.data( ) + offsets[t] );
+			} );
+			return totals[digit];
+		}
+
+		template<typename T>
+		T radix_select( T const *values, std::size_t count, std::size_t k,
+		                std::size_t thread_count ) {
+			using unsigned_t = std::make_unsigned_t<T>;
+			// Candidates move between two buffers so that passes never read and
+			// write the same memory from different threads
+			std::vector<T> buffers[2];
+			std::size_t next = 0;
+			T const *first = values;
+			unsigned_t key = 0;
+			for( std::size_t pass = 0; pass < sizeof( T ); ++pass ) {
+				auto const shift = ( sizeof( T ) - 1 - pass ) * radix_digit_bits;
+				auto &out = buffers[next];
+				std::size_t digit = 0;
+				auto const remaining =
+				  radix_select_pass( first, count, shift, k, digit, out, thread_count );
+				key = static_cast<unsigned_t>(
+				  key | ( static_cast<unsigned_t>( digit ) << shift ) );
+				if( remaining != count ) {
+					first = out.data( );
+					count = remaining;
+					next ^= 1U;
+				}
+			}
+			return static_cast<T>( static_cast<unsigned_t>(
+			  key ^ ( unsigned_t{ 1 } << ( sizeof( T ) * CHAR_BIT - 1 ) ) ) );
+		}
+
+		template<typename T>
+		std::size_t top_k( T const *values, std::size_t count, T *out,
+		                   std::size_t k ) {
+			k = ( std::min )( k, count );
+			if( k == 0 ) {
+				return 0;
+			}
+			// Min heap of the k largest seen so far, out[0] is the threshold
+			auto const cmp = std::greater<T>{ };
+			std::copy_n( values, k, out );
+			std::make_heap( out, out + k, cmp );
+			auto const insert = [&]( T value ) {
+				if( value > out[0] ) {
+					std::pop_heap( out, out + k, cmp );
+					out[k - 1] = value;
+					std::push_heap( out, out + k, cmp );
+				}
+			};
+			std::size_t n = k;
+			for( ; n + top_k_block_size <= count; n += top_k_block_size ) {
+				auto const threshold = out[0];
+				bool any_greater = false;
+				for( std::size_t m = 0; m < top_k_block_size; ++m ) {
+					any_greater |= values[n + m] > threshold;
+				}
+				if( DAW_LIKELY( not any_greater ) ) {
+					continue;
+				}
+				for( std::size_t m = 0; m < top_k_block_size; ++m ) {
+					insert( values[n + m] );
+				}
+			}
+			for( ; n < count; ++n ) {
+				insert( values[n] );
+			}
+			std::sort_heap( out, out + k, cmp );
+			return k;
+		}
+	} // namespace sint_impl
+
+	/// @brief Write the k largest of values to out in descending order, where
+	/// k is out_size.  A min heap holds the current k largest and blocks of
+	/// values are rejected in bulk against the smallest of them, so the cost
+	/// for large inputs is close to a single vectorized scan
+	/// @return The number of elements written, the smaller of count and
+	/// out_size
+	template<std::size_t Bits>
+	std::size_t top_k( signed_integer<Bits> const *values, std::size_t count,
+	                   signed_integer<Bits> *out, std::size_t out_size ) {
+		return sint_impl::top_k( sint_impl::raw_ptr( values ), count,
+		                         sint_impl::raw_ptr( out ), out_size );
+	}
+
+	template<typename Values, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Values const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	std::size_t top_k( Values const &values, Out &&out ) {
+		return top_k( std::data( values ), std::size( values ), std::data( out ),
+		              std::size( out ) );
+	}
+
+	/// @brief The value that would be at position k if values were sorted in
+	/// ascending order, the same as std::nth_element but without modifying
+	/// values.  This is an MSD radix select; two passes over the input then
+	/// passes over a shrinking set of candidates.
+	/// @param thread_count When greater than 1, the histogram and partition of
+	/// large passes are split across that many threads
+	/// @return The selected value.  When k >= count,
+	/// on_signed_integer_out_of_range is called and min( ) is returned
+	template<std::size_t Bits>
+	[[nodiscard]] signed_integer<Bits>
+	radix_select( signed_integer<Bits> const *values, std::size_t count,
+	              std::size_t k, std::size_t thread_count = 1 ) {
+		if( DAW_UNLIKELY( k >= count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			return signed_integer<Bits>::min( );
+		}
+		return signed_integer<Bits>( sint_impl::radix_select(
+		  sint_impl::raw_ptr( values ), count, k, thread_count ) );
+	}
+
+	template<typename Values,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Values const>,
+	                          std::nullptr_t> = nullptr>
+	[[nodiscard]] auto radix_select( Values const &values, std::size_t k,
+	                                 std::size_t thread_count = 1 ) {
+		return radix_select( std::data( values ), std::size( values ), k,
+		                     thread_count );
+	}
+} // namespace daw::integers
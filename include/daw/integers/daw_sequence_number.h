@@ -0,0 +1,150 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+
+#include <daw/daw_attributes.h>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace daw::integers {
+	/// @brief A serial number as described in RFC 1982.  All arithmetic wraps
+	/// modulo 2^Bits and values are ordered by their wrapped distance, so a
+	/// counter that wraps past max( ) still compares greater than the values
+	/// shortly before it.  Two values exactly 2^(Bits-1) apart are unordered;
+	/// neither compares less than the other.
+	template<std::size_t Bits>
+	struct sequence_number {
+		using value_type = signed_integer<Bits>;
+		using difference_type = signed_integer<Bits>;
+
+	private:
+		value_type m_value = value_type( 0 );
+
+	public:
+		constexpr sequence_number( ) = default;
+
+		explicit constexpr sequence_number( value_type value ) noexcept
+		  : m_value( value ) {}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr value_type
+		value( ) const noexcept {
+			return m_value;
+		}
+
+		/// @brief The signed wrapped distance from this to other.  Positive when
+		/// other comes after this
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr difference_type
+		distance_to( sequence_number other ) const noexcept {
+			return other.m_value.sub_wrapped( m_value );
+		}
+
+		DAW_ATTRIB_INLINE constexpr sequence_number &
+		operator+=( difference_type n ) noexcept {
+			m_value = m_value.add_wrapped( n );
+			return *this;
+		}
+
+		DAW_ATTRIB_INLINE constexpr sequence_number &
+		operator-=( difference_type n ) noexcept {
+			m_value = m_value.sub_wrapped( n );
+			return *this;
+		}
+
+		DAW_ATTRIB_INLINE constexpr sequence_number &operator++( ) noexcept {
+			return *this += difference_type( 1 );
+		}
+
+		DAW_ATTRIB_INLINE constexpr sequence_number operator++( int ) noexcept {
+			auto result = *this;
+			operator++( );
+			return result;
+		}
+
+		DAW_ATTRIB_INLINE constexpr sequence_number &operator--( ) noexcept {
+			return *this -= difference_type( 1 );
+		}
+
+		DAW_ATTRIB_INLINE constexpr sequence_number operator--( int ) noexcept {
+			auto result = *this;
+			operator--( );
+			return result;
+		}
+	};
+
+	template<std::size_t Bits>
+	sequence_number( signed_integer<Bits> ) -> sequence_number<Bits>;
+
+	using seq8 = sequence_number<8>;
+	using seq16 = sequence_number<16>;
+	using seq32 = sequence_number<32>;
+	using seq64 = sequence_number<64>;
+
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr sequence_number<Bits>
+	operator+( sequence_number<Bits> lhs, signed_integer<Bits> n ) noexcept {
+		lhs += n;
+		return lhs;
+	}
+
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr sequence_number<Bits>
+	operator-( sequence_number<Bits> lhs, signed_integer<Bits> n ) noexcept {
+		lhs -= n;
+		return lhs;
+	}
+
+	/// @brief The signed wrapped distance from rhs to lhs
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer<Bits>
+	operator-( sequence_number<Bits> lhs, sequence_number<Bits> rhs ) noexcept {
+		return rhs.distance_to( lhs );
+	}
+
+	// Equality
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr bool
+	operator==( sequence_number<Bits> lhs, sequence_number<Bits> rhs ) noexcept {
+		return lhs.value( ) == rhs.value( );
+	}
+
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr bool
+	operator!=( sequence_number<Bits> lhs, sequence_number<Bits> rhs ) noexcept {
+		return lhs.value( ) != rhs.value( );
+	}
+
+	// Serial ordering.  These are a wrapped subtract and a sign test, with no
+	// branches
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr bool
+	operator<( sequence_number<Bits> lhs, sequence_number<Bits> rhs ) noexcept {
+		return lhs.distance_to( rhs ) > 0;
+	}
+
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr bool
+	operator>( sequence_number<Bits> lhs, sequence_number<Bits> rhs ) noexcept {
+		return rhs.distance_to( lhs ) > 0;
+	}
+
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr bool
+	operator<=( sequence_number<Bits> lhs, sequence_number<Bits> rhs ) noexcept {
+		return ( lhs == rhs ) | ( lhs < rhs );
+	}
+
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr bool
+	operator>=( sequence_number<Bits> lhs, sequence_number<Bits> rhs ) noexcept {
+		return ( lhs == rhs ) | ( lhs > rhs );
+	}
+} // namespace daw::integers
@@ -0,0 +1,413 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+#include "impl/daw_signed_simd.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace daw::integers {
+	namespace sint_impl {
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+		template<std::size_t Bits>
+		DAW_ATTRIB_INLINE __m256i shl_lanes( __m256i v, __m128i count ) {
+			if constexpr( Bits == 16 ) {
+				return _mm256_sll_epi16( v, count );
+			} else if constexpr( Bits == 32 ) {
+				return _mm256_sll_epi32( v, count );
+			} else {
+				return _mm256_sll_epi64( v, count );
+			}
+		}
+
+		template<std::size_t Bits>
+		DAW_ATTRIB_INLINE __m256i shr_logical_lanes( __m256i v, __m128i count ) {
+			if constexpr( Bits == 16 ) {
+				return _mm256_srl_epi16( v, count );
+			} else if constexpr( Bits == 32 ) {
+				return _mm256_srl_epi32( v, count );
+			} else {
+				return _mm256_srl_epi64( v, count );
+			}
+		}
+
+		/// @brief All ones in the negative lanes
+		template<std::size_t Bits>
+		DAW_ATTRIB_INLINE __m256i sign_lanes( __m256i v ) {
+			if constexpr( Bits == 16 ) {
+				return _mm256_srai_epi16( v, 15 );
+			} else if constexpr( Bits == 32 ) {
+				return _mm256_srai_epi32( v, 31 );
+			} else {
+				return _mm256_cmpgt_epi64( _mm256_setzero_si256( ), v );
+			}
+		}
+
+		template<std::size_t Bits>
+		DAW_ATTRIB_INLINE __m256i cmpeq_lanes( __m256i a, __m256i b ) {
+			if constexpr( Bits == 16 ) {
+				return _mm256_cmpeq_epi16( a, b );
+			} else if constexpr( Bits == 32 ) {
+				return _mm256_cmpeq_epi32( a, b );
+			} else {
+				return _mm256_cmpeq_epi64( a, b );
+			}
+		}
+
+		template<std::size_t Bits>
+		DAW_ATTRIB_INLINE __m256i cmpgt_lanes( __m256i a, __m256i b ) {
+			if constexpr( Bits == 32 ) {
+				return _mm256_cmpgt_epi32( a, b );
+			} else {
+				return _mm256_cmpgt_epi64( a, b );
+			}
+		}
+
+		template<std::size_t Bits>
+		DAW_ATTRIB_INLINE __m256i set1_lanes( signed_integer_type_t<Bits> v ) {
+			if constexpr( Bits == 16 ) {
+				return _mm256_set1_epi16( v );
+			} else if constexpr( Bits == 32 ) {
+				return _mm256_set1_epi32( v );
+			} else {
+				return _mm256_set1_epi64x( v );
+			}
+		}
+#endif
+
+		/// @brief Shift each of values left by count, stopping at the first
+		/// element that loses significant bits when not saturating.  count is in
+		/// [0, Bits)
+		/// @return The number of elements written
+		template<bool Saturate, std::size_t Bits>
+		std::size_t shl_block( signed_integer_type_t<Bits> const *values,
+		                       std::size_t size, signed_integer_type_t<Bits> count,
+		                       signed_integer_type_t<Bits> *out ) noexcept {
+			using value_type = signed_integer_type_t<Bits>;
+			using unsigned_t = std::make_unsigned_t<value_type>;
+			std::size_t n = 0;
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+			if constexpr( Bits >= 16 ) {
+				constexpr std::size_t lanes = 32 / sizeof( value_type );
+				auto const shift = _mm_cvtsi32_si128( static_cast<int>( count ) );
+				// The bits shifted out, and the new sign bit, must all match the
+				// sign.  Flipping negative lanes makes that "are all zero"
+				auto const check = _mm_cvtsi32_si128( static_cast<int>( Bits - 1 ) -
+				                                      static_cast<int>( count ) );
+				auto const max =
+				  set1_lanes<Bits>( daw::numeric_limits<value_type>::max( ) );
+				auto const zero = _mm256_setzero_si256( );
+				for( ; n + lanes <= size; n += lanes ) {
+					auto const v = _mm256_loadu_si256(
+					  reinterpret_cast<__m256i const *>( values + n ) );
+					auto const sign = sign_lanes<Bits>( v );
+					auto const result = shl_lanes<Bits>( v, shift );
+					auto const exact = cmpeq_lanes<Bits>(
+					  shr_logical_lanes<Bits>( _mm256_xor_si256( v, sign ), check ),
+					  zero );
+					if constexpr( Saturate ) {
+						auto const saturated = _mm256_xor_si256( sign, max );
+						_mm256_storeu_si256(
+						  reinterpret_cast<__m256i *>( out + n ),
+						  _mm256_blendv_epi8( saturated, result, exact ) );
+					} else {
+						if( DAW_UNLIKELY( _mm256_movemask_epi8( exact ) != -1 ) ) {
+							break;
+						}
+						_mm256_storeu_si256( reinterpret_cast<__m256i *>( out + n ),
+						                     result );
+					}
+				}
+			}
+#endif
+			for( ; n < size; ++n ) {
+				if constexpr( Saturate ) {
+					out[n] = sat_shl( values[n], count );
+				} else {
+					if( DAW_UNLIKELY( count > count_redundant_sign_bits( values[n] ) ) ) {
+						return n;
+					}
+					out[n] = static_cast<value_type>(
+					  static_cast<unsigned_t>( values[n] ) << count );
+				}
+			}
+			return size;
+		}
+
+		/// @brief Shift values[n] left by counts[n], stopping at the first
+		/// element that loses significant bits or has a count outside of [0,
+		/// Bits) when not saturating.  Saturating, a negative count is reported
+		/// via on_signed_integer_overflow and the value is passed through
+		/// @return The number of elements written
+		template<bool Saturate, std::size_t Bits>
+		std::size_t shl_block( signed_integer_type_t<Bits> const *values,
+		                       signed_integer_type_t<Bits> const *counts,
+		                       std::size_t size,
+		                       signed_integer_type_t<Bits> *out ) noexcept {
+			using value_type = signed_integer_type_t<Bits>;
+			using unsigned_t = std::make_unsigned_t<value_type>;
+			auto const shl_one = [&]( std::size_t n ) {
+				auto const count = counts[n];
+				if constexpr( Saturate ) {
+					out[n] = sat_shl( values[n], count );
+					return true;
+				} else {
+					if( DAW_UNLIKELY(
+					      static_cast<unsigned_t>( count ) >= Bits or
+					      count > count_redundant_sign_bits( values[n] ) ) ) {
+						return false;
+					}
+					out[n] = static_cast<value_type>(
+					  static_cast<unsigned_t>( values[n] ) << count );
+					return true;
+				}
+			};
+			std::size_t n = 0;
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+			// AVX2 only has per lane shifts, vpsllv, for 32 and 64 bit lanes
+			if constexpr( Bits >= 32 ) {
+				constexpr std::size_t lanes = 32 / sizeof( value_type );
+				auto const max =
+				  set1_lanes<Bits>( daw::numeric_limits<value_type>::max( ) );
+				auto const last_bit = set1_lanes<Bits>( Bits - 1 );
+				auto const zero = _mm256_setzero_si256( );
+				for( ; n + lanes <= size; n += lanes ) {
+					auto const v = _mm256_loadu_si256(
+					  reinterpret_cast<__m256i const *>( values + n ) );
+					auto const k = _mm256_loadu_si256(
+					  reinterpret_cast<__m256i const *>( counts + n ) );
+					auto const bad_count = _mm256_or_si256(
+					  cmpgt_lanes<Bits>( zero, k ), cmpgt_lanes<Bits>( k, last_bit ) );
+					if( DAW_UNLIKELY( not _mm256_testz_si256( bad_count, bad_count ) ) ) {
+						for( std::size_t l = 0; l < lanes; ++l ) {
+							if( not shl_one( n + l ) ) {
+								return n + l;
+							}
+						}
+						continue;
+					}
+					// As in the uniform count case, the bits shifted out and the new
+					// sign bit must all match the sign
+					auto const flipped = _mm256_xor_si256( v, sign_lanes<Bits>( v ) );
+					__m256i result;
+					__m256i exact;
+					if constexpr( Bits == 32 ) {
+						result = _mm256_sllv_epi32( v, k );
+						exact = _mm256_cmpeq_epi32(
+						  _mm256_srlv_epi32( flipped, _mm256_sub_epi32( last_bit, k ) ),
+						  zero );
+					} else {
+						result = _mm256_sllv_epi64( v, k );
+						exact = _mm256_cmpeq_epi64(
+						  _mm256_srlv_epi64( flipped, _mm256_sub_epi64( last_bit, k ) ),
+						  zero );
+					}
+					if constexpr( Saturate ) {
+						auto const saturated =
+						  _mm256_xor_si256( sign_lanes<Bits>( v ), max );
+						_mm256_storeu_si256(
+						  reinterpret_cast<__m256i *>( out + n ),
+						  _mm256_blendv_epi8( saturated, result, exact ) );
+					} else {
+						if( DAW_UNLIKELY( _mm256_movemask_epi8( exact ) != -1 ) ) {
+							break;
+						}
+						_mm256_storeu_si256( reinterpret_cast<__m256i *>( out + n ),
+						                     result );
+					}
+				}
+			}
+#endif
+			for( ; n < size; ++n ) {
+				if( not shl_one( n ) ) {
+					return n;
+				}
+			}
+			return size;
+		}
+	} // namespace sint_impl
+
+	/// @brief Perform out[n] = values[n] << count for each n in [0, size).  The
+	/// first element that would lose significant bits is reported via
+	/// on_signed_integer_overflow and stops the shift, as does a count outside
+	/// of [0, Bits).  out may alias values
+	/// @return The number of elements of out written.  This is size unless
+	/// bits would be lost, in which case it is the position of that element
+	template<std::size_t Bits>
+	std::size_t shl_checked( signed_integer<Bits> const *values, std::size_t size,
+	                         signed_integer<Bits> count,
+	                         signed_integer<Bits> *out ) {
+		if( DAW_UNLIKELY( count.value( ) < 0 or
+		                  count.value( ) >= static_cast<int>( Bits ) ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_overflow( );
+			return 0;
+		}
+		auto const written = sint_impl::shl_block<false, Bits>(
+		  sint_impl::raw_ptr( values ), size, count.value( ),
+		  sint_impl::raw_ptr( out ) );
+		if( DAW_UNLIKELY( written != size ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_overflow( );
+		}
+		return written;
+	}
+
+	/// @brief Perform out[n] = values[n] << counts[n] for each n in [0, size).
+	/// The first element that would lose significant bits, or whose count is
+	/// outside of [0, Bits), is reported via on_signed_integer_overflow and
+	/// stops the shift.  out may alias values
+	/// @return The number of elements of out written.  This is size unless an
+	/// element failed, in which case it is the position of that element
+	template<std::size_t Bits>
+	std::size_t shl_checked( signed_integer<Bits> const *values,
+	                         signed_integer<Bits> const *counts, std::size_t size,
+	                         signed_integer<Bits> *out ) {
+		auto const written = sint_impl::shl_block<false, Bits>(
+		  sint_impl::raw_ptr( values ), sint_impl::raw_ptr( counts ), size,
+		  sint_impl::raw_ptr( out ) );
+		if( DAW_UNLIKELY( written != size ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_overflow( );
+		}
+		return written;
+	}
+
+	/// @brief Perform out[n] = values[n] << count for each element of values.
+	/// See the pointer overload for details.  An out range that is smaller than
+	/// values is reported via on_signed_integer_out_of_range and only the
+	/// elements that fit are shifted
+	template<typename Values, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Values const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	std::size_t shl_checked( Values const &values,
+	                         sint_impl::range_value_t<Values const> count,
+	                         Out &&out ) {
+		auto size = static_cast<std::size_t>( std::size( values ) );
+		if( DAW_UNLIKELY( std::size( out ) < size ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			size = static_cast<std::size_t>( std::size( out ) );
+		}
+		return shl_checked( std::data( values ), size, count, std::data( out ) );
+	}
+
+	/// @brief Perform out[n] = values[n] << counts[n] for each element of
+	/// values.  See the pointer overload for details.  counts or out ranges
+	/// that are smaller than values are reported via
+	/// on_signed_integer_out_of_range and only the elements available are
+	/// shifted
+	template<typename Values, typename Counts, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Values const> and
+	                            sint_impl::is_contiguous_range_v<Counts const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	std::size_t shl_checked( Values const &values, Counts const &counts,
+	                         Out &&out ) {
+		auto size = static_cast<std::size_t>( std::size( values ) );
+		if( DAW_UNLIKELY( std::size( counts ) < size or
+		                  std::size( out ) < size ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			size = static_cast<std::size_t>(
+			  ( std::min )( std::size( counts ), std::size( out ) ) );
+		}
+		return shl_checked( std::data( values ), std::data( counts ), size,
+		                    std::data( out ) );
+	}
+
+	/// @brief Perform out[n] = values[n].shl_saturated( count ) for each n in
+	/// [0, size).  Elements that would lose significant bits become min( ) or
+	/// max( ) by their sign.  A negative count is reported via
+	/// on_signed_integer_overflow and values are copied unchanged.  out may
+	/// alias values
+	template<std::size_t Bits>
+	void shl_saturated( signed_integer<Bits> const *values, std::size_t size,
+	                    signed_integer<Bits> count, signed_integer<Bits> *out ) {
+		using value_type = typename signed_integer<Bits>::value_type;
+		if( DAW_UNLIKELY( count.value( ) < 0 ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_overflow( );
+			std::copy_n( values, size, out );
+			return;
+		}
+		// Only 0 and -1 survive a shift of Bits - 1, becoming 0 and min( ), so
+		// larger counts can be clamped to it
+		auto const clamped =
+		  ( std::min )( count.value( ), static_cast<value_type>( Bits - 1 ) );
+		(void)sint_impl::shl_block<true, Bits>(
+		  sint_impl::raw_ptr( values ), size, clamped, sint_impl::raw_ptr( out ) );
+	}
+
+	/// @brief Perform out[n] = values[n].shl_saturated( counts[n] ) for each n
+	/// in [0, size).  See shl_saturated on signed_integer.  out may alias
+	/// values
+	template<std::size_t Bits>
+	void shl_saturated( signed_integer<Bits> const *values,
+	                    signed_integer<Bits> const *counts, std::size_t size,
+	                    signed_integer<Bits> *out ) {
+		(void)sint_impl::shl_block<true, Bits>(
+		  sint_impl::raw_ptr( values ), sint_impl::raw_ptr( counts ), size,
+		  sint_impl::raw_ptr( out ) );
+	}
+
+	/// @brief Perform out[n] = values[n].shl_saturated( count ) for each element
+	/// of values.  An out range that is smaller than values is reported via
+	/// on_signed_integer_out_of_range and only the elements that fit are
+	/// shifted
+	template<typename Values, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Values const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	void shl_saturated( Values const &values,
+	                    sint_impl::range_value_t<Values const> count,
+	                    Out &&out ) {
+		auto size = static_cast<std::size_t>( std::size( values ) );
+		if( DAW_UNLIKELY( std::size( out ) < size ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			size = static_cast<std::size_t>( std::size( out ) );
+		}
+		shl_saturated( std::data( values ), size, count, std::data( out ) );
+	}
+
+	/// @brief Perform out[n] = values[n].shl_saturated( counts[n] ) for each
+	/// element of values.  counts or out ranges that are smaller than values
+	/// are reported via on_signed_integer_out_of_range and only the elements
+	/// available are shifted
+	template<typename Values, typename Counts, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Values const> and
+	                            sint_impl::is_contiguous_range_v<Counts const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	void shl_saturated( Values const &values, Counts const &counts, Out &&out ) {
+		auto size = static_cast<std::size_t>( std::size( values ) );
+		if( DAW_UNLIKELY( std::size( counts ) < size or
+		                  std::size( out ) < size ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			size = static_cast<std::size_t>(
+			  ( std::min )( std::size( counts ), std::size( out ) ) );
+		}
+		shl_saturated( std::data( values ), std::data( counts ), size,
+		               std::data( out ) );
+	}
+} // namespace daw::integers
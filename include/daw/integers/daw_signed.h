@@ -82,6 +82,32 @@ namespace daw::integers {
 	using i32 = signed_integer<32>;
 	using i64 = signed_integer<64>;
 
+	/// @brief Saturating operations that branch on overflow.  Fastest when
+	/// overflow is rare
+	struct saturate_branchy_t {};
+	inline constexpr saturate_branchy_t saturate_branchy{ };
+
+	/// @brief Saturating operations that select the result without a branch.
+	/// Fastest when overflow is frequent and unpredictable, e.g. clipping
+	/// audio or clamped counters
+	struct saturate_branchless_t {};
+	inline constexpr saturate_branchless_t saturate_branchless{ };
+
+	/// @brief The saturation policy used when none is passed.  Define
+	/// DAW_DEFAULT_SATURATION_BRANCHLESS to make it saturate_branchless_t
+#if defined( DAW_DEFAULT_SATURATION_BRANCHLESS )
+	using default_saturation_policy_t = saturate_branchless_t;
+#else
+	using default_saturation_policy_t = saturate_branchy_t;
+#endif
+
+	namespace sint_impl {
+		template<typename Policy>
+		inline constexpr bool is_saturation_policy_v =
+		  std::is_same_v<Policy, saturate_branchy_t> or
+		  std::is_same_v<Policy, saturate_branchless_t>;
+	} // namespace sint_impl
+
 	/// @brief Signed Integer type with overflow checked/wrapping/saturated
 	/// operations
 	template<std::size_t Bits>
@@ -180,6 +206,33 @@ namespace daw::integers {
 			return signed_integer( conversion_checked( other.value( ) ) );
 		}
 
+		/// @brief Converts a signed integer, clamping values outside of the
+		/// range to min( ) or max( )
+		/// @param other Integer to convert to signed_integer
+		/// @returns The value of other limited to [min( ), max( )]
+		template<typename I,
+		         std::enable_if_t<daw::is_integral_v<I> and daw::is_signed_v<I>,
+		                          std::nullptr_t> = nullptr>
+		[[nodiscard]] static constexpr signed_integer
+		conversion_saturated( I other ) noexcept {
+			if constexpr( sizeof( I ) > sizeof( value_type ) ) {
+				constexpr auto lo =
+				  static_cast<I>( daw::numeric_limits<value_type>::min( ) );
+				constexpr auto hi =
+				  static_cast<I>( daw::numeric_limits<value_type>::max( ) );
+				other = other < lo ? lo : ( other > hi ? hi : other );
+			}
+			return signed_integer( static_cast<value_type>( other ) );
+		}
+
+		/// @brief Converts a signed_integer of another size, clamping values
+		/// outside of the range to min( ) or max( )
+		template<std::size_t I>
+		[[nodiscard]] static constexpr signed_integer
+		conversion_saturated( signed_integer<I> other ) noexcept {
+			return conversion_saturated( other.value( ) );
+		}
+
 		/// @brief Performs an unchecked conversion between signed integer types.
 		/// @tparam I The type of the signed integer to be converted.
 		/// @param other The signed integer value to convert.
@@ -341,9 +394,18 @@ namespace daw::integers {
 
 		/// @brief saturated addition of rhs and current value and return a new
 		/// signed_integer.
+		template<typename SaturationPolicy = default_saturation_policy_t>
 		[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer
-		add_saturated( signed_integer const &rhs ) const {
-			return signed_integer( sint_impl::sat_add( value( ), rhs.value( ) ) );
+		add_saturated( signed_integer const &rhs,
+		               SaturationPolicy = SaturationPolicy{ } ) const {
+			static_assert( sint_impl::is_saturation_policy_v<SaturationPolicy>,
+			               "Expected saturate_branchy or saturate_branchless" );
+			if constexpr( std::is_same_v<SaturationPolicy, saturate_branchless_t> ) {
+				return signed_integer(
+				  sint_impl::sat_add_branchless( value( ), rhs.value( ) ) );
+			} else {
+				return signed_integer( sint_impl::sat_add( value( ), rhs.value( ) ) );
+			}
 		}
 
 		/// @brief Add rhs to this and return a ref this this.  Checked while in
@@ -395,9 +457,40 @@ namespace daw::integers {
 
 		/// @brief Subtract rhs from this and return a new signed_integer.  On
 		/// overflow value is saturated.
+		template<typename SaturationPolicy = default_saturation_policy_t>
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer
+		sub_saturated( signed_integer const &rhs,
+		               SaturationPolicy = SaturationPolicy{ } ) const {
+			static_assert( sint_impl::is_saturation_policy_v<SaturationPolicy>,
+			               "Expected saturate_branchy or saturate_branchless" );
+			if constexpr( std::is_same_v<SaturationPolicy, saturate_branchless_t> ) {
+				return signed_integer(
+				  sint_impl::sat_sub_branchless( value( ), rhs.value( ) ) );
+			} else {
+				return signed_integer( sint_impl::sat_sub( value( ), rhs.value( ) ) );
+			}
+		}
+
+		/// @brief The distance between this and rhs, |this - rhs|.  It is
+		/// returned unsigned as it can be larger than max( ), but can never
+		/// overflow
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::make_unsigned_t<value_type>
+		abs_diff( signed_integer const &rhs ) const noexcept {
+			using unsigned_t = std::make_unsigned_t<value_type>;
+			auto const l = static_cast<unsigned_t>( value( ) );
+			auto const r = static_cast<unsigned_t>( rhs.value( ) );
+			return static_cast<unsigned_t>( value( ) >= rhs.value( ) ? l - r
+			                                                         : r - l );
+		}
+
+		/// @brief The average of this and rhs, with halves rounded toward
+		/// positive infinity.  The sum is never formed, so it cannot overflow
 		[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer
-		sub_saturated( signed_integer const &rhs ) const {
-			return signed_integer( sint_impl::sat_sub( value( ), rhs.value( ) ) );
+		avg_rounded( signed_integer const &rhs ) const noexcept {
+			// a + b == 2 * ( a & b ) + ( a ^ b ) == 2 * ( a | b ) - ( a ^ b )
+			return signed_integer( static_cast<value_type>(
+			  ( value( ) | rhs.value( ) ) -
+			  ( static_cast<value_type>( value( ) ^ rhs.value( ) ) >> 1 ) ) );
 		}
 
 		/// @brief prefix increment return a ref to self. Checked in debug
@@ -456,9 +549,18 @@ namespace daw::integers {
 
 		/// @brief Perform saturated multiplication with rhs and return a new
 		/// signed_integer
+		template<typename SaturationPolicy = default_saturation_policy_t>
 		[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer
-		mul_saturated( signed_integer const &rhs ) const {
-			return signed_integer( sint_impl::sat_mul( value( ), rhs.value( ) ) );
+		mul_saturated( signed_integer const &rhs,
+		               SaturationPolicy = SaturationPolicy{ } ) const {
+			static_assert( sint_impl::is_saturation_policy_v<SaturationPolicy>,
+			               "Expected saturate_branchy or saturate_branchless" );
+			if constexpr( std::is_same_v<SaturationPolicy, saturate_branchless_t> ) {
+				return signed_integer(
+				  sint_impl::sat_mul_branchless( value( ), rhs.value( ) ) );
+			} else {
+				return signed_integer( sint_impl::sat_mul( value( ), rhs.value( ) ) );
+			}
 		}
 
 		DAW_ATTRIB_INLINE constexpr signed_integer &
@@ -552,6 +654,13 @@ namespace daw::integers {
 			return value( ) << rhs.value( );
 		}
 
+		/// @brief Shift left by rhs.  When significant bits would be lost the
+		/// result is saturated to min( ) or max( ) by the sign of this
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer
+		shl_saturated( signed_integer const &rhs ) const {
+			return signed_integer( sint_impl::sat_shl( value( ), rhs.value( ) ) );
+		}
+
 		[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer
 		shl_overflowing( signed_integer n ) const {
 			if( n < 0 ) {
@@ -561,7 +670,9 @@ namespace daw::integers {
 				return *this;
 			}
 			n &= sizeof( value_type ) * CHAR_BIT - 1;
-			return signed_integer( value( ) << n.value( ) );
+			return signed_integer( static_cast<value_type>(
+			  static_cast<std::make_unsigned_t<value_type>>( value( ) )
+			  << n.value( ) ) );
 		}
 
 		template<typename I,
@@ -575,7 +686,8 @@ namespace daw::integers {
 				return *this;
 			}
 			n &= sizeof( value_type ) * CHAR_BIT - 1;
-			return signed_integer( value( ) << n );
+			return signed_integer( static_cast<value_type>(
+			  static_cast<std::make_unsigned_t<value_type>>( value( ) ) << n ) );
 		}
 
 		DAW_ATTRIB_INLINE constexpr signed_integer &
@@ -714,6 +826,26 @@ namespace daw::integers {
 			return daw::cxmath::count_trailing_zeros(
 			  daw::cxmath::to_unsigned( value( ) ) );
 		}
+
+		/// @brief Gather the bits selected by mask into the low bits of the
+		/// result, e.g. 0b1011'0100.extract_bits( 0b1111'0000 ) is 0b1011.  Uses
+		/// pext when BMI2 is available
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer
+		extract_bits( signed_integer const &mask ) const noexcept {
+			return signed_integer( daw::cxmath::to_signed( sint_impl::extract_bits(
+			  daw::cxmath::to_unsigned( value( ) ),
+			  daw::cxmath::to_unsigned( mask.value( ) ) ) ) );
+		}
+
+		/// @brief Scatter the low bits to the positions set in mask, e.g.
+		/// 0b1011.deposit_bits( 0b1111'0000 ) is 0b1011'0000.  Uses pdep when
+		/// BMI2 is available
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer
+		deposit_bits( signed_integer const &mask ) const noexcept {
+			return signed_integer( daw::cxmath::to_signed( sint_impl::deposit_bits(
+			  daw::cxmath::to_unsigned( value( ) ),
+			  daw::cxmath::to_unsigned( mask.value( ) ) ) ) );
+		}
 	};
 
 	template<typename I,
@@ -735,7 +867,9 @@ namespace daw::integers {
 		return result;
 	}
 
-	template<std::size_t Lhs, typename Rhs>
+	template<std::size_t Lhs, typename Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Rhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator+( signed_integer<Lhs> lhs, Rhs rhs ) {
 		using lhs_t = sint_impl::signed_integer_type_t<Lhs>;
@@ -746,7 +880,9 @@ namespace daw::integers {
 		return result;
 	}
 
-	template<typename Lhs, std::size_t Rhs>
+	template<typename Lhs, std::size_t Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Lhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator+( Lhs lhs, signed_integer<Rhs> rhs ) {
 		using lhs_t = Lhs;
@@ -767,11 +903,13 @@ namespace daw::integers {
 		using result_t = sint_impl::int_result_t<lhs_t, rhs_t>;
 
 		auto result = result_t( lhs.value( ) );
-		result += result_t( rhs.value( ) );
+		result -= result_t( rhs.value( ) );
 		return result;
 	}
 
-	template<std::size_t Lhs, typename Rhs>
+	template<std::size_t Lhs, typename Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Rhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator-( signed_integer<Lhs> lhs, Rhs rhs ) {
 		using lhs_t = sint_impl::signed_integer_type_t<Lhs>;
@@ -783,7 +921,9 @@ namespace daw::integers {
 		return result;
 	}
 
-	template<typename Lhs, std::size_t Rhs>
+	template<typename Lhs, std::size_t Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Lhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator-( Lhs lhs, signed_integer<Rhs> rhs ) {
 		using lhs_t = Lhs;
@@ -808,7 +948,9 @@ namespace daw::integers {
 		return result;
 	}
 
-	template<std::size_t Lhs, typename Rhs>
+	template<std::size_t Lhs, typename Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Rhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator*( signed_integer<Lhs> lhs, Rhs rhs ) {
 		using lhs_t = sint_impl::signed_integer_type_t<Lhs>;
@@ -819,7 +961,9 @@ namespace daw::integers {
 		return result;
 	}
 
-	template<typename Lhs, std::size_t Rhs>
+	template<typename Lhs, std::size_t Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Lhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator*( Lhs lhs, signed_integer<Rhs> rhs ) {
 		using lhs_t = Lhs;
@@ -842,7 +986,9 @@ namespace daw::integers {
 		return result;
 	}
 
-	template<std::size_t Lhs, typename Rhs>
+	template<std::size_t Lhs, typename Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Rhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator/( signed_integer<Lhs> lhs, Rhs rhs ) {
 		using lhs_t = sint_impl::signed_integer_type_t<Lhs>;
@@ -853,7 +999,9 @@ namespace daw::integers {
 		return result;
 	}
 
-	template<typename Lhs, std::size_t Rhs>
+	template<typename Lhs, std::size_t Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Lhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator/( Lhs lhs, signed_integer<Rhs> rhs ) {
 		using lhs_t = Lhs;
@@ -876,7 +1024,9 @@ namespace daw::integers {
 		return result;
 	}
 
-	template<std::size_t Lhs, typename Rhs>
+	template<std::size_t Lhs, typename Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Rhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator%( signed_integer<Lhs> lhs, Rhs rhs ) {
 		using lhs_t = sint_impl::signed_integer_type_t<Lhs>;
@@ -887,7 +1037,9 @@ namespace daw::integers {
 		return result;
 	}
 
-	template<typename Lhs, std::size_t Rhs>
+	template<typename Lhs, std::size_t Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Lhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator%( Lhs lhs, signed_integer<Rhs> rhs ) {
 		using lhs_t = Lhs;
@@ -908,7 +1060,9 @@ namespace daw::integers {
 		return result_t( lhs.m_private.value ) <<= result_t( rhs.value( ) );
 	}
 
-	template<std::size_t Lhs, typename Rhs>
+	template<std::size_t Lhs, typename Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Rhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator<<( signed_integer<Lhs> lhs, Rhs rhs ) {
 		using lhs_t = sint_impl::signed_integer_type_t<Lhs>;
@@ -917,7 +1071,9 @@ namespace daw::integers {
 		return result_t( lhs.m_private.value ) <<= result_t( rhs );
 	}
 
-	template<typename Lhs, std::size_t Rhs>
+	template<typename Lhs, std::size_t Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Lhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator<<( Lhs lhs, signed_integer<Rhs> rhs ) {
 		using lhs_t = Lhs;
@@ -936,7 +1092,9 @@ namespace daw::integers {
 		return result_t( lhs.m_private.value ) >>= result_t( rhs.value( ) );
 	}
 
-	template<std::size_t Lhs, typename Rhs>
+	template<std::size_t Lhs, typename Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Rhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator>>( signed_integer<Lhs> lhs, Rhs rhs ) {
 		using lhs_t = sint_impl::signed_integer_type_t<Lhs>;
@@ -945,7 +1103,9 @@ namespace daw::integers {
 		return result_t( lhs.m_private.value ) >>= result_t( rhs );
 	}
 
-	template<typename Lhs, std::size_t Rhs>
+	template<typename Lhs, std::size_t Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Lhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator>>( Lhs lhs, signed_integer<Rhs> rhs ) {
 		using lhs_t = Lhs;
@@ -964,7 +1124,9 @@ namespace daw::integers {
 		return result_t( lhs.m_private.value ) |= result_t( rhs.value( ) );
 	}
 
-	template<std::size_t Lhs, typename Rhs>
+	template<std::size_t Lhs, typename Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Rhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator|( signed_integer<Lhs> lhs, Rhs rhs ) {
 		using lhs_t = sint_impl::signed_integer_type_t<Lhs>;
@@ -973,7 +1135,9 @@ namespace daw::integers {
 		return result_t( lhs.m_private.value ) |= result_t( rhs );
 	}
 
-	template<typename Lhs, std::size_t Rhs>
+	template<typename Lhs, std::size_t Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Lhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator|( Lhs lhs, signed_integer<Rhs> rhs ) {
 		using lhs_t = Lhs;
@@ -992,7 +1156,9 @@ namespace daw::integers {
 		return result_t( lhs.m_private.value ) &= result_t( rhs.value( ) );
 	}
 
-	template<std::size_t Lhs, typename Rhs>
+	template<std::size_t Lhs, typename Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Rhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator&( signed_integer<Lhs> lhs, Rhs rhs ) {
 		using lhs_t = sint_impl::signed_integer_type_t<Lhs>;
@@ -1001,7 +1167,9 @@ namespace daw::integers {
 		return result_t( lhs.m_private.value ) &= result_t( rhs );
 	}
 
-	template<typename Lhs, std::size_t Rhs>
+	template<typename Lhs, std::size_t Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Lhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator&( Lhs lhs, signed_integer<Rhs> rhs ) {
 		using lhs_t = Lhs;
@@ -1020,7 +1188,9 @@ namespace daw::integers {
 		return result_t( lhs.m_private.value ) ^= result_t( rhs.value( ) );
 	}
 
-	template<std::size_t Lhs, typename Rhs>
+	template<std::size_t Lhs, typename Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Rhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator^( signed_integer<Lhs> lhs, Rhs rhs ) {
 		using lhs_t = sint_impl::signed_integer_type_t<Lhs>;
@@ -1029,7 +1199,9 @@ namespace daw::integers {
 		return result_t( lhs.m_private.value ) ^= result_t( rhs );
 	}
 
-	template<typename Lhs, std::size_t Rhs>
+	template<typename Lhs, std::size_t Rhs,
+	         std::enable_if_t<sint_impl::is_signed_integral_v<Lhs>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 	operator^( Lhs lhs, signed_integer<Rhs> rhs ) {
 		using lhs_t = Lhs;
@@ -0,0 +1,179 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+
+namespace daw::integers::sint_impl {
+	/// The common type of a signed_integer and a signed integral type, none
+	/// for other types
+	template<std::size_t Bits, typename I, typename = void>
+	struct signed_common_type {};
+
+	template<std::size_t Bits, typename I>
+	struct signed_common_type<Bits, I,
+	                          std::enable_if_t<is_signed_integral_v<I>>> {
+		using type =
+		  signed_integer<( Bits >= sizeof( I ) * 8 ? Bits : sizeof( I ) * 8 )>;
+	};
+} // namespace daw::integers::sint_impl
+
+namespace std {
+	template<std::size_t LhsBits, std::size_t RhsBits>
+	struct common_type<daw::integers::signed_integer<LhsBits>,
+	                   daw::integers::signed_integer<RhsBits>> {
+		using type = daw::integers::signed_integer<( LhsBits >= RhsBits )
+		                                             ? LhsBits
+		                                             : RhsBits>;
+	};
+
+	template<std::size_t Bits, typename I>
+	struct common_type<daw::integers::signed_integer<Bits>, I>
+	  : daw::integers::sint_impl::signed_common_type<Bits, I> {};
+
+	template<typename I, std::size_t Bits>
+	struct common_type<I, daw::integers::signed_integer<Bits>>
+	  : daw::integers::sint_impl::signed_common_type<Bits, I> {};
+
+	namespace chrono {
+		template<std::size_t Bits>
+		struct treat_as_floating_point<daw::integers::signed_integer<Bits>>
+		  : std::false_type {};
+
+		template<std::size_t Bits>
+		struct duration_values<daw::integers::signed_integer<Bits>> {
+			[[nodiscard]] static constexpr daw::integers::signed_integer<Bits>
+			zero( ) noexcept {
+				return daw::integers::signed_integer<Bits>( 0 );
+			}
+
+			[[nodiscard]] static constexpr daw::integers::signed_integer<Bits>
+			min( ) noexcept {
+				return daw::integers::signed_integer<Bits>::min( );
+			}
+
+			[[nodiscard]] static constexpr daw::integers::signed_integer<Bits>
+			max( ) noexcept {
+				return daw::integers::signed_integer<Bits>::max( );
+			}
+		};
+	} // namespace chrono
+} // namespace std
+
+namespace daw::integers {
+	namespace sint_impl {
+		template<typename Rep>
+		struct chrono_raw_rep {
+			static_assert( is_signed_integral_v<Rep>,
+			               "checked_duration_cast requires a signed integer Rep" );
+			using type = Rep;
+		};
+
+		template<std::size_t Bits>
+		struct chrono_raw_rep<signed_integer<Bits>> {
+			using type = signed_integer_type_t<Bits>;
+		};
+
+		template<typename Rep>
+		using chrono_raw_rep_t = typename chrono_raw_rep<Rep>::type;
+
+		template<typename Rep>
+		DAW_ATTRIB_INLINE constexpr chrono_raw_rep_t<Rep>
+		chrono_raw_value( Rep const &r ) noexcept {
+			if constexpr( std::is_integral_v<Rep> ) {
+				return r;
+			} else {
+				return r.value( );
+			}
+		}
+	} // namespace sint_impl
+
+	/// @brief std::chrono::duration_cast that reports overflow.  The
+	/// conversion factor is a compile time ratio: a whole multiplier becomes
+	/// a compare against the constant limit / multiplier followed by a
+	/// multiply that cannot overflow, and a whole divisor is a division by a
+	/// constant.  No runtime division is needed to detect overflow.  Values
+	/// are truncated toward zero like duration_cast.  An unrepresentable
+	/// result is reported via on_signed_integer_overflow and the result is
+	/// saturated.
+	/// @tparam ToDuration A std::chrono::duration with a signed integral or
+	/// signed_integer Rep
+	template<typename ToDuration, typename Rep, typename Period>
+	[[nodiscard]] constexpr ToDuration
+	checked_duration_cast( std::chrono::duration<Rep, Period> const &d ) {
+		using to_rep = typename ToDuration::rep;
+		using from_raw = sint_impl::chrono_raw_rep_t<Rep>;
+		using to_raw = sint_impl::chrono_raw_rep_t<to_rep>;
+		using ratio = std::ratio_divide<Period, typename ToDuration::period>;
+
+		constexpr auto num = static_cast<std::int64_t>( ratio::num );
+		constexpr auto den = static_cast<std::int64_t>( ratio::den );
+		constexpr auto to_max =
+		  static_cast<std::int64_t>( daw::numeric_limits<to_raw>::max( ) );
+		constexpr auto to_min =
+		  static_cast<std::int64_t>( daw::numeric_limits<to_raw>::min( ) );
+		auto const count =
+		  static_cast<std::int64_t>( sint_impl::chrono_raw_value( d.count( ) ) );
+		static_assert( sizeof( from_raw ) <= sizeof( std::int64_t ) );
+		auto const saturated = [&] {
+			on_signed_integer_overflow( );
+			return ToDuration(
+			  to_rep( count > 0 ? daw::numeric_limits<to_raw>::max( )
+			                    : daw::numeric_limits<to_raw>::min( ) ) );
+		};
+		auto result = count;
+		if constexpr( den == 1 ) {
+			// Whole multiplier, the limits of count are constants
+			if( DAW_UNLIKELY( count > to_max / num or count < to_min / num ) ) {
+				DAW_UNLIKELY_BRANCH
+				return saturated( );
+			}
+			result *= num;
+		} else {
+			if constexpr( num != 1 ) {
+				// count * num can overflow when the result fits.  Split count by
+				// den so that only the whole part is scaled by num:
+				// count * num / den == q * num + r * num / den, and both terms
+				// truncate toward zero the same way as they share a sign
+				constexpr auto i64_max = daw::numeric_limits<std::int64_t>::max( );
+				static_assert( num <= i64_max / den,
+				               "The conversion ratio is too large" );
+				auto const q = count / den;
+				auto const r = count % den;
+				auto whole = std::int64_t{ };
+				if( DAW_UNLIKELY(
+				      sint_impl::wrapping_mul( q, num, whole ) or
+				      sint_impl::wrapping_add( whole, r * num / den, result ) ) ) {
+					DAW_UNLIKELY_BRANCH
+					return saturated( );
+				}
+			} else {
+				result /= den;
+			}
+			if constexpr( sizeof( to_raw ) < sizeof( std::int64_t ) or num != 1 ) {
+				if( DAW_UNLIKELY( result > to_max or result < to_min ) ) {
+					DAW_UNLIKELY_BRANCH
+					return saturated( );
+				}
+			}
+		}
+		return ToDuration( to_rep( static_cast<to_raw>( result ) ) );
+	}
+} // namespace daw::integers
@@ -0,0 +1,342 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_int_cmp.h>
+#include <daw/daw_likely.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/// The rounding divisions here come in two forms.  With a runtime divisor the
+/// quotient and remainder of one truncating division are corrected with a
+/// compare and a mask instead of a branch.  A divisor given as a template
+/// argument that is a positive power of two becomes a shift and a mask; any
+/// other constant is left to the compiler's division by a constant.
+///
+/// A zero divisor is reported via on_signed_integer_div_by_zero and the
+/// dividend is returned.  min( ) / -1 is reported via
+/// on_signed_integer_overflow and min( ), the wrapped quotient, is returned;
+/// its Euclidean remainder is 0 and is not an error.
+
+namespace daw::integers {
+	namespace sint_impl {
+		/// @brief A zero divisor or min( ) / -1, the divisions that are undefined
+		/// for the built in types
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr bool div_is_exceptional( T lhs,
+		                                                     T rhs ) noexcept {
+			return ( rhs == 0 ) |
+			       ( ( lhs == daw::numeric_limits<T>::min( ) ) & ( rhs == T{ -1 } ) );
+		}
+
+		template<typename T>
+		constexpr T div_exceptional( T lhs, T rhs, bool is_remainder ) {
+			if( rhs == 0 ) {
+				on_signed_integer_div_by_zero( );
+				return lhs;
+			}
+			if( is_remainder ) {
+				return T{ 0 };
+			}
+			on_signed_integer_overflow( );
+			return lhs;
+		}
+
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr T div_floor( T lhs, T rhs ) {
+			if( DAW_UNLIKELY( div_is_exceptional( lhs, rhs ) ) ) {
+				DAW_UNLIKELY_BRANCH
+				return div_exceptional( lhs, rhs, false );
+			}
+			auto const q = static_cast<T>( lhs / rhs );
+			auto const r = static_cast<T>( lhs % rhs );
+			// Truncation rounded up when the remainder and divisor differ in sign
+			auto const adjust = static_cast<T>( ( r != 0 ) & ( ( r ^ rhs ) < 0 ) );
+			return static_cast<T>( q - adjust );
+		}
+
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr T div_ceil( T lhs, T rhs ) {
+			if( DAW_UNLIKELY( div_is_exceptional( lhs, rhs ) ) ) {
+				DAW_UNLIKELY_BRANCH
+				return div_exceptional( lhs, rhs, false );
+			}
+			auto const q = static_cast<T>( lhs / rhs );
+			auto const r = static_cast<T>( lhs % rhs );
+			// Truncation rounded down when the remainder and divisor share a sign
+			auto const adjust = static_cast<T>( ( r != 0 ) & ( ( r ^ rhs ) >= 0 ) );
+			return static_cast<T>( q + adjust );
+		}
+
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr T div_euclid( T lhs, T rhs ) {
+			if( DAW_UNLIKELY( div_is_exceptional( lhs, rhs ) ) ) {
+				DAW_UNLIKELY_BRANCH
+				return div_exceptional( lhs, rhs, false );
+			}
+			auto const q = static_cast<T>( lhs / rhs );
+			auto const r = static_cast<T>( lhs % rhs );
+			// A negative remainder moves the quotient one step away from the sign
+			// of the divisor
+			auto const step = static_cast<T>( ( rhs > 0 ) - ( rhs < 0 ) );
+			return static_cast<T>( q - static_cast<T>( r < 0 ) * step );
+		}
+
+		/// @brief The remainder of a truncating division moved into [0, |rhs|).
+		/// Adding |rhs| is done in unsigned arithmetic as |min( )| is not
+		/// representable
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr T rem_euclid_adjust( T r, T rhs ) noexcept {
+			using unsigned_t = std::make_unsigned_t<T>;
+			auto const abs_rhs =
+			  rhs < 0 ? static_cast<unsigned_t>( unsigned_t{ 0 } -
+			                                     static_cast<unsigned_t>( rhs ) )
+			          : static_cast<unsigned_t>( rhs );
+			auto const mask =
+			  static_cast<unsigned_t>( unsigned_t{ 0 } - unsigned_t( r < 0 ) );
+			return static_cast<T>( static_cast<unsigned_t>(
+			  static_cast<unsigned_t>( r ) + ( abs_rhs & mask ) ) );
+		}
+
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr T rem_euclid( T lhs, T rhs ) {
+			if( DAW_UNLIKELY( div_is_exceptional( lhs, rhs ) ) ) {
+				DAW_UNLIKELY_BRANCH
+				return div_exceptional( lhs, rhs, true );
+			}
+			return rem_euclid_adjust( static_cast<T>( lhs % rhs ), rhs );
+		}
+
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr bool check_alignment( T alignment ) {
+			if( DAW_UNLIKELY( alignment <= 0 ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				return false;
+			}
+			return true;
+		}
+
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr T align_down( T value, T alignment ) {
+			if( not check_alignment( alignment ) ) {
+				return value;
+			}
+			auto const r = rem_euclid_adjust( static_cast<T>( value % alignment ),
+			                                  alignment );
+			return checked_sub( value, r );
+		}
+
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr T align_up( T value, T alignment ) {
+			if( not check_alignment( alignment ) ) {
+				return value;
+			}
+			auto const r = rem_euclid_adjust( static_cast<T>( value % alignment ),
+			                                  alignment );
+			// alignment - r, or 0 when value is already aligned
+			auto const delta = static_cast<T>(
+			  static_cast<T>( alignment - r ) & static_cast<T>( -T( r != 0 ) ) );
+			return checked_add( value, delta );
+		}
+
+		/// @brief A divisor or alignment given as a template argument, checked to
+		/// be a nonzero value of the type
+		template<auto Divisor, std::size_t Bits>
+		DAW_ATTRIB_INLINE constexpr signed_integer_type_t<Bits>
+		constant_divisor( ) noexcept {
+			using raw_t = signed_integer_type_t<Bits>;
+			static_assert( std::is_integral_v<decltype( Divisor )> );
+			static_assert( Divisor != 0, "Division by zero" );
+			// Compared by value, so that unsigned divisors such as 4096u work
+			static_assert( daw::in_range<raw_t>( Divisor ),
+			               "Divisor is not representable in the dividend type" );
+			return static_cast<raw_t>( Divisor );
+		}
+
+		template<auto Divisor>
+		inline constexpr bool is_positive_pow2_v =
+		  Divisor > 0 and ( Divisor & ( Divisor - 1 ) ) == 0;
+
+		/// log2 of a positive power of two
+		template<auto Divisor>
+		inline constexpr unsigned pow2_shift_v = [] {
+			unsigned result = 0;
+			for( auto d = Divisor; d > 1; d /= 2 ) {
+				++result;
+			}
+			return result;
+		}( );
+	} // namespace sint_impl
+
+	/// @brief lhs / rhs rounded toward negative infinity
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer<Bits>
+	div_floor( signed_integer<Bits> lhs, signed_integer<Bits> rhs ) {
+		return signed_integer<Bits>::conversion_unchecked(
+		  sint_impl::div_floor( lhs.value( ), rhs.value( ) ) );
+	}
+
+	/// @brief lhs / rhs rounded toward positive infinity
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer<Bits>
+	div_ceil( signed_integer<Bits> lhs, signed_integer<Bits> rhs ) {
+		return signed_integer<Bits>::conversion_unchecked(
+		  sint_impl::div_ceil( lhs.value( ), rhs.value( ) ) );
+	}
+
+	/// @brief The Euclidean quotient q, lhs == q * rhs + rem_euclid( lhs, rhs )
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer<Bits>
+	div_euclid( signed_integer<Bits> lhs, signed_integer<Bits> rhs ) {
+		return signed_integer<Bits>::conversion_unchecked(
+		  sint_impl::div_euclid( lhs.value( ), rhs.value( ) ) );
+	}
+
+	/// @brief The Euclidean remainder of lhs / rhs, in [0, |rhs|)
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer<Bits>
+	rem_euclid( signed_integer<Bits> lhs, signed_integer<Bits> rhs ) {
+		return signed_integer<Bits>::conversion_unchecked(
+		  sint_impl::rem_euclid( lhs.value( ), rhs.value( ) ) );
+	}
+
+	/// @brief The largest multiple of alignment not greater than value.  A
+	/// non-positive alignment is reported via on_signed_integer_out_of_range
+	/// and value is returned; a result below min( ) is reported via
+	/// on_signed_integer_overflow
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer<Bits>
+	align_down( signed_integer<Bits> value, signed_integer<Bits> alignment ) {
+		return signed_integer<Bits>::conversion_unchecked(
+		  sint_impl::align_down( value.value( ), alignment.value( ) ) );
+	}
+
+	/// @brief The smallest multiple of alignment not less than value.  A
+	/// non-positive alignment is reported via on_signed_integer_out_of_range
+	/// and value is returned; a result above max( ) is reported via
+	/// on_signed_integer_overflow
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer<Bits>
+	align_up( signed_integer<Bits> value, signed_integer<Bits> alignment ) {
+		return signed_integer<Bits>::conversion_unchecked(
+		  sint_impl::align_up( value.value( ), alignment.value( ) ) );
+	}
+
+	/// @brief div_floor by a compile time divisor, e.g. div_floor<4096>( x ).  A
+	/// positive power of two is an arithmetic shift
+	template<auto Divisor, std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer<Bits>
+	div_floor( signed_integer<Bits> lhs ) {
+		constexpr auto d = sint_impl::constant_divisor<Divisor, Bits>( );
+		if constexpr( sint_impl::is_positive_pow2_v<d> ) {
+			return signed_integer<Bits>::conversion_unchecked(
+			  static_cast<decltype( d )>( lhs.value( ) >>
+			                              sint_impl::pow2_shift_v<d> ) );
+		} else {
+			return div_floor( lhs, signed_integer<Bits>::conversion_unchecked( d ) );
+		}
+	}
+
+	/// @brief div_ceil by a compile time divisor.  A positive power of two is a
+	/// shift plus one when any of the masked low bits are set
+	template<auto Divisor, std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer<Bits>
+	div_ceil( signed_integer<Bits> lhs ) {
+		constexpr auto d = sint_impl::constant_divisor<Divisor, Bits>( );
+		if constexpr( sint_impl::is_positive_pow2_v<d> ) {
+			using raw_t = decltype( d );
+			auto const v = lhs.value( );
+			return signed_integer<Bits>::conversion_unchecked( static_cast<raw_t>(
+			  ( v >> sint_impl::pow2_shift_v<d> ) +
+			  static_cast<raw_t>( ( v & static_cast<raw_t>( d - 1 ) ) != 0 ) ) );
+		} else {
+			return div_ceil( lhs, signed_integer<Bits>::conversion_unchecked( d ) );
+		}
+	}
+
+	/// @brief div_euclid by a compile time divisor.  For a positive power of
+	/// two this is the same arithmetic shift as div_floor
+	template<auto Divisor, std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer<Bits>
+	div_euclid( signed_integer<Bits> lhs ) {
+		constexpr auto d = sint_impl::constant_divisor<Divisor, Bits>( );
+		if constexpr( sint_impl::is_positive_pow2_v<d> ) {
+			return div_floor<Divisor>( lhs );
+		} else {
+			return div_euclid( lhs, signed_integer<Bits>::conversion_unchecked( d ) );
+		}
+	}
+
+	/// @brief rem_euclid by a compile time divisor.  A positive power of two is
+	/// a mask of the low bits
+	template<auto Divisor, std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer<Bits>
+	rem_euclid( signed_integer<Bits> lhs ) {
+		constexpr auto d = sint_impl::constant_divisor<Divisor, Bits>( );
+		if constexpr( sint_impl::is_positive_pow2_v<d> ) {
+			using raw_t = decltype( d );
+			return signed_integer<Bits>::conversion_unchecked(
+			  static_cast<raw_t>( lhs.value( ) & static_cast<raw_t>( d - 1 ) ) );
+		} else {
+			return rem_euclid( lhs, signed_integer<Bits>::conversion_unchecked( d ) );
+		}
+	}
+
+	/// @brief align_down to a compile time alignment.  A power of two is a mask
+	/// and cannot overflow
+	template<auto Alignment, std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer<Bits>
+	align_down( signed_integer<Bits> value ) {
+		constexpr auto a = sint_impl::constant_divisor<Alignment, Bits>( );
+		static_assert( a > 0, "Alignment must be positive" );
+		if constexpr( sint_impl::is_positive_pow2_v<a> ) {
+			using raw_t = decltype( a );
+			return signed_integer<Bits>::conversion_unchecked(
+			  static_cast<raw_t>( value.value( ) & static_cast<raw_t>( -a ) ) );
+		} else {
+			return align_down( value,
+			                   signed_integer<Bits>::conversion_unchecked( a ) );
+		}
+	}
+
+	/// @brief align_up to a compile time alignment.  A power of two is an add
+	/// and a mask, overflow is a compare against a constant
+	template<auto Alignment, std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr signed_integer<Bits>
+	align_up( signed_integer<Bits> value ) {
+		constexpr auto a = sint_impl::constant_divisor<Alignment, Bits>( );
+		static_assert( a > 0, "Alignment must be positive" );
+		if constexpr( sint_impl::is_positive_pow2_v<a> ) {
+			using raw_t = decltype( a );
+			using unsigned_t = std::make_unsigned_t<raw_t>;
+			constexpr auto mask = static_cast<raw_t>( -a );
+			constexpr auto limit =
+			  static_cast<raw_t>( daw::numeric_limits<raw_t>::max( ) & mask );
+			auto const v = value.value( );
+			if( DAW_UNLIKELY( v > limit ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_overflow( );
+			}
+			// Unsigned so that the add wraps instead of overflowing
+			return signed_integer<Bits>::conversion_unchecked( static_cast<raw_t>(
+			  static_cast<unsigned_t>( static_cast<unsigned_t>( v ) +
+			                           static_cast<unsigned_t>( a - 1 ) ) &
+			  static_cast<unsigned_t>( mask ) ) );
+		} else {
+			return align_up( value, signed_integer<Bits>::conversion_unchecked( a ) );
+		}
+	}
+} // namespace daw::integers
@@ -0,0 +1,382 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+#include "impl/daw_signed_simd.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+/// The set operations in this header require each input to be sorted in
+/// ascending order without duplicates, e.g. posting lists of document ids.
+namespace daw::integers {
+	/// @brief When one input is at least this many times larger than the other,
+	/// intersect_sorted switches to galloping_intersect
+	inline constexpr std::size_t galloping_intersect_ratio = 32;
+
+	namespace sint_impl {
+		/// @brief Number of elements a set operation may write, using checked
+		/// arithmetic so that hostile sizes are reported rather than wrapping
+		DAW_ATTRIB_INLINE std::size_t set_union_size( std::size_t lhs_size,
+		                                              std::size_t rhs_size ) {
+			return static_cast<std::size_t>(
+			  i64( lhs_size ).add_checked( i64( rhs_size ) ).value( ) );
+		}
+
+		template<typename T>
+		DAW_ATTRIB_INLINE std::size_t
+		intersect_scalar( T const *lhs, std::size_t lhs_size, T const *rhs,
+		                  std::size_t rhs_size, T *out, std::size_t l,
+		                  std::size_t r, std::size_t count ) noexcept {
+			// Branch free merge, the comparisons are unpredictable
+			while( l < lhs_size and r < rhs_size ) {
+				auto const a = lhs[l];
+				auto const b = rhs[r];
+				out[count] = a;
+				count += static_cast<std::size_t>( a == b );
+				l += static_cast<std::size_t>( a <= b );
+				r += static_cast<std::size_t>( b <= a );
+			}
+			return count;
+		}
+
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+		/// @brief permutevar8x32 control that moves the 32bit lanes set in the
+		/// mask to the front
+		inline constexpr auto compress_epi32_table = [] {
+			auto result = std::array<std::array<std::uint32_t, 8>, 256>{ };
+			for( std::size_t mask = 0; mask < 256; ++mask ) {
+				std::size_t pos = 0;
+				for( std::uint32_t lane = 0; lane < 8; ++lane ) {
+					if( mask & ( 1U << lane ) ) {
+						result[mask][pos++] = lane;
+					}
+				}
+			}
+			return result;
+		}( );
+
+		/// @brief permutevar8x32 control that moves the 64bit lanes set in the
+		/// mask to the front
+		inline constexpr auto compress_epi64_table = [] {
+			auto result = std::array<std::array<std::uint32_t, 8>, 16>{ };
+			for( std::size_t mask = 0; mask < 16; ++mask ) {
+				std::size_t pos = 0;
+				for( std::uint32_t lane = 0; lane < 4; ++lane ) {
+					if( mask & ( 1U << lane ) ) {
+						result[mask][pos++] = lane * 2;
+						result[mask][pos++] = lane * 2 + 1;
+					}
+				}
+			}
+			return result;
+		}( );
+
+		/// @brief Store the packed matches, going through a temporary when the
+		/// full vector would not fit in out
+		template<typename T>
+		DAW_ATTRIB_INLINE void store_matches( T *out, std::size_t out_size,
+		                                      std::size_t count, __m256i packed,
+		                                      std::size_t matches ) noexcept {
+			if( DAW_LIKELY( count + 32 / sizeof( T ) <= out_size ) ) {
+				_mm256_storeu_si256( reinterpret_cast<__m256i *>( out + count ),
+				                     packed );
+			} else {
+				alignas( 32 ) T tmp[32 / sizeof( T )];
+				_mm256_store_si256( reinterpret_cast<__m256i *>( tmp ), packed );
+				std::memcpy( out + count, tmp, matches * sizeof( T ) );
+			}
+		}
+
+		/// @brief Block intersection.  Each block of lhs is compared against
+		/// every rotation of the current block of rhs, the matching lanes are
+		/// compressed with a shuffle, and the block with the smaller maximum is
+		/// advanced
+		DAW_ATTRIB_INLINE std::size_t
+		intersect_simd( std::int32_t const *lhs, std::size_t lhs_size,
+		                std::int32_t const *rhs, std::size_t rhs_size,
+		                std::int32_t *out, std::size_t out_size, std::size_t &l,
+		                std::size_t &r ) noexcept {
+			std::size_t count = 0;
+			auto const rot1 = _mm256_setr_epi32( 1, 2, 3, 4, 5, 6, 7, 0 );
+			while( l + 8 <= lhs_size and r + 8 <= rhs_size ) {
+				auto const va =
+				  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( lhs + l ) );
+				auto vb =
+				  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( rhs + r ) );
+				auto eq = _mm256_cmpeq_epi32( va, vb );
+				for( int n = 1; n < 8; ++n ) {
+					vb = _mm256_permutevar8x32_epi32( vb, rot1 );
+					eq = _mm256_or_si256( eq, _mm256_cmpeq_epi32( va, vb ) );
+				}
+				auto const mask = static_cast<unsigned>(
+				  _mm256_movemask_ps( _mm256_castsi256_ps( eq ) ) );
+				auto const ctrl = _mm256_loadu_si256( reinterpret_cast<__m256i const *>(
+				  compress_epi32_table[mask].data( ) ) );
+				auto const matches = popcount( mask );
+				store_matches( out, out_size, count,
+				               _mm256_permutevar8x32_epi32( va, ctrl ), matches );
+				count += matches;
+				auto const a_max = lhs[l + 7];
+				auto const b_max = rhs[r + 7];
+				l += static_cast<std::size_t>( a_max <= b_max ) * 8;
+				r += static_cast<std::size_t>( b_max <= a_max ) * 8;
+			}
+			return count;
+		}
+
+		DAW_ATTRIB_INLINE std::size_t
+		intersect_simd( std::int64_t const *lhs, std::size_t lhs_size,
+		                std::int64_t const *rhs, std::size_t rhs_size,
+		                std::int64_t *out, std::size_t out_size, std::size_t &l,
+		                std::size_t &r ) noexcept {
+			std::size_t count = 0;
+			while( l + 4 <= lhs_size and r + 4 <= rhs_size ) {
+				auto const va =
+				  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( lhs + l ) );
+				auto vb =
+				  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( rhs + r ) );
+				auto eq = _mm256_cmpeq_epi64( va, vb );
+				for( int n = 1; n < 4; ++n ) {
+					vb = _mm256_permute4x64_epi64( vb, 0x39 );
+					eq = _mm256_or_si256( eq, _mm256_cmpeq_epi64( va, vb ) );
+				}
+				auto const mask = static_cast<unsigned>(
+				  _mm256_movemask_pd( _mm256_castsi256_pd( eq ) ) );
+				auto const ctrl = _mm256_loadu_si256( reinterpret_cast<__m256i const *>(
+				  compress_epi64_table[mask].data( ) ) );
+				auto const matches = popcount( mask );
+				store_matches( out, out_size, count,
+				               _mm256_permutevar8x32_epi32( va, ctrl ), matches );
+				count += matches;
+				auto const a_max = lhs[l + 3];
+				auto const b_max = rhs[r + 3];
+				l += static_cast<std::size_t>( a_max <= b_max ) * 4;
+				r += static_cast<std::size_t>( b_max <= a_max ) * 4;
+			}
+			return count;
+		}
+#endif
+
+		/// @brief First position in [first, size) whose value is not less than
+		/// value, found by doubling the step from first then binary searching
+		template<typename T>
+		DAW_ATTRIB_INLINE std::size_t gallop_lower_bound( T const *values,
+		                                                  std::size_t first,
+		                                                  std::size_t size,
+		                                                  T value ) noexcept {
+			std::size_t step = 1;
+			std::size_t last = first;
+			while( last < size and values[last] < value ) {
+				first = last + 1;
+				last += step;
+				step *= 2;
+			}
+			if( last > size ) {
+				last = size;
+			}
+			// Branch free binary search in [first, last)
+			auto len = last - first;
+			while( len > 0 ) {
+				auto const half = len / 2;
+				auto const lt = values[first + half] < value;
+				first += static_cast<std::size_t>( lt ) * ( half + 1 );
+				len = lt ? len - half - 1 : half;
+			}
+			return first;
+		}
+
+		template<typename T>
+		DAW_ATTRIB_INLINE std::size_t
+		galloping_intersect( T const *small, std::size_t small_size, T const *large,
+		                     std::size_t large_size, T *out ) noexcept {
+			std::size_t count = 0;
+			std::size_t pos = 0;
+			for( std::size_t n = 0; n < small_size; ++n ) {
+				auto const value = small[n];
+				pos = gallop_lower_bound( large, pos, large_size, value );
+				if( pos == large_size ) {
+					break;
+				}
+				out[count] = value;
+				count += static_cast<std::size_t>( large[pos] == value );
+			}
+			return count;
+		}
+
+		template<typename T>
+		DAW_ATTRIB_INLINE std::size_t
+		intersect_sorted( T const *lhs, std::size_t lhs_size, T const *rhs,
+		                  std::size_t rhs_size, T *out ) noexcept {
+			if( lhs_size / galloping_intersect_ratio > rhs_size ) {
+				return galloping_intersect( rhs, rhs_size, lhs, lhs_size, out );
+			}
+			if( rhs_size / galloping_intersect_ratio > lhs_size ) {
+				return galloping_intersect( lhs, lhs_size, rhs, rhs_size, out );
+			}
+			std::size_t l = 0;
+			std::size_t r = 0;
+			std::size_t count = 0;
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+			if constexpr( sizeof( T ) >= 4 ) {
+				count = intersect_simd( lhs, lhs_size, rhs, rhs_size, out,
+				                        ( std::min )( lhs_size, rhs_size ), l, r );
+			}
+#endif
+			return intersect_scalar( lhs, lhs_size, rhs, rhs_size, out, l, r,
+			                         count );
+		}
+
+		template<typename T>
+		DAW_ATTRIB_INLINE std::size_t union_sorted( T const *lhs,
+		                                            std::size_t lhs_size,
+		                                            T const *rhs,
+		                                            std::size_t rhs_size,
+		                                            T *out ) noexcept {
+			std::size_t l = 0;
+			std::size_t r = 0;
+			std::size_t count = 0;
+			// Branch free merge, equal values are written once
+			while( l < lhs_size and r < rhs_size ) {
+				auto const a = lhs[l];
+				auto const b = rhs[r];
+				out[count++] = a < b ? a : b;
+				l += static_cast<std::size_t>( a <= b );
+				r += static_cast<std::size_t>( b <= a );
+			}
+			if( l < lhs_size ) {
+				std::memcpy( out + count, lhs + l, ( lhs_size - l ) * sizeof( T ) );
+				count += lhs_size - l;
+			} else if( r < rhs_size ) {
+				std::memcpy( out + count, rhs + r, ( rhs_size - r ) * sizeof( T ) );
+				count += rhs_size - r;
+			}
+			return count;
+		}
+
+		template<typename Range>
+		inline constexpr bool is_signed_integer_range_v = [] {
+			if constexpr( is_contiguous_range_v<Range> ) {
+				return is_signed_integer_v<range_value_t<Range>>;
+			} else {
+				return false;
+			}
+		}( );
+	} // namespace sint_impl
+
+	/// @brief Write the values found in both lhs and rhs to out, in ascending
+	/// order.  Vector block compares are used for i32/i64 when AVX2 is
+	/// available and galloping_intersect is used when the sizes are skewed.
+	/// out must have room for the smaller of the two inputs, otherwise
+	/// on_signed_integer_out_of_range is called and nothing is written
+	/// @return The number of elements written to out
+	template<std::size_t Bits>
+	std::size_t intersect_sorted( signed_integer<Bits> const *lhs,
+	                              std::size_t lhs_size,
+	                              signed_integer<Bits> const *rhs,
+	                              std::size_t rhs_size, signed_integer<Bits> *out,
+	                              std::size_t out_size ) {
+		if( DAW_UNLIKELY( out_size < ( std::min )( lhs_size, rhs_size ) ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			return 0;
+		}
+		return sint_impl::intersect_sorted( sint_impl::raw_ptr( lhs ), lhs_size,
+		                                    sint_impl::raw_ptr( rhs ), rhs_size,
+		                                    sint_impl::raw_ptr( out ) );
+	}
+
+	template<typename Lhs, typename Rhs, typename Out,
+	         std::enable_if_t<sint_impl::is_signed_integer_range_v<Lhs const> and
+	                            sint_impl::is_signed_integer_range_v<Rhs const> and
+	                            sint_impl::is_signed_integer_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	std::size_t intersect_sorted( Lhs const &lhs, Rhs const &rhs, Out &&out ) {
+		return intersect_sorted( std::data( lhs ), std::size( lhs ),
+		                         std::data( rhs ), std::size( rhs ),
+		                         std::data( out ), std::size( out ) );
+	}
+
+	/// @brief Intersect a small set with a much larger one by exponential
+	/// search in large for each element of small.  This is O(small *
+	/// log(large / small)).  out must have room for small_size elements,
+	/// otherwise on_signed_integer_out_of_range is called and nothing is written
+	/// @return The number of elements written to out
+	template<std::size_t Bits>
+	std::size_t galloping_intersect( signed_integer<Bits> const *small,
+	                                 std::size_t small_size,
+	                                 signed_integer<Bits> const *large,
+	                                 std::size_t large_size,
+	                                 signed_integer<Bits> *out,
+	                                 std::size_t out_size ) {
+		if( DAW_UNLIKELY( out_size < ( std::min )( small_size, large_size ) ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			return 0;
+		}
+		return sint_impl::galloping_intersect(
+		  sint_impl::raw_ptr( small ), small_size, sint_impl::raw_ptr( large ),
+		  large_size, sint_impl::raw_ptr( out ) );
+	}
+
+	template<typename Small, typename Large, typename Out,
+	         std::enable_if_t<sint_impl::is_signed_integer_range_v<Small const> and
+	                            sint_impl::is_signed_integer_range_v<Large const> and
+	                            sint_impl::is_signed_integer_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	std::size_t galloping_intersect( Small const &small, Large const &large,
+	                                 Out &&out ) {
+		return galloping_intersect( std::data( small ), std::size( small ),
+		                            std::data( large ), std::size( large ),
+		                            std::data( out ), std::size( out ) );
+	}
+
+	/// @brief Write the values found in either lhs or rhs to out, in ascending
+	/// order and without duplicates.  out must have room for lhs_size +
+	/// rhs_size elements, computed with checked arithmetic, otherwise
+	/// on_signed_integer_out_of_range is called and nothing is written
+	/// @return The number of elements written to out
+	template<std::size_t Bits>
+	std::size_t union_sorted( signed_integer<Bits> const *lhs,
+	                          std::size_t lhs_size,
+	                          signed_integer<Bits> const *rhs,
+	                          std::size_t rhs_size, signed_integer<Bits> *out,
+	                          std::size_t out_size ) {
+		if( DAW_UNLIKELY( out_size <
+		                  sint_impl::set_union_size( lhs_size, rhs_size ) ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			return 0;
+		}
+		return sint_impl::union_sorted( sint_impl::raw_ptr( lhs ), lhs_size,
+		                                sint_impl::raw_ptr( rhs ), rhs_size,
+		                                sint_impl::raw_ptr( out ) );
+	}
+
+	template<typename Lhs, typename Rhs, typename Out,
+	         std::enable_if_t<sint_impl::is_signed_integer_range_v<Lhs const> and
+	                            sint_impl::is_signed_integer_range_v<Rhs const> and
+	                            sint_impl::is_signed_integer_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	std::size_t union_sorted( Lhs const &lhs, Rhs const &rhs, Out &&out ) {
+		return union_sorted( std::data( lhs ), std::size( lhs ), std::data( rhs ),
+		                     std::size( rhs ), std::data( out ), std::size( out ) );
+	}
+} // namespace daw::integers
@@ -0,0 +1,279 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+#include "impl/daw_signed_simd.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_cxmath.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace daw::integers {
+	namespace sint_impl {
+		inline constexpr std::size_t cache_line_size = 64;
+
+		/// @brief Allocator that places the first element on a cache line
+		/// boundary so that each group of descendants in an Eytzinger tree
+		/// occupies a single line
+		template<typename T>
+		struct cache_aligned_allocator {
+			using value_type = T;
+
+			cache_aligned_allocator( ) = default;
+
+			template<typename U>
+			constexpr cache_aligned_allocator(
+			  cache_aligned_allocator<U> const & ) noexcept {}
+
+			[[nodiscard]] T *allocate( std::size_t count ) {
+				return static_cast<T *>( ::operator new(
+				  count * sizeof( T ), std::align_val_t{ cache_line_size } ) );
+			}
+
+			void deallocate( T *ptr, std::size_t ) noexcept {
+				::operator delete( ptr, std::align_val_t{ cache_line_size } );
+			}
+
+			template<typename U>
+			constexpr bool
+			operator==( cache_aligned_allocator<U> const & ) const noexcept {
+				return true;
+			}
+
+			template<typename U>
+			constexpr bool
+			operator!=( cache_aligned_allocator<U> const & ) const noexcept {
+				return false;
+			}
+		};
+
+		DAW_ATTRIB_INLINE constexpr std::size_t
+		bit_width( std::size_t value ) noexcept {
+			std::size_t result = 0;
+			for( ; value != 0; value >>= 1U ) {
+				++result;
+			}
+			return result;
+		}
+	} // namespace sint_impl
+
+	/// @brief Number of searches the batch lookups of static_search_index run in
+	/// lock step so that their cache misses overlap
+	inline constexpr std::size_t search_index_batch_width = 16;
+
+	/// @brief A read only search structure over a sorted array of
+	/// signed_integer.  The values are stored in Eytzinger(breadth first)
+	/// order, so the top of the tree is shared by all searches and stays in
+	/// cache, and each search is a fixed number of branch free steps that
+	/// prefetch the cache line holding the node's descendants several levels
+	/// ahead.  Results are positions in the sorted input.
+	template<std::size_t Bits>
+	struct static_search_index {
+		using value_type = signed_integer<Bits>;
+		using size_type = std::size_t;
+
+	private:
+		using raw_t = sint_impl::signed_integer_type_t<Bits>;
+		static constexpr std::size_t prefetch_stride =
+		  sint_impl::cache_line_size / sizeof( raw_t );
+
+		// 1 based, element 0 is unused
+		std::vector<raw_t, sint_impl::cache_aligned_allocator<raw_t>> m_tree{ };
+		std::vector<size_type> m_rank{ };
+		size_type m_depth = 0;
+
+		std::size_t build( raw_t const *sorted, std::size_t pos, std::size_t k ) {
+			if( k < m_tree.size( ) ) {
+				pos = build( sorted, pos, 2 * k );
+				m_tree[k] = sorted[pos];
+				m_rank[k] = pos++;
+				pos = build( sorted, pos, 2 * k + 1 );
+			}
+			return pos;
+		}
+
+		/// One level of the search.  Nodes past the end of the tree take the
+		/// right branch, those bits are discarded by finish
+		template<bool Upper>
+		DAW_ATTRIB_INLINE std::size_t step( std::size_t k,
+		                                    raw_t value ) const noexcept {
+			auto const n = size( );
+			auto const in_tree = k <= n;
+			sint_impl::prefetch_read( m_tree.data( ) +
+			                          ( std::min )( k * prefetch_stride, n ) );
+			auto const node = m_tree[in_tree ? k : 0];
+			bool go_right;
+			if constexpr( Upper ) {
+				go_right = node <= value;
+			} else {
+				go_right = node < value;
+			}
+			return 2 * k + static_cast<std::size_t>( go_right or not in_tree );
+		}
+
+		/// Remove the trailing right turns and the final left turn to get the
+		/// last node that compared not less than value
+		DAW_ATTRIB_INLINE size_type finish( std::size_t k ) const noexcept {
+			k >>= daw::cxmath::count_trailing_zeros( ~k ) + 1U;
+			return k == 0 ? size( ) : m_rank[k];
+		}
+
+		template<bool Upper>
+		DAW_ATTRIB_INLINE size_type search( raw_t value ) const noexcept {
+			std::size_t k = 1;
+			for( std::size_t level = 0; level < m_depth; ++level ) {
+				k = step<Upper>( k, value );
+			}
+			return finish( k );
+		}
+
+		template<bool Upper>
+		void search_batch( raw_t const *values, std::size_t count,
+		                   size_type *out ) const noexcept {
+			std::size_t first = 0;
+			for( ; first + search_index_batch_width <= count;
+			     first += search_index_batch_width ) {
+				std::size_t k[search_index_batch_width];
+				for( auto &ki : k ) {
+					ki = 1;
+				}
+				for( std::size_t level = 0; level < m_depth; ++level ) {
+					for( std::size_t n = 0; n < search_index_batch_width; ++n ) {
+						k[n] = step<Upper>( k[n], values[first + n] );
+					}
+				}
+				for( std::size_t n = 0; n < search_index_batch_width; ++n ) {
+					out[first + n] = finish( k[n] );
+				}
+			}
+			for( ; first < count; ++first ) {
+				out[first] = search<Upper>( values[first] );
+			}
+		}
+
+	public:
+		static_search_index( ) = default;
+
+		/// @brief Build the index from values sorted in ascending order.  This
+		/// is O(n)
+		static_search_index( value_type const *sorted, size_type count )
+		  : m_tree( count + 1 )
+		  , m_rank( count + 1 )
+		  , m_depth( sint_impl::bit_width( count ) ) {
+			auto const *const raw_sorted = sint_impl::raw_ptr( sorted );
+			assert( std::is_sorted( raw_sorted, raw_sorted + count ) );
+			(void)build( raw_sorted, 0, 1 );
+		}
+
+		template<typename Range,
+		         std::enable_if_t<
+		           sint_impl::is_contiguous_range_v<Range const> and
+		             std::is_same_v<sint_impl::range_value_t<Range const>,
+		                            value_type>,
+		           std::nullptr_t> = nullptr>
+		explicit static_search_index( Range const &sorted )
+		  : static_search_index( std::data( sorted ), std::size( sorted ) ) {}
+
+		[[nodiscard]] size_type size( ) const noexcept {
+			return m_tree.empty( ) ? 0 : m_tree.size( ) - 1;
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return size( ) == 0;
+		}
+
+		/// @brief Position in the sorted input of the first value not less than
+		/// value, or size( ) when there is none
+		[[nodiscard]] size_type lower_bound( value_type value ) const noexcept {
+			return search<false>( value.value( ) );
+		}
+
+		/// @brief Position in the sorted input of the first value greater than
+		/// value, or size( ) when there is none
+		[[nodiscard]] size_type upper_bound( value_type value ) const noexcept {
+			return search<true>( value.value( ) );
+		}
+
+		[[nodiscard]] bool contains( value_type value ) const noexcept {
+			std::size_t k = 1;
+			for( std::size_t level = 0; level < m_depth; ++level ) {
+				k = step<false>( k, value.value( ) );
+			}
+			k >>= daw::cxmath::count_trailing_zeros( ~k ) + 1U;
+			return k != 0 and m_tree[k] == value.value( );
+		}
+
+		/// @brief lower_bound for each of count values, written to out.  Groups
+		/// of search_index_batch_width searches are interleaved to hide memory
+		/// latency
+		void lower_bound( value_type const *values, std::size_t count,
+		                  size_type *out ) const noexcept {
+			search_batch<false>( sint_impl::raw_ptr( values ), count, out );
+		}
+
+		/// @brief upper_bound for each of count values, written to out.  Groups
+		/// of search_index_batch_width searches are interleaved to hide memory
+		/// latency
+		void upper_bound( value_type const *values, std::size_t count,
+		                  size_type *out ) const noexcept {
+			search_batch<true>( sint_impl::raw_ptr( values ), count, out );
+		}
+
+		/// @brief Batch lower_bound over ranges.  An out range smaller than
+		/// values is reported via on_signed_integer_out_of_range and only the
+		/// results that fit are written
+		template<typename Values, typename Out,
+		         std::enable_if_t<sint_impl::is_contiguous_range_v<Values const> and
+		                            sint_impl::is_contiguous_range_v<Out>,
+		                          std::nullptr_t> = nullptr>
+		void lower_bound( Values const &values, Out &&out ) const {
+			auto count = static_cast<std::size_t>( std::size( values ) );
+			if( DAW_UNLIKELY( std::size( out ) < count ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				count = static_cast<std::size_t>( std::size( out ) );
+			}
+			lower_bound( std::data( values ), count, std::data( out ) );
+		}
+
+		/// @brief Batch upper_bound over ranges.  An out range smaller than
+		/// values is reported via on_signed_integer_out_of_range and only the
+		/// results that fit are written
+		template<typename Values, typename Out,
+		         std::enable_if_t<sint_impl::is_contiguous_range_v<Values const> and
+		                            sint_impl::is_contiguous_range_v<Out>,
+		                          std::nullptr_t> = nullptr>
+		void upper_bound( Values const &values, Out &&out ) const {
+			auto count = static_cast<std::size_t>( std::size( values ) );
+			if( DAW_UNLIKELY( std::size( out ) < count ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				count = static_cast<std::size_t>( std::size( out ) );
+			}
+			upper_bound( std::data( values ), count, std::data( out ) );
+		}
+	};
+
+	template<typename Range,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<Range const>,
+	                          std::nullptr_t> = nullptr>
+	static_search_index( Range const & ) -> static_search_index<
+	  sizeof( sint_impl::range_value_t<Range const> ) * 8>;
+} // namespace daw::integers
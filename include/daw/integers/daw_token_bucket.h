@@ -0,0 +1,172 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+namespace daw::integers {
+	/// @brief A lock free token bucket rate limiter.  The token count is an
+	/// atomic i64 that refills at a fixed rate up to a capacity.  Refills
+	/// are computed exactly and capped at the capacity, so a long idle period
+	/// or a large rate fills the bucket rather than wrapping the count, and
+	/// consumption is a checked subtract in a CAS loop that never takes the
+	/// count below zero.
+	/// @tparam Clock A monotonic clock used to measure elapsed time
+	template<typename Clock = std::chrono::steady_clock>
+	struct token_bucket {
+		using clock_type = Clock;
+		using time_point = typename Clock::time_point;
+
+	private:
+		static_assert( Clock::is_steady, "Clock must be monotonic" );
+		static_assert( std::is_trivially_copyable_v<i64> );
+
+		static constexpr i64 ns_per_second = i64( 1'000'000'000 );
+
+		i64 m_capacity;
+		i64 m_rate;
+		alignas( 64 ) std::atomic<i64> m_tokens;
+		alignas( 64 ) std::atomic<i64> m_last_ns;
+
+		[[nodiscard]] static i64 to_ns( time_point tp ) {
+			auto const since_epoch =
+			  std::chrono::duration_cast<std::chrono::nanoseconds>(
+			    tp.time_since_epoch( ) );
+			return i64( static_cast<std::int64_t>( since_epoch.count( ) ) );
+		}
+
+		/// The whole tokens earned in elapsed_ns, elapsed_ns * m_rate / 1s
+		/// rounded down and saturated.  Both factors are split into seconds and
+		/// nanoseconds so that no partial product needs more than 64 bits.
+		/// remainder is set to the full product modulo 1s
+		[[nodiscard]] i64 earned_tokens( i64 elapsed_ns, i64 &remainder ) const {
+			auto const e_s = elapsed_ns / ns_per_second;
+			auto const e_ns = elapsed_ns % ns_per_second;
+			auto const r_s = m_rate / ns_per_second;
+			auto const r_ns = m_rate % ns_per_second;
+			// e_ns * r_ns is below 1e18 and cannot overflow
+			auto const low = e_ns * r_ns;
+			remainder = low % ns_per_second;
+			return e_s.mul_saturated( r_s )
+			  .mul_saturated( ns_per_second )
+			  .add_saturated( e_s.mul_saturated( r_ns ) )
+			  .add_saturated( e_ns.mul_saturated( r_s ) )
+			  .add_saturated( low / ns_per_second );
+		}
+
+		/// Credit the tokens earned since the last refill.  The thread that
+		/// advances the refill time is the only one to credit that period
+		void refill( i64 now_ns ) {
+			auto last = m_last_ns.load( std::memory_order_acquire );
+			auto const elapsed = now_ns.sub_checked( last );
+			if( elapsed <= 0 ) {
+				return;
+			}
+			auto remainder = i64( 0 );
+			auto const exact = earned_tokens( elapsed, remainder );
+			if( exact == 0 ) {
+				return;
+			}
+			auto const earned = ( std::min )( exact, m_capacity );
+			// Only whole tokens are credited.  The refill time advances by the
+			// time those tokens took, rounded up, and the rest stays for the
+			// next refill.  That is elapsed less the time the remainder is worth.
+			// When the bucket fills there is nothing to carry over
+			auto next_last = now_ns;
+			if( exact < m_capacity ) {
+				next_last = last.add_checked( elapsed - remainder / m_rate );
+			}
+			if( not m_last_ns.compare_exchange_strong(
+			      last, next_last, std::memory_order_acq_rel,
+			      std::memory_order_acquire ) ) {
+				return;
+			}
+			auto tokens = m_tokens.load( std::memory_order_relaxed );
+			while( true ) {
+				auto const filled =
+				  ( std::min )( tokens.add_saturated( earned ), m_capacity );
+				if( m_tokens.compare_exchange_weak( tokens, filled,
+				                                    std::memory_order_acq_rel,
+				                                    std::memory_order_relaxed ) ) {
+					return;
+				}
+			}
+		}
+
+	public:
+		/// @param capacity The most tokens the bucket holds, it starts full
+		/// @param tokens_per_second The refill rate
+		/// @param now The time the bucket starts refilling from
+		/// A capacity or rate that is not positive is reported via
+		/// on_signed_integer_out_of_range and replaced by 1
+		token_bucket( i64 capacity, i64 tokens_per_second,
+		              time_point now = Clock::now( ) )
+		  : m_capacity( capacity )
+		  , m_rate( tokens_per_second )
+		  , m_tokens( capacity )
+		  , m_last_ns( to_ns( now ) ) {
+			if( DAW_UNLIKELY( m_capacity <= 0 or m_rate <= 0 ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				m_capacity = ( std::max )( m_capacity, i64( 1 ) );
+				m_rate = ( std::max )( m_rate, i64( 1 ) );
+				m_tokens.store( m_capacity, std::memory_order_relaxed );
+			}
+		}
+
+		token_bucket( token_bucket const & ) = delete;
+		token_bucket &operator=( token_bucket const & ) = delete;
+
+		[[nodiscard]] i64 capacity( ) const noexcept {
+			return m_capacity;
+		}
+
+		[[nodiscard]] i64 tokens_per_second( ) const noexcept {
+			return m_rate;
+		}
+
+		/// @brief The tokens available at now, after crediting the refill
+		[[nodiscard]] i64 available( time_point now = Clock::now( ) ) {
+			refill( to_ns( now ) );
+			return m_tokens.load( std::memory_order_acquire );
+		}
+
+		/// @brief Take count tokens if that many are available at now
+		/// @return true when the tokens were taken.  A negative count is
+		/// reported via on_signed_integer_out_of_range and nothing is taken
+		[[nodiscard]] bool try_consume( i64 count = i64( 1 ),
+		                                time_point now = Clock::now( ) ) {
+			if( DAW_UNLIKELY( count < 0 ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_out_of_range( );
+				return false;
+			}
+			refill( to_ns( now ) );
+			auto tokens = m_tokens.load( std::memory_order_relaxed );
+			do {
+				if( tokens < count ) {
+					return false;
+				}
+			} while( not m_tokens.compare_exchange_weak(
+			  tokens, tokens.sub_checked( count ), std::memory_order_acq_rel,
+			  std::memory_order_relaxed ) );
+			return true;
+		}
+	};
+} // namespace daw::integers
@@ -0,0 +1,199 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_cpp_feature_check.h>
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/// \brief _addcarry_u64 and _subborrow_u64 lower to adc and sbb.  They are
+/// used outside of constant evaluation when the compiler can tell the two
+/// apart
+#if( defined( __x86_64__ ) or defined( _M_X64 ) ) and                       \
+  ( ( defined( __clang__ ) and __clang_major__ >= 9 ) or                    \
+    ( not defined( __clang__ ) and defined( __GNUC__ ) and __GNUC__ >= 9 ) or \
+    ( defined( _MSC_VER ) and _MSC_VER >= 1925 ) )
+#define DAW_INTEGERS_HAS_ADDCARRY
+#include <immintrin.h>
+#endif
+
+namespace daw::integers {
+	/// @brief The result of add_carry and sub_borrow.  carry is the carry out
+	/// of an add or the borrow out of a subtract
+	template<typename T>
+	struct carry_result {
+		T value;
+		bool carry;
+	};
+
+	namespace sint_impl {
+		template<typename T>
+		inline constexpr bool is_carry_int_v =
+		  std::is_integral_v<T> and not std::is_same_v<T, bool> and
+		  sizeof( T ) <= 8;
+
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr carry_result<T>
+		add_carry( T a, T b, bool carry_in ) noexcept {
+			using unsigned_t = std::make_unsigned_t<T>;
+			auto const ua = static_cast<unsigned_t>( a );
+			auto const ub = static_cast<unsigned_t>( b );
+			if constexpr( sizeof( T ) < 8 ) {
+				auto const sum = std::uint64_t{ ua } + ub + carry_in;
+				return { static_cast<T>( static_cast<unsigned_t>( sum ) ),
+				         ( sum >> ( sizeof( T ) * CHAR_BIT ) ) != 0 };
+			} else {
+#if defined( DAW_INTEGERS_HAS_ADDCARRY )
+				if( not __builtin_is_constant_evaluated( ) ) {
+					unsigned long long sum = 0;
+					auto const carry = _addcarry_u64(
+					  static_cast<unsigned char>( carry_in ), ua, ub, &sum );
+					return { static_cast<T>( sum ), carry != 0 };
+				}
+#endif
+				auto const partial = static_cast<unsigned_t>( ua + ub );
+				auto const sum = static_cast<unsigned_t>( partial + carry_in );
+				return { static_cast<T>( sum ), ( partial < ua ) or ( sum < partial ) };
+			}
+		}
+
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr carry_result<T>
+		sub_borrow( T a, T b, bool borrow_in ) noexcept {
+			using unsigned_t = std::make_unsigned_t<T>;
+			auto const ua = static_cast<unsigned_t>( a );
+			auto const ub = static_cast<unsigned_t>( b );
+			if constexpr( sizeof( T ) < 8 ) {
+				// A borrow wraps the difference and sets the bits above the word
+				auto const diff = std::uint64_t{ ua } - ub - borrow_in;
+				return { static_cast<T>( static_cast<unsigned_t>( diff ) ),
+				         ( diff >> ( sizeof( T ) * CHAR_BIT ) ) != 0 };
+			} else {
+#if defined( DAW_INTEGERS_HAS_ADDCARRY )
+				if( not __builtin_is_constant_evaluated( ) ) {
+					unsigned long long diff = 0;
+					auto const borrow = _subborrow_u64(
+					  static_cast<unsigned char>( borrow_in ), ua, ub, &diff );
+					return { static_cast<T>( diff ), borrow != 0 };
+				}
+#endif
+				auto const partial = static_cast<unsigned_t>( ua - ub );
+				auto const diff = static_cast<unsigned_t>( partial - borrow_in );
+				return { static_cast<T>( diff ), ( ua < ub ) or ( partial < diff ) };
+			}
+		}
+
+		/// @brief Full product of two unsigned integers of at most 64 bits.
+		/// Returns the low half and stores the high half in hi
+		template<typename U>
+		DAW_ATTRIB_INLINE constexpr U umul_wide( U a, U b, U &hi ) noexcept {
+			static_assert( std::is_unsigned_v<U> and sizeof( U ) <= 8 );
+			if constexpr( sizeof( U ) < 8 ) {
+				auto const p =
+				  static_cast<std::uint64_t>( a ) * static_cast<std::uint64_t>( b );
+				hi = static_cast<U>( p >> ( sizeof( U ) * CHAR_BIT ) );
+				return static_cast<U>( p );
+			} else {
+#if defined( DAW_HAS_INT128 )
+				auto const p =
+				  static_cast<daw::uint128_t>( a ) * static_cast<daw::uint128_t>( b );
+				hi = static_cast<U>( p >> 64U );
+				return static_cast<U>( p );
+#else
+				// Schoolbook product of 32 bit halves
+				auto const a_lo = a & 0xFFFF'FFFFU;
+				auto const a_hi = a >> 32U;
+				auto const b_lo = b & 0xFFFF'FFFFU;
+				auto const b_hi = b >> 32U;
+				auto const ll = a_lo * b_lo;
+				auto const lh = a_lo * b_hi;
+				auto const hl = a_hi * b_lo;
+				auto const hh = a_hi * b_hi;
+				auto const mid = ( ll >> 32U ) + ( lh & 0xFFFF'FFFFU ) +
+				                 ( hl & 0xFFFF'FFFFU );
+				hi = hh + ( lh >> 32U ) + ( hl >> 32U ) + ( mid >> 32U );
+				return ( mid << 32U ) | ( ll & 0xFFFF'FFFFU );
+#endif
+			}
+		}
+	} // namespace sint_impl
+
+	/// @brief The double width result of mul_wide, high * 2^Bits + low
+	template<std::size_t Bits>
+	struct wide_product {
+		signed_integer<Bits> high;
+		std::make_unsigned_t<sint_impl::signed_integer_type_t<Bits>> low;
+	};
+
+	/// @brief The full product of lhs and rhs.  This cannot overflow
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr wide_product<Bits>
+	mul_wide( signed_integer<Bits> lhs, signed_integer<Bits> rhs ) noexcept {
+		using unsigned_t =
+		  std::make_unsigned_t<sint_impl::signed_integer_type_t<Bits>>;
+		auto const a = static_cast<unsigned_t>( lhs.value( ) );
+		auto const b = static_cast<unsigned_t>( rhs.value( ) );
+		auto hi = unsigned_t{ };
+		auto const lo = sint_impl::umul_wide( a, b, hi );
+		// The unsigned product of the two's complement bit patterns differs from
+		// the signed one by b * 2^Bits when a < 0 and a * 2^Bits when b < 0
+		hi = static_cast<unsigned_t>( hi - ( lhs < 0 ? b : unsigned_t{ 0 } ) -
+		                              ( rhs < 0 ? a : unsigned_t{ 0 } ) );
+		return wide_product<Bits>{
+		  signed_integer<Bits>::conversion_unchecked(
+		    static_cast<sint_impl::signed_integer_type_t<Bits>>( hi ) ),
+		  lo };
+	}
+
+	/// @brief a + b + carry_in on the bit patterns of a and b as unsigned
+	/// words, the building block of multi-word addition.  carry is the carry
+	/// out of the word, not signed overflow
+	template<typename T,
+	         std::enable_if_t<sint_impl::is_carry_int_v<T>, std::nullptr_t> =
+	           nullptr>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr carry_result<T>
+	add_carry( T a, T b, bool carry_in = false ) noexcept {
+		return sint_impl::add_carry( a, b, carry_in );
+	}
+
+	/// @brief a - b - borrow_in on the bit patterns of a and b as unsigned
+	/// words, the building block of multi-word subtraction.  carry is the
+	/// borrow out of the word, not signed overflow
+	template<typename T,
+	         std::enable_if_t<sint_impl::is_carry_int_v<T>, std::nullptr_t> =
+	           nullptr>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr carry_result<T>
+	sub_borrow( T a, T b, bool borrow_in = false ) noexcept {
+		return sint_impl::sub_borrow( a, b, borrow_in );
+	}
+
+	/// @brief add_carry on the two's complement bit patterns of a and b
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr carry_result<signed_integer<Bits>>
+	add_carry( signed_integer<Bits> a, signed_integer<Bits> b,
+	           bool carry_in = false ) noexcept {
+		auto const r = sint_impl::add_carry( a.value( ), b.value( ), carry_in );
+		return { signed_integer<Bits>::conversion_unchecked( r.value ), r.carry };
+	}
+
+	/// @brief sub_borrow on the two's complement bit patterns of a and b
+	template<std::size_t Bits>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr carry_result<signed_integer<Bits>>
+	sub_borrow( signed_integer<Bits> a, signed_integer<Bits> b,
+	            bool borrow_in = false ) noexcept {
+		auto const r = sint_impl::sub_borrow( a.value( ), b.value( ), borrow_in );
+		return { signed_integer<Bits>::conversion_unchecked( r.value ), r.carry };
+	}
+} // namespace daw::integers
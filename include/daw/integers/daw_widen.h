@@ -0,0 +1,433 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "daw_signed.h"
+#include "impl/daw_signed_error_handling.h"
+#include "impl/daw_signed_range.h"
+#include "impl/daw_signed_simd.h"
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_likely.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace daw::integers {
+	namespace sint_impl {
+		/// The fused transform validates its input range a block at a time, small
+		/// enough that the block is still in L1 when it is converted
+		inline constexpr std::size_t widen_block_size = 4096;
+
+		/// @brief out = in * scale + offset, in the wider type.  As with
+		/// mul_checked followed by add_checked, both the product and the sum
+		/// must fit
+		template<typename To>
+		struct widen_affine {
+			To scale;
+			To offset;
+
+			/// @brief Whether v * scale + offset fits in To
+			DAW_ATTRIB_INLINE constexpr bool fits( To v ) const noexcept {
+				auto product = To{ };
+				auto result = To{ };
+				return not wrapping_mul( v, scale, product ) and
+				       not wrapping_add( product, offset, result );
+			}
+
+			DAW_ATTRIB_INLINE constexpr To operator( )( To v ) const noexcept {
+				return static_cast<To>( v * scale + offset );
+			}
+		};
+
+		/// @brief The smallest and largest of values[0, count), count > 0
+		template<typename From>
+		DAW_ATTRIB_INLINE void min_max( From const *values, std::size_t count,
+		                                From &lo, From &hi ) noexcept {
+			std::size_t n = 0;
+			lo = values[0];
+			hi = values[0];
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+			constexpr std::size_t lanes = 32 / sizeof( From );
+			if( count >= lanes ) {
+				auto vlo =
+				  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( values ) );
+				auto vhi = vlo;
+				for( n = lanes; n + lanes <= count; n += lanes ) {
+					auto const v = _mm256_loadu_si256(
+					  reinterpret_cast<__m256i const *>( values + n ) );
+					if constexpr( sizeof( From ) == 1 ) {
+						vlo = _mm256_min_epi8( vlo, v );
+						vhi = _mm256_max_epi8( vhi, v );
+					} else if constexpr( sizeof( From ) == 2 ) {
+						vlo = _mm256_min_epi16( vlo, v );
+						vhi = _mm256_max_epi16( vhi, v );
+					} else {
+						vlo = _mm256_min_epi32( vlo, v );
+						vhi = _mm256_max_epi32( vhi, v );
+					}
+				}
+				From lo_lanes[lanes];
+				From hi_lanes[lanes];
+				_mm256_storeu_si256( reinterpret_cast<__m256i *>( lo_lanes ), vlo );
+				_mm256_storeu_si256( reinterpret_cast<__m256i *>( hi_lanes ), vhi );
+				for( std::size_t l = 0; l < lanes; ++l ) {
+					lo = ( std::min )( lo, lo_lanes[l] );
+					hi = ( std::max )( hi, hi_lanes[l] );
+				}
+			}
+#endif
+			for( ; n < count; ++n ) {
+				lo = ( std::min )( lo, values[n] );
+				hi = ( std::max )( hi, values[n] );
+			}
+		}
+
+#if defined( DAW_INTEGERS_HAS_SSE41 ) or defined( DAW_INTEGERS_HAS_AVX2 )
+		/// @brief Load Bytes bytes into the low end of a vector
+		template<std::size_t Bytes>
+		DAW_ATTRIB_INLINE __m128i load_low( void const *ptr ) noexcept {
+			if constexpr( Bytes == 16 ) {
+				return _mm_loadu_si128( static_cast<__m128i const *>( ptr ) );
+			} else if constexpr( Bytes == 8 ) {
+				return _mm_loadl_epi64( static_cast<__m128i const *>( ptr ) );
+			} else {
+				static_assert( Bytes == 4 or Bytes == 2 );
+				using chunk_t =
+				  std::conditional_t<Bytes == 4, std::uint32_t, std::uint16_t>;
+				auto chunk = chunk_t{ };
+				std::memcpy( &chunk, ptr, Bytes );
+				return _mm_cvtsi32_si128( static_cast<int>( chunk ) );
+			}
+		}
+
+		/// @brief Sign extend the low lanes of v, pmovsx
+		template<std::size_t From, std::size_t To>
+		DAW_ATTRIB_INLINE __m128i sign_extend_128( __m128i v ) noexcept {
+			if constexpr( From == 8 and To == 16 ) {
+				return _mm_cvtepi8_epi16( v );
+			} else if constexpr( From == 8 and To == 32 ) {
+				return _mm_cvtepi8_epi32( v );
+			} else if constexpr( From == 8 and To == 64 ) {
+				return _mm_cvtepi8_epi64( v );
+			} else if constexpr( From == 16 and To == 32 ) {
+				return _mm_cvtepi16_epi32( v );
+			} else if constexpr( From == 16 and To == 64 ) {
+				return _mm_cvtepi16_epi64( v );
+			} else {
+				static_assert( From == 32 and To == 64 );
+				return _mm_cvtepi32_epi64( v );
+			}
+		}
+
+		/// @brief v * scale + offset per lane.  64 bit lanes use pmuldq, so scale
+		/// must fit in 32 bits and v must already be a sign extended 32 bit value
+		template<std::size_t To>
+		DAW_ATTRIB_INLINE __m128i affine_128( __m128i v, __m128i scale,
+		                                      __m128i offset ) noexcept {
+			if constexpr( To == 16 ) {
+				return _mm_add_epi16( _mm_mullo_epi16( v, scale ), offset );
+			} else if constexpr( To == 32 ) {
+				return _mm_add_epi32( _mm_mullo_epi32( v, scale ), offset );
+			} else {
+				return _mm_add_epi64( _mm_mul_epi32( v, scale ), offset );
+			}
+		}
+
+		template<std::size_t To>
+		DAW_ATTRIB_INLINE __m128i
+		set1_128( signed_integer_type_t<To> v ) noexcept {
+			if constexpr( To == 16 ) {
+				return _mm_set1_epi16( v );
+			} else if constexpr( To == 32 ) {
+				return _mm_set1_epi32( v );
+			} else {
+				return _mm_set1_epi64x( v );
+			}
+		}
+#endif
+
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+		/// @brief Sign extend the low lanes of v to fill 256 bits, vpmovsx
+		template<std::size_t From, std::size_t To>
+		DAW_ATTRIB_INLINE __m256i sign_extend_256( __m128i v ) noexcept {
+			if constexpr( From == 8 and To == 16 ) {
+				return _mm256_cvtepi8_epi16( v );
+			} else if constexpr( From == 8 and To == 32 ) {
+				return _mm256_cvtepi8_epi32( v );
+			} else if constexpr( From == 8 and To == 64 ) {
+				return _mm256_cvtepi8_epi64( v );
+			} else if constexpr( From == 16 and To == 32 ) {
+				return _mm256_cvtepi16_epi32( v );
+			} else if constexpr( From == 16 and To == 64 ) {
+				return _mm256_cvtepi16_epi64( v );
+			} else {
+				static_assert( From == 32 and To == 64 );
+				return _mm256_cvtepi32_epi64( v );
+			}
+		}
+
+		template<std::size_t To>
+		DAW_ATTRIB_INLINE __m256i affine_256( __m256i v, __m256i scale,
+		                                      __m256i offset ) noexcept {
+			if constexpr( To == 16 ) {
+				return _mm256_add_epi16( _mm256_mullo_epi16( v, scale ), offset );
+			} else if constexpr( To == 32 ) {
+				return _mm256_add_epi32( _mm256_mullo_epi32( v, scale ), offset );
+			} else {
+				return _mm256_add_epi64( _mm256_mul_epi32( v, scale ), offset );
+			}
+		}
+
+		template<std::size_t To>
+		DAW_ATTRIB_INLINE __m256i
+		set1_256( signed_integer_type_t<To> v ) noexcept {
+			if constexpr( To == 16 ) {
+				return _mm256_set1_epi16( v );
+			} else if constexpr( To == 32 ) {
+				return _mm256_set1_epi32( v );
+			} else {
+				return _mm256_set1_epi64x( v );
+			}
+		}
+#endif
+
+#if defined( DAW_INTEGERS_HAS_NEON )
+		/// @brief Load 8 lanes of From as 16 bit lanes
+		template<std::size_t From>
+		DAW_ATTRIB_INLINE int16x8_t
+		load_8_as_16_neon( signed_integer_type_t<From> const *in ) noexcept {
+			static_assert( From == 8 or From == 16 );
+			if constexpr( From == 8 ) {
+				return vmovl_s8( vld1_s8( in ) );
+			} else {
+				return vld1q_s16( in );
+			}
+		}
+
+		/// @brief Sign extend 8 lanes of From to To and store them, sxtl.  With
+		/// Affine the values are multiplied by scale and offset is added first
+		template<std::size_t From, std::size_t To, bool Affine>
+		DAW_ATTRIB_INLINE void widen_8_neon(
+		  signed_integer_type_t<From> const *in, signed_integer_type_t<To> *out,
+		  widen_affine<signed_integer_type_t<To>> const &affine ) noexcept {
+			// Bring the lanes to 16 and then 32 bits, one sxtl per doubling
+			if constexpr( To == 16 ) {
+				auto v16 = load_8_as_16_neon<From>( in );
+				if constexpr( Affine ) {
+					v16 = vmlaq_s16( vdupq_n_s16( affine.offset ), v16,
+					                 vdupq_n_s16( affine.scale ) );
+				}
+				vst1q_s16( out, v16 );
+			} else {
+				int32x4_t lo;
+				int32x4_t hi;
+				if constexpr( From == 32 ) {
+					lo = vld1q_s32( in );
+					hi = vld1q_s32( in + 4 );
+				} else {
+					auto const v16 = load_8_as_16_neon<From>( in );
+					lo = vmovl_s16( vget_low_s16( v16 ) );
+					hi = vmovl_s16( vget_high_s16( v16 ) );
+				}
+				if constexpr( To == 32 ) {
+					if constexpr( Affine ) {
+						auto const offset = vdupq_n_s32( affine.offset );
+						auto const scale = vdupq_n_s32( affine.scale );
+						lo = vmlaq_s32( offset, lo, scale );
+						hi = vmlaq_s32( offset, hi, scale );
+					}
+					vst1q_s32( out, lo );
+					vst1q_s32( out + 4, hi );
+				} else {
+					int32x2_t const parts[4] = { vget_low_s32( lo ), vget_high_s32( lo ),
+					                             vget_low_s32( hi ),
+					                             vget_high_s32( hi ) };
+					for( std::size_t p = 0; p < 4; ++p ) {
+						if constexpr( Affine ) {
+							// smlal, the scale fits in 32 bits
+							vst1q_s64( out + 2 * p,
+							           vmlal_s32( vdupq_n_s64( affine.offset ), parts[p],
+							                      vdup_n_s32( static_cast<std::int32_t>(
+							                        affine.scale ) ) ) );
+						} else {
+							vst1q_s64( out + 2 * p, vmovl_s32( parts[p] ) );
+						}
+					}
+				}
+			}
+		}
+#endif
+
+		/// @brief Sign extend in[0, count) into out, optionally applying affine.
+		/// With Affine every result must fit in To
+		template<std::size_t From, std::size_t To, bool Affine>
+		void widen_block(
+		  signed_integer_type_t<From> const *in, std::size_t count,
+		  signed_integer_type_t<To> *out,
+		  widen_affine<signed_integer_type_t<To>> const &affine ) noexcept {
+			using to_t = signed_integer_type_t<To>;
+			std::size_t n = 0;
+			// 64 bit lanes multiply with pmuldq/smlal, which takes a 32 bit scale
+			bool const vector_scale =
+			  not Affine or To < 64 or
+			  ( affine.scale >= std::numeric_limits<std::int32_t>::min( ) and
+			    affine.scale <= std::numeric_limits<std::int32_t>::max( ) );
+#if defined( DAW_INTEGERS_HAS_AVX2 )
+			if( vector_scale ) {
+				constexpr std::size_t lanes = 256 / To;
+				auto const scale = set1_256<To>( affine.scale );
+				auto const offset = set1_256<To>( affine.offset );
+				for( ; n + lanes <= count; n += lanes ) {
+					auto v = sign_extend_256<From, To>(
+					  load_low<lanes * From / 8>( in + n ) );
+					if constexpr( Affine ) {
+						v = affine_256<To>( v, scale, offset );
+					}
+					_mm256_storeu_si256( reinterpret_cast<__m256i *>( out + n ), v );
+				}
+			}
+#elif defined( DAW_INTEGERS_HAS_SSE41 )
+			if( vector_scale ) {
+				constexpr std::size_t lanes = 128 / To;
+				auto const scale = set1_128<To>( affine.scale );
+				auto const offset = set1_128<To>( affine.offset );
+				for( ; n + lanes <= count; n += lanes ) {
+					auto v = sign_extend_128<From, To>(
+					  load_low<lanes * From / 8>( in + n ) );
+					if constexpr( Affine ) {
+						v = affine_128<To>( v, scale, offset );
+					}
+					_mm_storeu_si128( reinterpret_cast<__m128i *>( out + n ), v );
+				}
+			}
+#elif defined( DAW_INTEGERS_HAS_NEON )
+			if( vector_scale ) {
+				for( ; n + 8 <= count; n += 8 ) {
+					widen_8_neon<From, To, Affine>( in + n, out + n, affine );
+				}
+			}
+#endif
+			(void)vector_scale;
+			for( ; n < count; ++n ) {
+				auto const v = static_cast<to_t>( in[n] );
+				if constexpr( Affine ) {
+					out[n] = affine( v );
+				} else {
+					out[n] = v;
+				}
+			}
+		}
+	} // namespace sint_impl
+
+	/// @brief Sign extend in[n] into out[n] for each n in [0, count).  This is
+	/// the converting constructor of signed_integer over an array, using
+	/// pmovsx/sxtl when available
+	template<std::size_t To, std::size_t From>
+	void widen( signed_integer<From> const *in, std::size_t count,
+	            signed_integer<To> *out ) {
+		static_assert( To > From, "widen requires a wider output type" );
+		sint_impl::widen_block<From, To, false>(
+		  sint_impl::raw_ptr( in ), count, sint_impl::raw_ptr( out ), { } );
+	}
+
+	/// @brief Perform out[n] = in[n] * scale + offset for each n in [0, count),
+	/// in the wider type, e.g. frame of reference decoding of narrow deltas.
+	/// The input is validated in blocks before it is converted; the first
+	/// element whose product or result does not fit is reported via
+	/// on_signed_integer_overflow and stops the conversion
+	/// @return The number of elements of out written.  This is count unless a
+	/// result would overflow, in which case it is the position of that element
+	template<std::size_t To, std::size_t From>
+	std::size_t widen( signed_integer<From> const *in, std::size_t count,
+	                   signed_integer<To> *out, signed_integer<To> offset,
+	                   signed_integer<To> scale = signed_integer<To>( 1 ) ) {
+		static_assert( To > From, "widen requires a wider output type" );
+		using from_t = sint_impl::signed_integer_type_t<From>;
+		using to_t = sint_impl::signed_integer_type_t<To>;
+		auto const affine =
+		  sint_impl::widen_affine<to_t>{ scale.value( ), offset.value( ) };
+		auto const *const raw_in = sint_impl::raw_ptr( in );
+		auto *const raw_out = sint_impl::raw_ptr( out );
+		// The transform is monotonic, so when both ends of From fit every value
+		// does and the input does not need to be looked at
+		bool const always_fits =
+		  affine.fits( std::numeric_limits<from_t>::min( ) ) and
+		  affine.fits( std::numeric_limits<from_t>::max( ) );
+		if( always_fits ) {
+			sint_impl::widen_block<From, To, true>( raw_in, count, raw_out, affine );
+			return count;
+		}
+		for( std::size_t first = 0; first < count;
+		     first += sint_impl::widen_block_size ) {
+			auto const block_size =
+			  ( std::min )( sint_impl::widen_block_size, count - first );
+			auto lo = from_t{ };
+			auto hi = from_t{ };
+			sint_impl::min_max( raw_in + first, block_size, lo, hi );
+			if( DAW_UNLIKELY( not( affine.fits( lo ) and affine.fits( hi ) ) ) ) {
+				DAW_UNLIKELY_BRANCH
+				auto valid = std::size_t{ 0 };
+				while( affine.fits( raw_in[first + valid] ) ) {
+					++valid;
+				}
+				sint_impl::widen_block<From, To, true>( raw_in + first, valid,
+				                                        raw_out + first, affine );
+				on_signed_integer_overflow( );
+				return first + valid;
+			}
+			sint_impl::widen_block<From, To, true>( raw_in + first, block_size,
+			                                        raw_out + first, affine );
+		}
+		return count;
+	}
+
+	/// @brief Sign extend each element of in into out.  An out range that is
+	/// smaller than in is reported via on_signed_integer_out_of_range and only
+	/// the elements that fit are converted
+	template<typename In, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<In const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	void widen( In const &in, Out &&out ) {
+		auto count = static_cast<std::size_t>( std::size( in ) );
+		if( DAW_UNLIKELY( std::size( out ) < count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			count = static_cast<std::size_t>( std::size( out ) );
+		}
+		widen( std::data( in ), count, std::data( out ) );
+	}
+
+	/// @brief Perform out[n] = in[n] * scale + offset for each element of in.
+	/// See the pointer overload for details.  An out range that is smaller than
+	/// in is reported via on_signed_integer_out_of_range and only the elements
+	/// that fit are converted
+	template<typename In, typename Out,
+	         std::enable_if_t<sint_impl::is_contiguous_range_v<In const> and
+	                            sint_impl::is_contiguous_range_v<Out>,
+	                          std::nullptr_t> = nullptr>
+	std::size_t
+	widen( In const &in, Out &&out, sint_impl::range_value_t<Out> offset,
+	       sint_impl::range_value_t<Out> scale =
+	         sint_impl::range_value_t<Out>( 1 ) ) {
+		auto count = static_cast<std::size_t>( std::size( in ) );
+		if( DAW_UNLIKELY( std::size( out ) < count ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_out_of_range( );
+			count = static_cast<std::size_t>( std::size( out ) );
+		}
+		return widen( std::data( in ), count, std::data( out ), offset, scale );
+	}
+} // namespace daw::integers
@@ -151,27 +151,49 @@ namespace daw::integers::sint_impl {
 			if( DAW_UNLIKELY( rhs == 0 ) ) {
 				on_signed_integer_div_by_zero( );
 			}
-			if( lhs == daw::numeric_limits<T>::min( ) and rhs.value( ) == T{ -1 } ) {
+			if( lhs == daw::numeric_limits<T>::min( ) and rhs == T{ -1 } ) {
 				on_signed_integer_overflow( );
 			}
 			return lhs % rhs;
 		}
 	} checked_rem{ };
 
+	/// @brief The number of bits after the sign bit that are equal to it.
+	/// lhs << k keeps every significant bit exactly when k is not larger than
+	/// this
+	template<typename T,
+	         std::enable_if_t<is_valid_int_type<T>, std::nullptr_t> = nullptr>
+	DAW_ATTRIB_INLINE constexpr int count_redundant_sign_bits( T value ) {
+		if constexpr( sizeof( T ) <= sizeof( int ) ) {
+			constexpr auto extra_bits =
+			  static_cast<int>( ( sizeof( int ) - sizeof( T ) ) * CHAR_BIT );
+			return __builtin_clrsb( static_cast<int>( value ) ) - extra_bits;
+		} else {
+			return __builtin_clrsbll( static_cast<long long>( value ) );
+		}
+	}
+
+	/// Shifting left reports overflow when a significant bit, including the
+	/// sign, is shifted out or the count is outside of [0, bits).  The result
+	/// is the wrapped value
 	inline constexpr struct checked_shl_t {
 		explicit checked_shl_t( ) = default;
 
 		template<typename T,
 		         std::enable_if_t<is_valid_int_type<T>, std::nullptr_t> = nullptr>
 		DAW_ATTRIB_INLINE constexpr T operator( )( T lhs, T rhs ) const {
-			if( DAW_UNLIKELY( rhs == 0 ) ) {
+			using unsigned_t = std::make_unsigned_t<T>;
+			if( DAW_UNLIKELY( static_cast<unsigned_t>( rhs ) >=
+			                  sizeof( T ) * CHAR_BIT ) ) {
 				on_signed_integer_overflow( );
-				return lhs;
-			} else if( DAW_UNLIKELY( rhs >= ( sizeof( rhs ) * CHAR_BIT ) ) ) {
+				return T{ 0 };
+			}
+			auto const result =
+			  static_cast<T>( static_cast<unsigned_t>( lhs ) << rhs );
+			if( DAW_UNLIKELY( rhs > count_redundant_sign_bits( lhs ) ) ) {
 				on_signed_integer_overflow( );
-				return lhs << ( sizeof( T ) * CHAR_BIT - 1 );
 			}
-			return lhs << rhs;
+			return result;
 		}
 	} checked_shl{ };
 
@@ -181,14 +203,13 @@ namespace daw::integers::sint_impl {
 		template<typename T,
 		         std::enable_if_t<is_valid_int_type<T>, std::nullptr_t> = nullptr>
 		DAW_ATTRIB_INLINE constexpr T operator( )( T lhs, T rhs ) const {
-			if( DAW_UNLIKELY( rhs == 0 ) ) {
-				on_signed_integer_overflow( );
-				return lhs;
-			} else if( DAW_UNLIKELY( rhs >= ( sizeof( rhs ) * CHAR_BIT ) ) ) {
+			using unsigned_t = std::make_unsigned_t<T>;
+			if( DAW_UNLIKELY( static_cast<unsigned_t>( rhs ) >=
+			                  sizeof( T ) * CHAR_BIT ) ) {
 				on_signed_integer_overflow( );
-				return lhs >> ( sizeof( T ) * CHAR_BIT - 1 );
+				return static_cast<T>( lhs >> ( sizeof( T ) * CHAR_BIT - 1 ) );
 			}
-			return lhs >> rhs;
+			return static_cast<T>( lhs >> rhs );
 		}
 	} checked_shr{ };
 } // namespace daw::integers::sint_impl
@@ -30,7 +30,7 @@
 #endif
 
 namespace daw::integers {
-	enum class SignedIntegerErrorType { Overflow, DivideByZero };
+	enum class SignedIntegerErrorType { Overflow, DivideByZero, OutOfRange };
 	using signed_int_error_handler_t = void ( * )( void *,
 	                                               SignedIntegerErrorType );
 
@@ -50,6 +50,14 @@ namespace daw::integers {
 			} handler{ };
 			return handler;
 		}
+
+		inline auto &get_signed_integer_out_of_range_handler( ) {
+			static DAW_CONSTINIT struct handler_t {
+				signed_int_error_handler_t cb = nullptr;
+				void *data = nullptr;
+			} handler{ };
+			return handler;
+		}
 	} // namespace sint_impl
 
 	/// Caller is responsible for ensuring that this is called in a context that
@@ -118,8 +126,42 @@ namespace daw::integers {
 		}
 	}
 
+	/// Caller is responsible for ensuring that this is called in a context that
+	/// protects against multiple threads accessing/writing at the same time
+	DAW_ATTRIB_NOINLINE inline void register_signed_out_of_range_handler(
+	  signed_int_error_handler_t handler = nullptr,
+	  void *data = nullptr ) noexcept {
+		sint_impl::get_signed_integer_out_of_range_handler( ).cb = handler;
+		sint_impl::get_signed_integer_out_of_range_handler( ).data = data;
+	}
+
+	/// Caller is responsible for ensuring that this is called in a context that
+	/// protects against multiple threads accessing/writing at the same time
+	template<typename Func,
+	         std::enable_if_t<std::is_class_v<Func> and
+	                            std::is_invocable_v<Func, SignedIntegerErrorType>,
+	                          std::nullptr_t> = nullptr>
+	DAW_ATTRIB_NOINLINE inline void
+	register_signed_out_of_range_handler( Func &handler ) noexcept {
+		if constexpr( std::is_const_v<Func> ) {
+			register_signed_out_of_range_handler(
+			  +[]( void *vhnd, SignedIntegerErrorType error_type ) {
+				  (void)( *static_cast<Func const *>( vhnd ) )( error_type );
+			  },
+			  const_cast<void *>(
+			    static_cast<void const *>( std::addressof( handler ) ) ) );
+		} else {
+			register_signed_out_of_range_handler(
+			  +[]( void *vhnd, SignedIntegerErrorType error_type ) {
+				  (void)( *static_cast<Func *>( vhnd ) )( error_type );
+			  },
+			  static_cast<void *>( std::addressof( handler ) ) );
+		}
+	}
+
 	struct signed_integer_overflow_exception : std::exception {};
 	struct signed_integer_div_by_zero_exception : std::exception {};
+	struct signed_integer_out_of_range_exception : std::exception {};
 
 	DAW_ATTRIB_NOINLINE inline void on_signed_integer_overflow( ) {
 		auto handler = sint_impl::get_signed_integer_overflow_handler( );
@@ -138,4 +180,15 @@ namespace daw::integers {
 		}
 		DAW_THROW_OR_TERMINATE_NA( signed_integer_div_by_zero_exception );
 	}
+
+	/// @brief Called when an index or count used by a bulk operation is outside
+	/// of the valid range of the sequence it refers to
+	DAW_ATTRIB_NOINLINE inline void on_signed_integer_out_of_range( ) {
+		auto handler = sint_impl::get_signed_integer_out_of_range_handler( );
+		if( handler.cb ) {
+			handler.cb( handler.data, SignedIntegerErrorType::OutOfRange );
+			return;
+		}
+		DAW_THROW_OR_TERMINATE_NA( signed_integer_out_of_range_exception );
+	}
 } // namespace daw::integers
@@ -10,6 +10,7 @@
 
 #include "daw_signed_clanggcc.h"
 #include "daw_signed_msvc.h"
+#include "daw_signed_simd.h"
 
 #include <daw/daw_cpp_feature_check.h>
 #include <daw/daw_int_cmp.h>
@@ -169,6 +170,156 @@ namespace daw::integers::sint_impl {
 		}
 	} sat_mul{ };
 
+	/// @brief Replace value with saturated when overflow is set, with masks
+	/// instead of a branch.  A plain ternary here is turned back into a jump
+	/// by gcc
+	template<typename T>
+	DAW_ATTRIB_INLINE constexpr T select_saturated( bool overflow, T value,
+	                                                T saturated ) noexcept {
+		using unsigned_t = std::make_unsigned_t<T>;
+		auto const mask =
+		  static_cast<unsigned_t>( unsigned_t{ 0 } - unsigned_t{ overflow } );
+		return static_cast<T>(
+		  ( static_cast<unsigned_t>( value ) & static_cast<unsigned_t>( ~mask ) ) |
+		  ( static_cast<unsigned_t>( saturated ) & mask ) );
+	}
+
+	/// @brief All ones when v is negative, otherwise 0
+	template<typename T>
+	DAW_ATTRIB_INLINE constexpr T sign_mask( T v ) noexcept {
+		return static_cast<T>( v >> ( sizeof( T ) * 8U - 1U ) );
+	}
+
+	// The branch free forms compute the wrapped result and the saturated
+	// value every time and select between them.  They cost the same whether
+	// or not the operation overflows, which wins over sat_add/sat_sub/sat_mul
+	// when overflow is frequent and unpredictable
+	inline constexpr struct {
+		template<typename T,
+		         std::enable_if_t<is_valid_int_type<T>, std::nullptr_t> = nullptr>
+		DAW_ATTRIB_INLINE DAW_CPP23_STATIC_CALL_OP constexpr T
+		operator( )( T lhs, T rhs ) DAW_CPP23_STATIC_CALL_OP_CONST {
+			auto result = T{ };
+			bool const overflow = wrapping_add( lhs, rhs, result );
+			// min( ) when rhs is negative, otherwise max( )
+			auto const saturated = static_cast<T>(
+			  sign_mask( rhs ) ^ daw::numeric_limits<T>::max( ) );
+			return select_saturated( overflow, result, saturated );
+		}
+	} sat_add_branchless{ };
+
+	inline constexpr struct {
+		template<typename T,
+		         std::enable_if_t<is_valid_int_type<T>, std::nullptr_t> = nullptr>
+		DAW_ATTRIB_INLINE DAW_CPP23_STATIC_CALL_OP constexpr T
+		operator( )( T lhs, T rhs ) DAW_CPP23_STATIC_CALL_OP_CONST {
+			auto result = T{ };
+			bool const overflow = wrapping_sub( lhs, rhs, result );
+			// max( ) when rhs is negative, otherwise min( )
+			auto const saturated = static_cast<T>(
+			  static_cast<T>( ~sign_mask( rhs ) ) ^ daw::numeric_limits<T>::max( ) );
+			return select_saturated( overflow, result, saturated );
+		}
+	} sat_sub_branchless{ };
+
+	inline constexpr struct {
+		template<typename T,
+		         std::enable_if_t<is_valid_int_type<T>, std::nullptr_t> = nullptr>
+		DAW_ATTRIB_INLINE DAW_CPP23_STATIC_CALL_OP constexpr T
+		operator( )( T lhs, T rhs ) DAW_CPP23_STATIC_CALL_OP_CONST {
+			auto result = T{ };
+			bool const overflow = wrapping_mul( lhs, rhs, result );
+			// max( ) when the signs match, otherwise min( )
+			auto const saturated =
+			  static_cast<T>( sign_mask( static_cast<T>( lhs ^ rhs ) ) ^
+			                  daw::numeric_limits<T>::max( ) );
+			return select_saturated( overflow, result, saturated );
+		}
+	} sat_mul_branchless{ };
+
+	// Shifting left saturates to min( ) or max( ), by the sign of lhs, when a
+	// significant bit would be shifted out.  Counts of at least the bit width
+	// saturate any non-zero value and a negative count is an overflow
+	inline constexpr struct {
+		template<typename T,
+		         std::enable_if_t<is_valid_int_type<T>, std::nullptr_t> = nullptr>
+		DAW_ATTRIB_INLINE DAW_CPP23_STATIC_CALL_OP constexpr T
+		operator( )( T lhs, T rhs ) DAW_CPP23_STATIC_CALL_OP_CONST {
+			using unsigned_t = std::make_unsigned_t<T>;
+			constexpr auto bits = static_cast<T>( sizeof( T ) * 8U );
+			if( DAW_UNLIKELY( rhs < 0 ) ) {
+				DAW_UNLIKELY_BRANCH
+				on_signed_integer_overflow( );
+				return lhs;
+			}
+			// Only 0 and -1 survive a shift of bits - 1, becoming 0 and min( ),
+			// so larger counts can be clamped to it
+			auto const count = rhs < bits ? rhs : static_cast<T>( bits - 1 );
+			if( count > count_redundant_sign_bits( lhs ) ) {
+				return static_cast<T>( sign_mask( lhs ) ^
+				                       daw::numeric_limits<T>::max( ) );
+			}
+			return static_cast<T>( static_cast<unsigned_t>( lhs ) << count );
+		}
+	} sat_shl{ };
+
+	/// @brief Gather the bits of value selected by mask into the low bits of
+	/// the result, in order.  This is pext on BMI2
+	template<typename Unsigned,
+	         std::enable_if_t<std::is_unsigned_v<Unsigned>, std::nullptr_t> =
+	           nullptr>
+	DAW_ATTRIB_INLINE constexpr Unsigned extract_bits( Unsigned value,
+	                                                   Unsigned mask ) noexcept {
+#if defined( DAW_INTEGERS_HAS_BMI2 ) and \
+  ( defined( __clang__ ) or defined( __GNUC__ ) )
+		if( not __builtin_is_constant_evaluated( ) ) {
+			if constexpr( sizeof( Unsigned ) <= sizeof( std::uint32_t ) ) {
+				return static_cast<Unsigned>( _pext_u32( value, mask ) );
+			} else {
+				return static_cast<Unsigned>( _pext_u64( value, mask ) );
+			}
+		}
+#endif
+		auto result = Unsigned{ 0 };
+		for( auto bit = Unsigned{ 1 }; mask != 0;
+		     bit = static_cast<Unsigned>( bit << 1U ) ) {
+			if( ( value & mask & static_cast<Unsigned>( -mask ) ) != 0 ) {
+				result = static_cast<Unsigned>( result | bit );
+			}
+			mask = static_cast<Unsigned>( mask & ( mask - 1U ) );
+		}
+		return result;
+	}
+
+	/// @brief Scatter the low bits of value, in order, to the positions set in
+	/// mask.  This is pdep on BMI2
+	template<typename Unsigned,
+	         std::enable_if_t<std::is_unsigned_v<Unsigned>, std::nullptr_t> =
+	           nullptr>
+	DAW_ATTRIB_INLINE constexpr Unsigned deposit_bits( Unsigned value,
+	                                                   Unsigned mask ) noexcept {
+#if defined( DAW_INTEGERS_HAS_BMI2 ) and \
+  ( defined( __clang__ ) or defined( __GNUC__ ) )
+		if( not __builtin_is_constant_evaluated( ) ) {
+			if constexpr( sizeof( Unsigned ) <= sizeof( std::uint32_t ) ) {
+				return static_cast<Unsigned>( _pdep_u32( value, mask ) );
+			} else {
+				return static_cast<Unsigned>( _pdep_u64( value, mask ) );
+			}
+		}
+#endif
+		auto result = Unsigned{ 0 };
+		for( auto bit = Unsigned{ 1 }; mask != 0;
+		     bit = static_cast<Unsigned>( bit << 1U ) ) {
+			auto const lowest = static_cast<Unsigned>( mask & -mask );
+			if( ( value & bit ) != 0 ) {
+				result = static_cast<Unsigned>( result | lowest );
+			}
+			mask = static_cast<Unsigned>( mask ^ lowest );
+		}
+		return result;
+	}
+
 	inline constexpr struct {
 		template<typename T,
 		         std::enable_if_t<is_valid_int_type<T>, std::nullptr_t> = nullptr>
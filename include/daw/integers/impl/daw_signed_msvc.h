@@ -193,20 +193,49 @@ namespace daw::integers::sint_impl {
 			}
 		} checked_rem{ };
 
+		/// @brief The number of bits after the sign bit that are equal to it.
+		/// lhs << k keeps every significant bit exactly when k is not larger than
+		/// this
+		template<typename T,
+		         std::enable_if_t<is_valid_int_type<T>, std::nullptr_t> = nullptr>
+		DAW_ATTRIB_INLINE constexpr int count_redundant_sign_bits( T value ) {
+			using unsigned_t = std::make_unsigned_t<T>;
+			constexpr int bits = static_cast<int>( sizeof( T ) * CHAR_BIT );
+			// Clear the sign copies so that counting leading zeros counts them
+			auto v = static_cast<unsigned_t>(
+			  static_cast<unsigned_t>( value ) ^
+			  static_cast<unsigned_t>( value >> ( bits - 1 ) ) );
+			int leading_zeros = bits;
+			for( int shift = bits / 2; shift != 0; shift /= 2 ) {
+				if( static_cast<unsigned_t>( v >> shift ) != 0 ) {
+					leading_zeros -= shift;
+					v = static_cast<unsigned_t>( v >> shift );
+				}
+			}
+			return leading_zeros - static_cast<int>( v ) - 1;
+		}
+
+		/// Shifting left reports overflow when a significant bit, including the
+		/// sign, is shifted out or the count is outside of [0, bits).  The result
+		/// is the wrapped value
 		inline constexpr struct checked_shl_t {
 			explicit checked_shl_t( ) = default;
 
 			template<typename T,
 			         std::enable_if_t<is_valid_int_type<T>, std::nullptr_t> = nullptr>
 			DAW_ATTRIB_INLINE constexpr T operator( )( T lhs, T rhs ) const {
-				if( DAW_UNLIKELY( rhs == 0 ) ) {
+				using unsigned_t = std::make_unsigned_t<T>;
+				if( DAW_UNLIKELY( static_cast<unsigned_t>( rhs ) >=
+				                  sizeof( T ) * CHAR_BIT ) ) {
 					on_signed_integer_overflow( );
-					return lhs;
-				} else if( DAW_UNLIKELY( rhs >= ( sizeof( rhs ) * CHAR_BIT ) ) ) {
+					return T{ 0 };
+				}
+				auto const result =
+				  static_cast<T>( static_cast<unsigned_t>( lhs ) << rhs );
+				if( DAW_UNLIKELY( rhs > count_redundant_sign_bits( lhs ) ) ) {
 					on_signed_integer_overflow( );
-					return lhs << ( sizeof( T ) * CHAR_BIT - 1 );
 				}
-				return lhs << rhs;
+				return result;
 			}
 		} checked_shl{ };
 
@@ -216,14 +245,13 @@ namespace daw::integers::sint_impl {
 			template<typename T,
 			         std::enable_if_t<is_valid_int_type<T>, std::nullptr_t> = nullptr>
 			DAW_ATTRIB_INLINE constexpr T operator( )( T lhs, T rhs ) const {
-				if( DAW_UNLIKELY( rhs == 0 ) ) {
-					on_signed_integer_overflow( );
-					return lhs;
-				} else if( DAW_UNLIKELY( rhs >= ( sizeof( rhs ) * CHAR_BIT ) ) ) {
+				using unsigned_t = std::make_unsigned_t<T>;
+				if( DAW_UNLIKELY( static_cast<unsigned_t>( rhs ) >=
+				                  sizeof( T ) * CHAR_BIT ) ) {
 					on_signed_integer_overflow( );
-					return lhs >> ( sizeof( T ) * CHAR_BIT - 1 );
+					return static_cast<T>( lhs >> ( sizeof( T ) * CHAR_BIT - 1 ) );
 				}
-				return lhs >> rhs;
+				return static_cast<T>( lhs >> rhs );
 			}
 		} checked_shr{ };
 	} // namespace
@@ -0,0 +1,60 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include "../daw_signed.h"
+
+#include <daw/daw_attributes.h>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace daw::integers::sint_impl {
+	template<typename, typename = void>
+	inline constexpr bool is_contiguous_range_v = false;
+
+	/// @brief Any type with std::data/std::size, e.g. std::span, daw::span,
+	/// std::vector, std::array, or a C array
+	template<typename Range>
+	inline constexpr bool is_contiguous_range_v<
+	  Range, std::void_t<decltype( std::data( std::declval<Range &>( ) ) ),
+	                     decltype( std::size( std::declval<Range &>( ) ) )>> =
+	  true;
+
+	template<typename Range>
+	using range_value_t = std::remove_cv_t<std::remove_reference_t<
+	  decltype( *std::data( std::declval<Range &>( ) ) )>>;
+
+	template<typename>
+	inline constexpr bool is_signed_integer_v = false;
+
+	template<std::size_t Bits>
+	inline constexpr bool is_signed_integer_v<signed_integer<Bits>> = true;
+
+	/// @brief View an array of signed_integer as the underlying integer type.
+	/// signed_integer is standard layout and holds only its value so the two
+	/// share a representation
+	template<std::size_t Bits>
+	DAW_ATTRIB_INLINE signed_integer_type_t<Bits> const *
+	raw_ptr( signed_integer<Bits> const *ptr ) noexcept {
+		static_assert( sizeof( signed_integer<Bits> ) ==
+		               sizeof( signed_integer_type_t<Bits> ) );
+		return reinterpret_cast<signed_integer_type_t<Bits> const *>( ptr );
+	}
+
+	template<std::size_t Bits>
+	DAW_ATTRIB_INLINE signed_integer_type_t<Bits> *
+	raw_ptr( signed_integer<Bits> *ptr ) noexcept {
+		static_assert( sizeof( signed_integer<Bits> ) ==
+		               sizeof( signed_integer_type_t<Bits> ) );
+		return reinterpret_cast<signed_integer_type_t<Bits> *>( ptr );
+	}
+} // namespace daw::integers::sint_impl
@@ -0,0 +1,105 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include <daw/daw_attributes.h>
+#include <daw/daw_cpp_feature_check.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/// \brief The span kernels select an instruction set at compile time from the
+/// target flags(e.g. -march=native or /arch:AVX2).  Defining
+/// DAW_INTEGERS_NO_SIMD forces the portable code paths
+#if not defined( DAW_INTEGERS_NO_SIMD )
+#if defined( __SSE4_1__ ) or defined( __AVX__ )
+#define DAW_INTEGERS_HAS_SSE41
+#endif
+#if defined( __AVX2__ )
+#define DAW_INTEGERS_HAS_AVX2
+#endif
+#if defined( __BMI2__ )
+#define DAW_INTEGERS_HAS_BMI2
+#endif
+#if defined( __AVX512F__ )
+#define DAW_INTEGERS_HAS_AVX512F
+#endif
+#if defined( __AVX512BW__ )
+#define DAW_INTEGERS_HAS_AVX512BW
+#endif
+#if defined( __AVX512DQ__ )
+#define DAW_INTEGERS_HAS_AVX512DQ
+#endif
+#if defined( __AVX512VL__ )
+#define DAW_INTEGERS_HAS_AVX512VL
+#endif
+#if defined( __AVX512VNNI__ ) and defined( __AVX512VL__ )
+#define DAW_INTEGERS_HAS_AVX512VNNI
+#endif
+#if defined( __AVXVNNI__ )
+#define DAW_INTEGERS_HAS_AVXVNNI
+#endif
+#if defined( DAW_INTEGERS_HAS_AVX512VNNI ) or \
+  defined( DAW_INTEGERS_HAS_AVXVNNI )
+#define DAW_INTEGERS_HAS_VNNI
+#endif
+#if defined( __ARM_NEON ) or defined( __ARM_NEON__ )
+#define DAW_INTEGERS_HAS_NEON
+#endif
+#endif
+
+#if defined( DAW_INTEGERS_HAS_SSE41 ) or defined( DAW_INTEGERS_HAS_AVX2 ) or \
+  defined( DAW_INTEGERS_HAS_AVX512F ) or defined( DAW_INTEGERS_HAS_BMI2 )
+#include <immintrin.h>
+#endif
+#if defined( DAW_INTEGERS_HAS_NEON )
+#include <arm_neon.h>
+#endif
+#if defined( _MSC_VER ) and not defined( __clang__ ) and \
+  ( defined( _M_X64 ) or defined( _M_IX86 ) )
+#include <intrin.h>
+#endif
+
+namespace daw::integers::sint_impl {
+	/// @brief Hint that the cache line holding ptr will be read soon
+	template<typename T>
+	DAW_ATTRIB_INLINE void prefetch_read( T const *ptr ) noexcept {
+#if defined( __clang__ ) or defined( __GNUC__ )
+		__builtin_prefetch( ptr, 0, 3 );
+#elif defined( _MSC_VER ) and ( defined( _M_X64 ) or defined( _M_IX86 ) )
+		_mm_prefetch( reinterpret_cast<char const *>( ptr ), _MM_HINT_T0 );
+#else
+		(void)ptr;
+#endif
+	}
+
+	/// @brief Hint that the cache line holding ptr will be written soon
+	template<typename T>
+	DAW_ATTRIB_INLINE void prefetch_write( T const *ptr ) noexcept {
+#if defined( __clang__ ) or defined( __GNUC__ )
+		__builtin_prefetch( ptr, 1, 3 );
+#elif defined( _MSC_VER ) and ( defined( _M_X64 ) or defined( _M_IX86 ) )
+		_mm_prefetch( reinterpret_cast<char const *>( ptr ), _MM_HINT_T0 );
+#else
+		(void)ptr;
+#endif
+	}
+
+	DAW_ATTRIB_INLINE std::size_t popcount( std::uint32_t value ) noexcept {
+#if defined( __clang__ ) or defined( __GNUC__ )
+		return static_cast<std::size_t>( __builtin_popcount( value ) );
+#else
+		std::size_t result = 0;
+		for( ; value != 0; value &= value - 1 ) {
+			++result;
+		}
+		return result;
+#endif
+	}
+} // namespace daw::integers::sint_impl
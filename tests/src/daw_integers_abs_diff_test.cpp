@@ -0,0 +1,140 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_abs_diff.h>
+#include <daw/integers/daw_random.h>
+
+#include <daw/daw_ensure.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+auto rng = daw::integers::xoshiro256pp( 93 );
+
+template<std::size_t Bits>
+std::vector<daw::integers::signed_integer<Bits>>
+random_values( std::size_t count ) {
+	using SI = daw::integers::signed_integer<Bits>;
+	auto result = std::vector<SI>( count );
+	daw::integers::uniform_fill( rng, SI::min( ), SI::max( ), result );
+	// Include the extremes
+	if( count > 1 ) {
+		result[0] = daw::integers::signed_integer<Bits>::min( );
+		result[1] = daw::integers::signed_integer<Bits>::max( );
+	}
+	return result;
+}
+
+template<std::size_t Bits>
+void test_kernels( std::size_t count ) {
+	using namespace daw::integers;
+	auto const a = random_values<Bits>( count );
+	auto b = random_values<Bits>( count );
+	if( count > 1 ) {
+		std::swap( b[0], b[1] );
+	}
+	auto diff = std::vector<abs_diff_t<Bits>>( count );
+	auto avg = std::vector<signed_integer<Bits>>( count );
+	abs_diff( a, b, diff );
+	avg_rounded( a, b, avg );
+	std::int64_t total = 0;
+	for( std::size_t n = 0; n < count; ++n ) {
+		daw_ensure( diff[n] == a[n].abs_diff( b[n] ) );
+		if constexpr( Bits <= 32 ) {
+			std::int64_t const x = a[n].value( );
+			std::int64_t const y = b[n].value( );
+			auto const d = x < y ? y - x : x - y;
+			daw_ensure( static_cast<std::int64_t>( diff[n] ) == d );
+			auto const sum = x + y + 1;
+			daw_ensure( avg[n].value( ) == ( sum - ( sum < 0 ? 1 : 0 ) ) / 2 );
+			total += d;
+		} else {
+			// Modulo 2^64, a + b + d == 2 * max and 2 * avg - a - b is 0 or 1
+			auto const x = static_cast<std::uint64_t>( a[n].value( ) );
+			auto const y = static_cast<std::uint64_t>( b[n].value( ) );
+			auto const m = static_cast<std::uint64_t>(
+			  ( a[n] < b[n] ? b[n] : a[n] ).value( ) );
+			daw_ensure( x + y + diff[n] == 2 * m );
+			auto const r = 2 * static_cast<std::uint64_t>( avg[n].value( ) ) - x - y;
+			daw_ensure( r == 0 or r == 1 );
+		}
+	}
+	if constexpr( Bits <= 32 ) {
+		daw_ensure( sad( a, b ) == i64( total ) );
+	}
+	// In place
+	avg_rounded( a.data( ), b.data( ), count, b.data( ) );
+	daw_ensure( b == avg );
+}
+
+int main( ) try {
+	using namespace daw::integers;
+
+	static_assert( i8( 127 ).abs_diff( i8( -128 ) ) == 255 );
+	static_assert( i8( -128 ).abs_diff( i8( 127 ) ) == 255 );
+	static_assert( i32( -5 ).abs_diff( i32( -7 ) ) == 2U );
+	static_assert( i64::min( ).abs_diff( i64::max( ) ) ==
+	               daw::numeric_limits<std::uint64_t>::max( ) );
+	static_assert( i8( 127 ).avg_rounded( i8( 127 ) ) == 127 );
+	static_assert( i8( -128 ).avg_rounded( i8( -128 ) ) == -128 );
+	static_assert( i8( -128 ).avg_rounded( i8( 127 ) ) == 0 );
+	static_assert( i16( 3 ).avg_rounded( i16( 4 ) ) == 4 );
+	static_assert( i16( -3 ).avg_rounded( i16( -4 ) ) == -3 );
+	static_assert( i64::max( ).avg_rounded( i64::max( ) - i64( 1 ) ) ==
+	               i64::max( ) );
+
+	constexpr std::size_t counts[] = { 0,  1,  2,  15,  16,  17,
+	                                   31, 32, 33, 100, 1000 };
+	for( std::size_t count : counts ) {
+		test_kernels<8>( count );
+		test_kernels<16>( count );
+		test_kernels<32>( count );
+		test_kernels<64>( count );
+	}
+
+	// The largest distances over more than one block
+	{
+		auto const count = 3 * sint_impl::sad_block_size + 5;
+		auto const a = std::vector<i16>( count, i16::min( ) );
+		auto const b = std::vector<i16>( count, i16::max( ) );
+		daw_ensure( sad( a, b ) ==
+		            i64( 65535 * static_cast<std::int64_t>( count ) ) );
+		auto const c = std::vector<i8>( count, i8::max( ) );
+		auto const d = std::vector<i8>( count, i8::min( ) );
+		daw_ensure( sad( c, d ) ==
+		            i64( 255 * static_cast<std::int64_t>( count ) ) );
+	}
+
+	bool has_overflow = false;
+	bool has_out_of_range = false;
+	auto const error_handler = [&]( SignedIntegerErrorType error_type ) {
+		switch( error_type ) {
+		case SignedIntegerErrorType::Overflow:
+			has_overflow = true;
+			break;
+		case SignedIntegerErrorType::OutOfRange:
+			has_out_of_range = true;
+			break;
+		default:
+			break;
+		}
+	};
+	register_signed_overflow_handler( error_handler );
+	register_signed_out_of_range_handler( error_handler );
+	auto const a = std::vector<i64>{ i64::min( ), i64( 0 ) };
+	auto const b = std::vector<i64>{ i64::max( ), i64( 0 ) };
+	daw_ensure( sad( a, b ) == i64::max( ) );
+	daw_ensure( has_overflow );
+	daw_ensure( sad( a, std::vector<i64>( 1 ) ) == 0 );
+	daw_ensure( has_out_of_range );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
@@ -0,0 +1,157 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_random.h>
+#include <daw/integers/daw_wide_arithmetic.h>
+
+#include <daw/daw_ensure.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+// Words of a 256 bit number, least significant first
+using u256 = std::uint64_t[4];
+
+template<typename T>
+bool add_words( T const *a, T const *b, T *out, std::size_t count ) {
+	bool carry = false;
+	for( std::size_t n = 0; n < count; ++n ) {
+		auto const r = daw::integers::add_carry( a[n], b[n], carry );
+		out[n] = r.value;
+		carry = r.carry;
+	}
+	return carry;
+}
+
+template<typename T>
+bool sub_words( T const *a, T const *b, T *out, std::size_t count ) {
+	bool borrow = false;
+	for( std::size_t n = 0; n < count; ++n ) {
+		auto const r = daw::integers::sub_borrow( a[n], b[n], borrow );
+		out[n] = r.value;
+		borrow = r.carry;
+	}
+	return borrow;
+}
+
+// Compile time evaluation takes the portable path, runtime may use adc/sbb
+constexpr auto ct_add = daw::integers::add_carry(
+  std::uint64_t{ 0xFFFF'FFFF'FFFF'FFFFULL }, std::uint64_t{ 0 }, true );
+static_assert( ct_add.value == 0 and ct_add.carry );
+constexpr auto ct_sub =
+  daw::integers::sub_borrow( std::int64_t{ 0 }, std::int64_t{ 0 }, true );
+static_assert( ct_sub.value == -1 and ct_sub.carry );
+constexpr auto ct_signed =
+  daw::integers::add_carry( daw::integers::i32( -1 ), daw::integers::i32( 1 ) );
+static_assert( ct_signed.value == 0 and ct_signed.carry );
+
+int main( ) try {
+	using namespace daw::integers;
+
+	// Every pair of 8 bit words against the 16 bit results
+	for( unsigned a = 0; a < 256; ++a ) {
+		for( unsigned b = 0; b < 256; ++b ) {
+			for( unsigned c = 0; c < 2; ++c ) {
+				auto const sum = a + b + c;
+				auto const ru = add_carry( static_cast<std::uint8_t>( a ),
+				                           static_cast<std::uint8_t>( b ), c != 0 );
+				daw_ensure( ru.value == static_cast<std::uint8_t>( sum ) );
+				daw_ensure( ru.carry == ( sum > 255 ) );
+				auto const sa = i8( static_cast<std::int8_t>( a ) );
+				auto const sb = i8( static_cast<std::int8_t>( b ) );
+				auto const rs = add_carry( sa, sb, c != 0 );
+				daw_ensure( static_cast<std::uint8_t>( rs.value.value( ) ) ==
+				            static_cast<std::uint8_t>( sum ) );
+				daw_ensure( rs.carry == ( sum > 255 ) );
+
+				auto const borrow = a < b + c;
+				auto const du = sub_borrow( static_cast<std::uint8_t>( a ),
+				                            static_cast<std::uint8_t>( b ), c != 0 );
+				daw_ensure( du.value == static_cast<std::uint8_t>( a - b - c ) );
+				daw_ensure( du.carry == borrow );
+				auto const ds = sub_borrow( sa, sb, c != 0 );
+				daw_ensure( static_cast<std::uint8_t>( ds.value.value( ) ) ==
+				            static_cast<std::uint8_t>( a - b - c ) );
+				daw_ensure( ds.carry == borrow );
+			}
+		}
+	}
+
+	// 64 bit words against the same arithmetic on 32 bit halves
+	auto rng = daw::integers::xoshiro256pp( 90 );
+	std::uint64_t const edges[] = { 0, 1, 0x7FFF'FFFF'FFFF'FFFFULL,
+	                                0x8000'0000'0000'0000ULL,
+	                                0xFFFF'FFFF'FFFF'FFFEULL,
+	                                0xFFFF'FFFF'FFFF'FFFFULL };
+	auto const check64 = [&]( std::uint64_t a, std::uint64_t b, bool c ) {
+		std::uint32_t a32[2] = { static_cast<std::uint32_t>( a ),
+		                         static_cast<std::uint32_t>( a >> 32U ) };
+		std::uint32_t b32[2] = { static_cast<std::uint32_t>( b ),
+		                         static_cast<std::uint32_t>( b >> 32U ) };
+		auto const lo = add_carry( a32[0], b32[0], c );
+		auto const hi = add_carry( a32[1], b32[1], lo.carry );
+		auto const r = add_carry( a, b, c );
+		daw_ensure( r.value == ( std::uint64_t{ hi.value } << 32U | lo.value ) );
+		daw_ensure( r.carry == hi.carry );
+		auto const rs = add_carry( i64( static_cast<std::int64_t>( a ) ),
+		                           i64( static_cast<std::int64_t>( b ) ), c );
+		daw_ensure( static_cast<std::uint64_t>( rs.value.value( ) ) == r.value );
+		daw_ensure( rs.carry == r.carry );
+
+		auto const dlo = sub_borrow( a32[0], b32[0], c );
+		auto const dhi = sub_borrow( a32[1], b32[1], dlo.carry );
+		auto const d = sub_borrow( a, b, c );
+		daw_ensure( d.value == ( std::uint64_t{ dhi.value } << 32U | dlo.value ) );
+		daw_ensure( d.carry == dhi.carry );
+		auto const ds = sub_borrow( i64( static_cast<std::int64_t>( a ) ),
+		                            i64( static_cast<std::int64_t>( b ) ), c );
+		daw_ensure( static_cast<std::uint64_t>( ds.value.value( ) ) == d.value );
+		daw_ensure( ds.carry == d.carry );
+	};
+	for( auto a : edges ) {
+		for( auto b : edges ) {
+			check64( a, b, false );
+			check64( a, b, true );
+		}
+	}
+	for( std::size_t n = 0; n < 10000; ++n ) {
+		check64( rng( ), rng( ), ( n & 1U ) != 0 );
+	}
+
+	// Multi-word: ( a + b ) - b == a, and max + 1 carries out of every word
+	for( std::size_t n = 0; n < 1000; ++n ) {
+		u256 a = { rng( ), rng( ), rng( ), rng( ) };
+		u256 b = { rng( ), rng( ), rng( ), rng( ) };
+		u256 sum{ };
+		u256 back{ };
+		auto const carry = add_words( a, b, sum, 4 );
+		auto const borrow = sub_words( sum, b, back, 4 );
+		daw_ensure( carry == borrow );
+		for( std::size_t k = 0; k < 4; ++k ) {
+			daw_ensure( back[k] == a[k] );
+		}
+	}
+	{
+		u256 max = { ~0ULL, ~0ULL, ~0ULL, ~0ULL };
+		u256 one = { 1, 0, 0, 0 };
+		u256 sum{ };
+		daw_ensure( add_words( max, one, sum, 4 ) );
+		for( auto w : sum ) {
+			daw_ensure( w == 0 );
+		}
+		u256 diff{ };
+		daw_ensure( sub_words( sum, one, diff, 4 ) );
+		for( auto w : diff ) {
+			daw_ensure( w == ~0ULL );
+		}
+	}
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
@@ -0,0 +1,107 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_signed_chrono.h>
+
+#include <daw/daw_ensure.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <ratio>
+#include <type_traits>
+
+using ms_t = std::chrono::duration<daw::i64, std::milli>;
+using us_t = std::chrono::duration<daw::i64, std::micro>;
+using ns32_t = std::chrono::duration<daw::i32, std::nano>;
+using thirds_t = std::chrono::duration<daw::i64, std::ratio<1, 3>>;
+using sevenths_t = std::chrono::duration<std::int16_t, std::ratio<1, 7>>;
+
+static_assert(
+  std::is_same_v<std::common_type_t<daw::i32, daw::i64>, daw::i64> );
+static_assert( std::is_same_v<std::common_type_t<daw::i16, std::int32_t>,
+                              daw::i32> );
+static_assert( not std::chrono::treat_as_floating_point_v<daw::i64> );
+static_assert( ms_t::zero( ).count( ) == daw::i64( 0 ) );
+static_assert( ms_t::max( ).count( ) == daw::i64::max( ) );
+
+static_assert( daw::integers::checked_duration_cast<us_t>(
+                 ms_t( daw::i64( 5 ) ) )
+                 .count( ) == daw::i64( 5000 ) );
+static_assert( daw::integers::checked_duration_cast<std::chrono::seconds>(
+                 ms_t( daw::i64( -2500 ) ) )
+                 .count( ) == -2 );
+
+int main( ) try {
+	// signed_integer reps work with the standard duration operations
+	auto const a = ms_t( daw::i64( 1500 ) ) + ms_t( daw::i64( 500 ) );
+	daw_ensure( a.count( ) == daw::i64( 2000 ) );
+	daw_ensure( ( a * daw::i64( 3 ) ).count( ) == daw::i64( 6000 ) );
+	daw_ensure( std::chrono::duration_cast<us_t>( a ).count( ) ==
+	            daw::i64( 2'000'000 ) );
+	daw_ensure( std::chrono::duration_cast<std::chrono::seconds>( a ).count( ) ==
+	            2 );
+	daw_ensure( a > ms_t( daw::i64( 1999 ) ) );
+
+	using daw::integers::checked_duration_cast;
+	daw_ensure( checked_duration_cast<thirds_t>( std::chrono::seconds( 5 ) )
+	              .count( ) == daw::i64( 15 ) );
+	daw_ensure( checked_duration_cast<sevenths_t>( thirds_t( daw::i64( 9 ) ) )
+	              .count( ) == 21 );
+	daw_ensure( checked_duration_cast<sevenths_t>( thirds_t( daw::i64( -10 ) ) )
+	              .count( ) == -23 );
+
+	bool has_overflow = false;
+	auto const error_handler =
+	  [&]( daw::integers::SignedIntegerErrorType error_type ) {
+		  if( error_type == daw::integers::SignedIntegerErrorType::Overflow ) {
+			  has_overflow = true;
+		  }
+	  };
+	daw::integers::register_signed_overflow_handler( error_handler );
+
+	// 3 seconds is 3e9ns, past i32::max( )
+	auto const ns = checked_duration_cast<ns32_t>( std::chrono::seconds( 3 ) );
+	daw_ensure( has_overflow );
+	daw_ensure( ns.count( ) == daw::i32::max( ) );
+	has_overflow = false;
+	(void)checked_duration_cast<ns32_t>( std::chrono::seconds( 2 ) );
+	daw_ensure( not has_overflow );
+
+	auto const big =
+	  std::chrono::seconds( daw::numeric_limits<std::int64_t>::min( ) / 10 );
+	auto const big_ns = checked_duration_cast<std::chrono::nanoseconds>( big );
+	daw_ensure( has_overflow );
+	daw_ensure( big_ns.count( ) == daw::numeric_limits<std::int64_t>::min( ) );
+	has_overflow = false;
+	(void)checked_duration_cast<sevenths_t>( thirds_t( daw::i64( 20'000 ) ) );
+	daw_ensure( has_overflow );
+
+	// count * num overflows, but the result fits
+	using halves_t = std::chrono::duration<daw::i64, std::ratio<1, 2>>;
+	has_overflow = false;
+	auto const halves = checked_duration_cast<halves_t>(
+	  thirds_t( daw::i64( 6'000'000'000'000'000'000 ) ) );
+	daw_ensure( not has_overflow );
+	daw_ensure( halves.count( ) == daw::i64( 4'000'000'000'000'000'000 ) );
+	daw_ensure( checked_duration_cast<halves_t>(
+	              thirds_t( daw::i64( -6'000'000'000'000'000'001 ) ) )
+	              .count( ) == daw::i64( -4'000'000'000'000'000'000 ) );
+	daw_ensure( not has_overflow );
+	(void)checked_duration_cast<std::chrono::duration<daw::i64, std::ratio<3>>>(
+	  std::chrono::duration<daw::i64, std::ratio<4, 3>>( daw::i64::max( ) ) );
+	daw_ensure( not has_overflow );
+	using fifths_t = std::chrono::duration<daw::i64, std::ratio<1, 5>>;
+	auto const fifths =
+	  checked_duration_cast<fifths_t>( thirds_t( daw::i64::min( ) ) );
+	daw_ensure( has_overflow );
+	daw_ensure( fifths.count( ) == daw::i64::min( ) );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
@@ -0,0 +1,154 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_column_encoding.h>
+
+#include <daw/daw_ensure.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+template<typename SignedInteger>
+std::vector<SignedInteger> make_column( std::size_t count, std::uint64_t seed,
+                                        std::uint64_t cardinality ) {
+	auto result = std::vector<SignedInteger>( );
+	using value_t = typename SignedInteger::value_type;
+	while( result.size( ) < count ) {
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		auto const v = static_cast<value_t>(
+		  static_cast<value_t>( ( seed >> 17U ) % cardinality ) - 3 );
+		auto const run = static_cast<std::size_t>( ( seed >> 40U ) % 100U ) + 1U;
+		for( std::size_t n = 0; n < run and result.size( ) < count; ++n ) {
+			result.push_back( SignedInteger::conversion_unchecked( v ) );
+		}
+	}
+	return result;
+}
+
+template<typename SignedInteger>
+void test_encoding( std::size_t count, std::uint64_t cardinality ) {
+	auto const values = make_column<SignedInteger>( count, 42, cardinality );
+	auto const needle = values[count / 2];
+	auto const expected_count =
+	  std::count( values.begin( ), values.end( ), needle );
+	auto expected_sum = daw::i64( 0 );
+	for( auto v : values ) {
+		expected_sum += daw::i64( v );
+	}
+
+	auto const runs = daw::integers::rle_encode( values );
+	for( std::size_t n = 1; n < runs.size( ); ++n ) {
+		daw_ensure( runs[n].value != runs[n - 1].value );
+	}
+	daw_ensure( daw::integers::rle_decoded_size( runs.data( ), runs.size( ) ) ==
+	            daw::i64( count ) );
+	daw_ensure( daw::integers::rle_count_equal( runs.data( ), runs.size( ),
+	                                            needle ) ==
+	            daw::i64( expected_count ) );
+	daw_ensure( daw::integers::rle_sum( runs.data( ), runs.size( ) ) ==
+	            expected_sum );
+	auto decoded = std::vector<SignedInteger>( count );
+	daw_ensure( daw::integers::rle_decode( runs, decoded ) == count );
+	daw_ensure( decoded == values );
+
+	auto const column = daw::integers::dictionary_encode( values );
+	daw_ensure( column.size( ) == count );
+	daw_ensure( column.sum( ) == expected_sum );
+	daw_ensure( column.dictionary.size( ) <= cardinality );
+	daw_ensure( column.count_equal( needle ) ==
+	            static_cast<std::size_t>( expected_count ) );
+	std::fill( decoded.begin( ), decoded.end( ), SignedInteger( 0 ) );
+	daw_ensure( column.decode( decoded ) == count );
+	daw_ensure( decoded == values );
+}
+
+int main( ) try {
+	test_encoding<daw::i16>( 100'000, 5 );
+	test_encoding<daw::i16>( 1'000, 1000 );
+	test_encoding<daw::i32>( 100'000, 17 );
+	test_encoding<daw::i32>( 33, 2 );
+
+	bool has_out_of_range = false;
+	bool has_overflow = false;
+	auto const error_handler =
+	  [&]( daw::integers::SignedIntegerErrorType error_type ) {
+		  if( error_type == daw::integers::SignedIntegerErrorType::OutOfRange ) {
+			  has_out_of_range = true;
+		  } else if( error_type ==
+		             daw::integers::SignedIntegerErrorType::Overflow ) {
+			  has_overflow = true;
+		  }
+	  };
+	daw::integers::register_signed_out_of_range_handler( error_handler );
+	daw::integers::register_signed_overflow_handler( error_handler );
+
+	// Long runs sum without overflow, non-positive lengths are rejected
+	auto hostile = std::vector<daw::integers::rle_run<32>>(
+	  5, { daw::i32( 1 ), daw::i32::max( ) } );
+	(void)daw::integers::rle_decoded_size( hostile.data( ), hostile.size( ) );
+	daw_ensure( not has_overflow );
+	hostile[2].length = daw::i32( -1 );
+	auto out = std::vector<daw::i32>( 10 );
+	daw_ensure( daw::integers::rle_decode( hostile.data( ), 3, out.data( ),
+	                                       out.size( ) ) == 0 );
+	daw_ensure( has_out_of_range );
+	has_out_of_range = false;
+	daw_ensure( daw::integers::rle_decode( hostile, out ) == 0 );
+	daw_ensure( has_out_of_range );
+	// Queries on the encoded form reject the same runs
+	has_out_of_range = false;
+	daw_ensure( daw::integers::rle_decoded_size( hostile.data( ),
+	                                             hostile.size( ) ) == 0 );
+	daw_ensure( has_out_of_range );
+	has_out_of_range = false;
+	hostile[2].length = daw::i32( 0 );
+	daw_ensure( daw::integers::rle_count_equal( hostile.data( ), hostile.size( ),
+	                                            daw::i32( 1 ) ) == 0 );
+	daw_ensure( has_out_of_range );
+	has_out_of_range = false;
+	daw_ensure( daw::integers::rle_sum( hostile.data( ), 3 ) == 0 );
+	daw_ensure( has_out_of_range );
+	has_out_of_range = false;
+	daw_ensure( daw::integers::rle_sum( hostile.data( ), 2 ) ==
+	            daw::i64( 2 ) * daw::i64( daw::i32::max( ) ) );
+	daw_ensure( not has_out_of_range );
+
+	// Codes past the end of the dictionary are rejected before any use
+	auto small = daw::integers::dictionary_encode(
+	  std::vector<daw::i32>{ daw::i32( 4 ), daw::i32( -2 ), daw::i32( 4 ) } );
+	daw_ensure( small.is_valid( ) );
+	daw_ensure( small.sum( ) == daw::i64( 6 ) );
+	small.codes.push_back( 500 );
+	daw_ensure( not small.is_valid( ) );
+	daw_ensure( has_out_of_range );
+	has_out_of_range = false;
+	daw_ensure( small.sum( ) == daw::i64( 0 ) );
+	daw_ensure( has_out_of_range );
+	has_out_of_range = false;
+	std::fill( out.begin( ), out.end( ), daw::i32( 7 ) );
+	daw_ensure( small.decode( out ) == 0 );
+	daw_ensure( has_out_of_range );
+	daw_ensure( std::all_of( out.begin( ), out.end( ),
+	                         []( daw::i32 v ) { return v == daw::i32( 7 ); } ) );
+	has_out_of_range = false;
+
+	// More distinct values than an 8 bit code can hold
+	auto wide = std::vector<daw::i16>( );
+	for( int n = 0; n < 300; ++n ) {
+		wide.push_back( daw::i16( n ) );
+	}
+	auto const column = daw::integers::dictionary_encode<std::uint8_t>( wide );
+	daw_ensure( has_overflow );
+	daw_ensure( column.dictionary.size( ) == 256 );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
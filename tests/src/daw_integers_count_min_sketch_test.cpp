@@ -0,0 +1,87 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_count_min_sketch.h>
+
+#include <daw/daw_ensure.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <vector>
+
+template<std::size_t CounterBits>
+void test_sketch( daw::integers::count_min_update update ) {
+	using counter_t = daw::integers::signed_integer<CounterBits>;
+	auto sketch = daw::integers::count_min_sketch<CounterBits>( 1024, 4, update );
+	daw_ensure( sketch.width( ) == 1024 );
+	daw_ensure( sketch.depth( ) == 4 );
+
+	auto keys = std::vector<daw::i64>( );
+	auto exact = std::map<daw::i64, std::int64_t>( );
+	std::uint64_t seed = 7;
+	for( std::size_t n = 0; n < 20'000; ++n ) {
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		// Skewed so that a few keys are hot
+		auto const key = daw::i64( static_cast<std::int64_t>(
+		  ( ( seed >> 33U ) % 500U ) * ( ( seed >> 20U ) % 500U ) / 500U ) );
+		keys.push_back( key );
+		++exact[key];
+	}
+	sketch.increment( keys );
+	for( auto const &[key, count] : exact ) {
+		auto const est = sketch.estimate( key );
+		// Never an under estimate, up to saturation
+		daw_ensure( est == counter_t::max( ) or
+		            static_cast<std::int64_t>( est.value( ) ) >= count );
+	}
+	// Saturation instead of wrapping
+	for( int n = 0; n < 100; ++n ) {
+		sketch.increment( daw::i32( -5 ), counter_t::max( ) );
+	}
+	daw_ensure( sketch.estimate( daw::i32( -5 ) ) == counter_t::max( ) );
+	sketch.clear( );
+	daw_ensure( sketch.estimate( daw::i32( -5 ) ) == counter_t( 0 ) );
+	// Equal keys of different widths are the same key
+	sketch.increment( daw::i32( -5 ), counter_t( 100 ) );
+	sketch.increment( daw::i8( -7 ), counter_t( 3 ) );
+	daw_ensure( sketch.estimate( daw::i64( -5 ) ) == counter_t( 100 ) );
+	daw_ensure( sketch.estimate( daw::i16( -5 ) ) == counter_t( 100 ) );
+	daw_ensure( sketch.estimate( daw::i64( -7 ) ) >= counter_t( 3 ) );
+	daw_ensure( sketch.estimate( daw::i32( -7 ) ) ==
+	            sketch.estimate( daw::i8( -7 ) ) );
+}
+
+int main( ) try {
+	using daw::integers::count_min_update;
+	test_sketch<8>( count_min_update::standard );
+	test_sketch<8>( count_min_update::conservative );
+	test_sketch<16>( count_min_update::standard );
+	test_sketch<16>( count_min_update::conservative );
+	test_sketch<32>( count_min_update::conservative );
+
+	bool has_out_of_range = false;
+	auto const error_handler =
+	  [&]( daw::integers::SignedIntegerErrorType error_type ) {
+		  if( error_type == daw::integers::SignedIntegerErrorType::OutOfRange ) {
+			  has_out_of_range = true;
+		  }
+	  };
+	daw::integers::register_signed_out_of_range_handler( error_handler );
+	auto sketch = daw::integers::count_min_sketch<16>( 100, 0 );
+	daw_ensure( has_out_of_range );
+	daw_ensure( sketch.depth( ) == 1 );
+	daw_ensure( sketch.width( ) == 128 );
+	has_out_of_range = false;
+	sketch.increment( daw::i64( 1 ), daw::i16( -1 ) );
+	daw_ensure( has_out_of_range );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
@@ -0,0 +1,204 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_signed_division.h>
+
+#include <daw/daw_ensure.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+// Reference results from exact double division, the values tested fit in
+// a double's mantissa
+template<typename SignedInteger>
+void check_division( std::int64_t a, std::int64_t b ) {
+	using value_t = typename SignedInteger::value_type;
+	auto const lhs = SignedInteger( static_cast<value_t>( a ) );
+	auto const rhs = SignedInteger( static_cast<value_t>( b ) );
+	auto const q = static_cast<double>( a ) / static_cast<double>( b );
+	auto const floor_q = static_cast<std::int64_t>( std::floor( q ) );
+	auto const ceil_q = static_cast<std::int64_t>( std::ceil( q ) );
+	auto const euclid_q = b > 0 ? floor_q : ceil_q;
+	daw_ensure( daw::integers::div_floor( lhs, rhs ).value( ) == floor_q );
+	daw_ensure( daw::integers::div_ceil( lhs, rhs ).value( ) == ceil_q );
+	daw_ensure( daw::integers::div_euclid( lhs, rhs ).value( ) == euclid_q );
+	daw_ensure( daw::integers::rem_euclid( lhs, rhs ).value( ) ==
+	            a - euclid_q * b );
+}
+
+template<typename SignedInteger>
+void check_alignment( std::int64_t v, std::int64_t a ) {
+	using value_t = typename SignedInteger::value_type;
+	auto const value = SignedInteger( static_cast<value_t>( v ) );
+	auto const alignment = SignedInteger( static_cast<value_t>( a ) );
+	auto const q = static_cast<double>( v ) / static_cast<double>( a );
+	auto const down = static_cast<std::int64_t>( std::floor( q ) ) * a;
+	auto const up = static_cast<std::int64_t>( std::ceil( q ) ) * a;
+	using limits = daw::numeric_limits<value_t>;
+	if( down >= limits::min( ) ) {
+		daw_ensure( daw::integers::align_down( value, alignment ).value( ) ==
+		            down );
+	}
+	if( up <= limits::max( ) ) {
+		daw_ensure( daw::integers::align_up( value, alignment ).value( ) == up );
+	}
+}
+
+// The compile time divisor forms must agree with the runtime ones
+template<auto Divisor, typename SignedInteger>
+void check_constant( SignedInteger lhs ) {
+	using value_t = typename SignedInteger::value_type;
+	auto const rhs = SignedInteger( static_cast<value_t>( Divisor ) );
+	daw_ensure( daw::integers::div_floor<Divisor>( lhs ) ==
+	            daw::integers::div_floor( lhs, rhs ) );
+	daw_ensure( daw::integers::div_ceil<Divisor>( lhs ) ==
+	            daw::integers::div_ceil( lhs, rhs ) );
+	daw_ensure( daw::integers::div_euclid<Divisor>( lhs ) ==
+	            daw::integers::div_euclid( lhs, rhs ) );
+	daw_ensure( daw::integers::rem_euclid<Divisor>( lhs ) ==
+	            daw::integers::rem_euclid( lhs, rhs ) );
+	if constexpr( Divisor > 0 ) {
+		using limits = daw::numeric_limits<value_t>;
+		auto const v = static_cast<std::int64_t>( lhs.value( ) );
+		if( v >= static_cast<std::int64_t>( limits::min( ) ) + ( Divisor - 1 ) ) {
+			daw_ensure( daw::integers::align_down<Divisor>( lhs ) ==
+			            daw::integers::align_down( lhs, rhs ) );
+		}
+		if( v <= static_cast<std::int64_t>( limits::max( ) ) - ( Divisor - 1 ) ) {
+			daw_ensure( daw::integers::align_up<Divisor>( lhs ) ==
+			            daw::integers::align_up( lhs, rhs ) );
+		}
+	}
+}
+
+template<typename SignedInteger>
+void check_constants( SignedInteger lhs ) {
+	check_constant<1>( lhs );
+	check_constant<2>( lhs );
+	check_constant<3>( lhs );
+	check_constant<8>( lhs );
+	check_constant<64>( lhs );
+	check_constant<-4>( lhs );
+	check_constant<-7>( lhs );
+}
+
+int main( ) try {
+	using namespace daw::integers;
+
+	// Every pair of i8 values except the exceptional divisions
+	for( std::int64_t a = -128; a <= 127; ++a ) {
+		for( std::int64_t b = -128; b <= 127; ++b ) {
+			if( b == 0 or ( a == -128 and b == -1 ) ) {
+				continue;
+			}
+			check_division<i8>( a, b );
+			if( b > 0 ) {
+				check_alignment<i8>( a, b );
+			}
+		}
+		check_constants( i8( static_cast<std::int8_t>( a ) ) );
+	}
+
+	// Wider types around zero and the limits
+	std::int64_t const i32_values[] = {
+	  -2147483647LL - 1, -2147483647LL, -1'000'003, -4097, -4096, -4095, -1, 0,
+	  1, 4095, 4096, 4097, 1'000'003, 2147483646LL, 2147483647LL };
+	for( auto a : i32_values ) {
+		for( auto b : i32_values ) {
+			if( b == 0 or ( a == -2147483647LL - 1 and b == -1 ) ) {
+				continue;
+			}
+			check_division<i32>( a, b );
+			check_division<i64>( a, b );
+			if( b > 0 ) {
+				check_alignment<i32>( a, b );
+				check_alignment<i64>( a, b );
+			}
+		}
+		check_constants( i32( static_cast<std::int32_t>( a ) ) );
+		check_constants( i64( a ) );
+	}
+	constexpr auto i64_min = daw::numeric_limits<i64>::min( );
+	constexpr auto i64_max = daw::numeric_limits<i64>::max( );
+	daw_ensure( div_floor( i64_min, i64( 3 ) ) == i64_min / i64( 3 ) - i64( 1 ) );
+	daw_ensure( div_ceil( i64_max, i64( 2 ) ) == i64_max / i64( 2 ) + i64( 1 ) );
+	daw_ensure( rem_euclid( i64_min, i64_min ) == 0 );
+	daw_ensure( rem_euclid( i64( -1 ), i64_min ) == i64_max );
+	daw_ensure( div_euclid( i64( -1 ), i64_min ) == 1 );
+	daw_ensure( align_down<4096>( i64_min ) == i64_min );
+	daw_ensure( align_down<4096>( i64( -1 ) ) == -4096 );
+	daw_ensure( align_up<4096>( i64( 1 ) ) == 4096 );
+	static_assert( div_floor<8>( i32( -9 ) ) == -2 );
+	static_assert( div_ceil<8>( i32( -9 ) ) == -1 );
+	static_assert( rem_euclid<8>( i32( -9 ) ) == 7 );
+	// Unsigned constants, the usual spelling of an alignment
+	static_assert( align_up<4096u>( i32( 1 ) ) == 4096 );
+	static_assert( align_down<4096u>( i32( -1 ) ) == -4096 );
+	static_assert( div_floor<4096ul>( i32( -1 ) ) == -1 );
+	static_assert( rem_euclid<8ull>( i64( -9 ) ) == 7 );
+	static_assert( rem_euclid( i32( -9 ), i32( -8 ) ) == 7 );
+	static_assert( div_euclid( i32( -9 ), i32( -8 ) ) == 2 );
+	static_assert( align_up( i32( 10 ), i32( 3 ) ) == 12 );
+
+	bool has_overflow = false;
+	bool has_div_by_zero = false;
+	bool has_out_of_range = false;
+	auto const error_handler = [&]( SignedIntegerErrorType error_type ) {
+		switch( error_type ) {
+		case SignedIntegerErrorType::Overflow:
+			has_overflow = true;
+			break;
+		case SignedIntegerErrorType::DivideByZero:
+			has_div_by_zero = true;
+			break;
+		case SignedIntegerErrorType::OutOfRange:
+			has_out_of_range = true;
+			break;
+		}
+	};
+	register_signed_overflow_handler( error_handler );
+	register_signed_div_by_zero_handler( error_handler );
+	register_signed_out_of_range_handler( error_handler );
+
+	auto const reset = [&] {
+		has_overflow = false;
+		has_div_by_zero = false;
+		has_out_of_range = false;
+	};
+	daw_ensure( div_floor( i32( 5 ), i32( 0 ) ) == 5 and has_div_by_zero );
+	reset( );
+	daw_ensure( rem_euclid( i32( 5 ), i32( 0 ) ) == 5 and has_div_by_zero );
+	reset( );
+	auto const i32_min = daw::numeric_limits<i32>::min( );
+	daw_ensure( div_floor( i32_min, i32( -1 ) ) == i32_min and has_overflow );
+	reset( );
+	daw_ensure( div_ceil( i32_min, i32( -1 ) ) == i32_min and has_overflow );
+	reset( );
+	daw_ensure( div_euclid( i32_min, i32( -1 ) ) == i32_min and has_overflow );
+	reset( );
+	daw_ensure( div_floor<-1>( i32_min ) == i32_min and has_overflow );
+	reset( );
+	daw_ensure( rem_euclid( i32_min, i32( -1 ) ) == 0 and not has_overflow );
+	daw_ensure( align_up( i32( 5 ), i32( 0 ) ) == 5 and has_out_of_range );
+	reset( );
+	daw_ensure( align_down( i32( 5 ), i32( -4 ) ) == 5 and has_out_of_range );
+	reset( );
+	(void)align_up( daw::numeric_limits<i32>::max( ), i32( 3 ) );
+	daw_ensure( has_overflow );
+	reset( );
+	(void)align_up<16>( daw::numeric_limits<i32>::max( ) );
+	daw_ensure( has_overflow );
+	reset( );
+	(void)align_down( i32_min, i32( 3 ) );
+	daw_ensure( has_overflow );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
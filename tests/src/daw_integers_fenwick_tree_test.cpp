@@ -0,0 +1,112 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_fenwick_tree.h>
+
+#include <daw/daw_ensure.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+template<typename SignedInteger>
+void test_fenwick( std::size_t size, std::size_t batch_size ) {
+	using value_t = typename SignedInteger::value_type;
+	auto weights = std::vector<SignedInteger>( );
+	std::uint64_t seed = 3;
+	auto const next = [&] {
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		return seed >> 33U;
+	};
+	for( std::size_t n = 0; n < size; ++n ) {
+		weights.push_back( SignedInteger( static_cast<value_t>( next( ) % 50U ) ) );
+	}
+	auto tree = daw::integers::fenwick_tree( weights );
+	daw_ensure( tree.size( ) == size );
+
+	auto const check = [&] {
+		auto sum = SignedInteger( 0 );
+		for( std::size_t n = 0; n < size; ++n ) {
+			daw_ensure( tree.prefix_sum( n ) == sum );
+			daw_ensure( tree[n] == weights[n] );
+			sum += weights[n];
+		}
+		daw_ensure( tree.prefix_sum( size ) == sum );
+		// Weights are non-negative so prefix sums are monotonic
+		for( std::size_t n = 0; n < size; n += 7 ) {
+			auto const target = tree.prefix_sum( n + 1 );
+			auto const pos = tree.lower_bound( target );
+			daw_ensure( tree.prefix_sum( pos + 1 ) >= target );
+			daw_ensure( pos == 0 or tree.prefix_sum( pos ) < target );
+		}
+		daw_ensure( tree.lower_bound( sum + SignedInteger( 1 ) ) == size );
+	};
+	check( );
+
+	for( std::size_t n = 0; n < 100; ++n ) {
+		auto const index = static_cast<std::size_t>( next( ) % size );
+		auto const delta = SignedInteger( static_cast<value_t>( next( ) % 5U ) );
+		daw_ensure( tree.add( index, delta ) );
+		weights[index] += delta;
+	}
+	check( );
+
+	auto indices = std::vector<std::size_t>( );
+	auto deltas = std::vector<SignedInteger>( );
+	for( std::size_t n = 0; n < batch_size; ++n ) {
+		indices.push_back( static_cast<std::size_t>( next( ) % size ) );
+		deltas.push_back( SignedInteger( static_cast<value_t>( next( ) % 3U ) ) );
+		weights[indices.back( )] += deltas.back( );
+	}
+	daw_ensure( tree.add( indices, deltas ) );
+	check( );
+}
+
+int main( ) try {
+	test_fenwick<daw::i64>( 1000, 10 );
+	test_fenwick<daw::i64>( 1000, 5000 );
+	test_fenwick<daw::i32>( 257, 3 );
+	test_fenwick<daw::i16>( 100, 100 );
+
+	bool has_overflow = false;
+	bool has_out_of_range = false;
+	auto const error_handler =
+	  [&]( daw::integers::SignedIntegerErrorType error_type ) {
+		  if( error_type == daw::integers::SignedIntegerErrorType::Overflow ) {
+			  has_overflow = true;
+		  } else if( error_type ==
+		             daw::integers::SignedIntegerErrorType::OutOfRange ) {
+			  has_out_of_range = true;
+		  }
+	  };
+	daw::integers::register_signed_overflow_handler( error_handler );
+	daw::integers::register_signed_out_of_range_handler( error_handler );
+
+	auto tree = daw::integers::fenwick_tree<8>( 8 );
+	daw_ensure( tree.add( 0, daw::i8( 100 ) ) );
+	daw_ensure( tree.add( 5, daw::i8( 20 ) ) );
+	// Node 8 holds the sum of all 8 weights and would overflow
+	daw_ensure( not tree.add( 6, daw::i8( 10 ) ) );
+	daw_ensure( has_overflow );
+	daw_ensure( tree[6] == daw::i8( 0 ) );
+	daw_ensure( tree.prefix_sum( 8 ) == daw::i8( 120 ) );
+
+	has_overflow = false;
+	auto const indices = std::vector<std::size_t>{ 1, 2 };
+	auto const deltas = std::vector<daw::i8>{ daw::i8( 1 ), daw::i8( 10 ) };
+	daw_ensure( not tree.add( indices, deltas ) );
+	daw_ensure( has_overflow );
+	daw_ensure( tree.prefix_sum( 8 ) == daw::i8( 120 ) );
+
+	daw_ensure( not tree.add( 8, daw::i8( 1 ) ) );
+	daw_ensure( has_out_of_range );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
@@ -0,0 +1,133 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_fir_filter.h>
+#include <daw/integers/daw_random.h>
+
+#include <daw/daw_ensure.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+using daw::integers::i16;
+using daw::integers::i32;
+
+auto rng = daw::integers::xoshiro256pp( 92 );
+
+// Values that fit in bits bits
+std::vector<i16> random_signal( std::size_t count, int bits ) {
+	auto const limit = static_cast<std::int16_t>( ( 1 << ( bits - 1 ) ) - 1 );
+	auto result = std::vector<i16>( count );
+	daw::integers::uniform_fill( rng, -i16( limit ) - i16( 1 ), i16( limit ),
+	                             result );
+	return result;
+}
+
+// The exact sum rounded, shifted and saturated
+std::vector<i16> reference( std::vector<i16> const &x,
+                            std::vector<i16> const &h, int shift ) {
+	auto result = std::vector<i16>( x.size( ) );
+	for( std::size_t n = 0; n < x.size( ); ++n ) {
+		std::int64_t acc = 0;
+		for( std::size_t j = 0; j < h.size( ) and j <= n; ++j ) {
+			acc += std::int64_t{ h[j].value( ) } * x[n - j].value( );
+		}
+		if( shift > 0 ) {
+			acc = ( acc + ( std::int64_t{ 1 } << ( shift - 1 ) ) ) >> shift;
+		}
+		result[n] = i16::conversion_saturated( acc );
+	}
+	return result;
+}
+
+void test_filter( std::size_t taps, int coefficient_bits, int shift,
+                  std::size_t count, std::size_t block ) {
+	auto const h = random_signal( taps, coefficient_bits );
+	auto const x = random_signal( count, 16 );
+	auto const expected = reference( x, h, shift );
+
+	auto y = std::vector<i16>( count );
+	daw::integers::fir_convolve( x.data( ), count, h.data( ), taps, i32( shift ),
+	                             y.data( ) );
+	daw_ensure( y == expected );
+
+	// Block by block, in place
+	auto filter = daw::integers::fir_filter( h, i32( shift ) );
+	daw_ensure( filter.taps( ) == taps );
+	y = x;
+	for( std::size_t first = 0; first < count; first += block ) {
+		auto const n = first + block < count ? block : count - first;
+		filter.process( y.data( ) + first, n, y.data( ) + first );
+	}
+	daw_ensure( y == expected );
+
+	filter.reset( );
+	auto z = std::vector<i16>( count );
+	filter.process( x, z );
+	daw_ensure( z == expected );
+}
+
+int main( ) try {
+	using namespace daw::integers;
+
+	// Small coefficients take the i32 path, large ones the i64 path
+	constexpr std::size_t tap_counts[] = { 1, 2, 3, 7, 16, 31, 64 };
+	for( std::size_t taps : tap_counts ) {
+		test_filter( taps, 8, 7, 1000, 100 );
+		test_filter( taps, 11, 12, 5000, 4097 );
+		test_filter( taps, 16, 15, 300, 17 );
+		test_filter( taps, 16, 0, 100, 1 );
+	}
+	test_filter( 255, 9, 16, 4500, 333 );
+	test_filter( 5, 12, 31, 40, 3 );
+
+	// The worst case for an i32 sum and for a single pmaddwd pair
+	{
+		auto const h = std::vector<i16>( 2, i16( -32768 ) );
+		auto const x = std::vector<i16>( 40, i16( -32768 ) );
+		auto y = std::vector<i16>( x.size( ) );
+		auto filter = fir_filter( h, i32( 15 ) );
+		filter.process( x, y );
+		daw_ensure( y[0] == 32767 );
+		daw_ensure( y[39] == 32767 );
+		daw_ensure( y == reference( x, h, 15 ) );
+		filter = fir_filter( h, i32( 17 ) );
+		filter.process( x, y );
+		daw_ensure( y[0] == 8192 and y[39] == 16384 );
+	}
+	{
+		// A Q15 moving average of 32 samples, a sum of exactly 2^15
+		auto const h = std::vector<i16>( 32, i16( 1024 ) );
+		auto const x = std::vector<i16>( 100, i16( 32767 ) );
+		auto y = std::vector<i16>( x.size( ) );
+		fir_convolve( x.data( ), x.size( ), h.data( ), h.size( ), i32( 15 ),
+		              y.data( ) );
+		daw_ensure( y[0] == 1024 );
+		daw_ensure( y[99] == 32767 );
+		daw_ensure( y == reference( x, h, 15 ) );
+	}
+
+	bool has_out_of_range = false;
+	auto const error_handler = [&]( SignedIntegerErrorType error_type ) {
+		if( error_type == SignedIntegerErrorType::OutOfRange ) {
+			has_out_of_range = true;
+		}
+	};
+	register_signed_out_of_range_handler( error_handler );
+	auto const h = std::vector<i16>{ i16( 1 ) };
+	(void)fir_filter( h, i32( 32 ) );
+	daw_ensure( has_out_of_range );
+	has_out_of_range = false;
+	(void)fir_filter( h.data( ), 0, i32( 0 ) );
+	daw_ensure( has_out_of_range );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
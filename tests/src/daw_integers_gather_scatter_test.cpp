@@ -0,0 +1,127 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_gather_scatter.h>
+
+#include <daw/daw_ensure.h>
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+using namespace daw::integers::literals;
+
+struct three_ints {
+	std::int32_t a;
+	std::int32_t b;
+	std::int32_t c;
+};
+
+int main( ) try {
+	bool has_out_of_range = false;
+	auto const error_handler =
+	  [&]( daw::integers::SignedIntegerErrorType error_type ) {
+		  if( error_type == daw::integers::SignedIntegerErrorType::OutOfRange ) {
+			  has_out_of_range = true;
+		  }
+	  };
+	daw::integers::register_signed_out_of_range_handler( error_handler );
+
+	auto data32 = std::vector<daw::i32>( );
+	auto data64 = std::vector<daw::i64>( );
+	auto data3 = std::vector<three_ints>( );
+	for( std::int32_t n = 0; n < 2000; ++n ) {
+		data32.push_back( daw::i32( n * 3 ) );
+		data64.push_back( daw::i64( n ) * 1'000'000'000'000_i64 );
+		data3.push_back( three_ints{ n, -n, n * 2 } );
+	}
+	auto idx = std::vector<daw::i32>( );
+	for( std::int32_t n = 0; n < 1500; ++n ) {
+		idx.push_back( daw::i32( ( n * 7919 ) % 2000 ) );
+	}
+	{
+		auto out = std::vector<daw::i32>( idx.size( ) );
+		auto const count = daw::integers::gather_checked( data32, idx, out );
+		daw_ensure( count == idx.size( ) );
+		daw_ensure( not has_out_of_range );
+		for( std::size_t n = 0; n < idx.size( ); ++n ) {
+			daw_ensure( out[n] == data32[static_cast<std::size_t>( idx[n] )] );
+		}
+	}
+	{
+		auto out = std::vector<daw::i64>( idx.size( ) );
+		auto const count = daw::integers::gather_checked( data64, idx, out, 0 );
+		daw_ensure( count == idx.size( ) );
+		for( std::size_t n = 0; n < idx.size( ); ++n ) {
+			daw_ensure( out[n] == data64[static_cast<std::size_t>( idx[n] )] );
+		}
+	}
+	{
+		auto out = std::vector<three_ints>( idx.size( ) );
+		auto const count = daw::integers::gather_checked( data3, idx, out );
+		daw_ensure( count == idx.size( ) );
+		for( std::size_t n = 0; n < idx.size( ); ++n ) {
+			daw_ensure( out[n].b == -idx[n] );
+		}
+	}
+	{
+		auto bad_idx = idx;
+		bad_idx[1000] = 2000_i32;
+		auto out = std::vector<daw::i32>( bad_idx.size( ) );
+		auto const count = daw::integers::gather_checked( data32, bad_idx, out );
+		daw_ensure( has_out_of_range );
+		daw_ensure( count == 1000 );
+		daw_ensure( out[999] == data32[static_cast<std::size_t>( idx[999] )] );
+		has_out_of_range = false;
+
+		bad_idx[1000] = -1_i32;
+		(void)daw::integers::gather_checked( data32, bad_idx, out );
+		daw_ensure( has_out_of_range );
+		has_out_of_range = false;
+	}
+	{
+		auto out = std::vector<daw::i32>( data32.size( ) );
+		auto src = std::vector<daw::i32>( );
+		auto perm = std::vector<daw::i32>( );
+		for( std::int32_t n = 0; n < 2000; ++n ) {
+			src.push_back( daw::i32( n ) );
+			perm.push_back( daw::i32( ( n * 7919 ) % 2000 ) );
+		}
+		auto const count = daw::integers::scatter_checked( src, perm, out );
+		daw_ensure( count == src.size( ) );
+		daw_ensure( not has_out_of_range );
+		for( std::size_t n = 0; n < src.size( ); ++n ) {
+			daw_ensure( out[static_cast<std::size_t>( perm[n] )] == src[n] );
+		}
+		perm[1999] = 2000_i32;
+		(void)daw::integers::scatter_checked( src, perm, out );
+		daw_ensure( has_out_of_range );
+		has_out_of_range = false;
+	}
+	{
+		auto out = std::vector<daw::i32>( 10 );
+		(void)daw::integers::gather_checked( data32, idx, out );
+		daw_ensure( has_out_of_range );
+		has_out_of_range = false;
+	}
+	daw::integers::register_signed_out_of_range_handler( );
+	{
+		bool has_exception = false;
+		auto bad_idx = std::vector<daw::i32>{ 0_i32, 5000_i32 };
+		auto out = std::vector<daw::i32>( bad_idx.size( ) );
+		try {
+			(void)daw::integers::gather_checked( data32, bad_idx, out );
+		} catch( daw::integers::signed_integer_out_of_range_exception const & ) {
+			has_exception = true;
+		}
+		daw_ensure( has_exception );
+	}
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
@@ -0,0 +1,232 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_geometry.h>
+#include <daw/integers/daw_random.h>
+
+#include <daw/daw_ensure.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+using daw::integers::i32;
+using daw::integers::i64;
+using daw::integers::i8;
+using daw::integers::vec2;
+using daw::integers::vec3;
+
+auto rng = daw::integers::xoshiro256pp( 94 );
+
+// A value that fits in bits bits
+i32 random_bits( int bits ) {
+	auto const limit = static_cast<std::int32_t>(
+	  ( std::int64_t{ 1 } << ( bits - 1 ) ) - 1 );
+	return daw::integers::uniform_int( rng, -i32( limit ) - i32( 1 ),
+	                                   i32( limit ) );
+}
+
+int sign( std::int64_t v ) {
+	return ( v > 0 ) - ( v < 0 );
+}
+
+// Coordinates of at most 13 bits keep every predicate within an i64
+int ref_orient2d( vec2<i32> a, vec2<i32> b, vec2<i32> c ) {
+	std::int64_t const abx = b.x.value( ) - a.x.value( );
+	std::int64_t const aby = b.y.value( ) - a.y.value( );
+	std::int64_t const acx = c.x.value( ) - a.x.value( );
+	std::int64_t const acy = c.y.value( ) - a.y.value( );
+	return sign( abx * acy - aby * acx );
+}
+
+int ref_orient3d( vec3<i32> a, vec3<i32> b, vec3<i32> c, vec3<i32> d ) {
+	std::int64_t const adx = a.x.value( ) - d.x.value( );
+	std::int64_t const ady = a.y.value( ) - d.y.value( );
+	std::int64_t const adz = a.z.value( ) - d.z.value( );
+	std::int64_t const bdx = b.x.value( ) - d.x.value( );
+	std::int64_t const bdy = b.y.value( ) - d.y.value( );
+	std::int64_t const bdz = b.z.value( ) - d.z.value( );
+	std::int64_t const cdx = c.x.value( ) - d.x.value( );
+	std::int64_t const cdy = c.y.value( ) - d.y.value( );
+	std::int64_t const cdz = c.z.value( ) - d.z.value( );
+	return sign( adx * ( bdy * cdz - bdz * cdy ) +
+	             bdx * ( cdy * adz - cdz * ady ) +
+	             cdx * ( ady * bdz - adz * bdy ) );
+}
+
+int ref_in_circle( vec2<i32> a, vec2<i32> b, vec2<i32> c, vec2<i32> d ) {
+	std::int64_t const adx = a.x.value( ) - d.x.value( );
+	std::int64_t const ady = a.y.value( ) - d.y.value( );
+	std::int64_t const bdx = b.x.value( ) - d.x.value( );
+	std::int64_t const bdy = b.y.value( ) - d.y.value( );
+	std::int64_t const cdx = c.x.value( ) - d.x.value( );
+	std::int64_t const cdy = c.y.value( ) - d.y.value( );
+	return sign( ( adx * adx + ady * ady ) * ( bdx * cdy - cdx * bdy ) +
+	             ( bdx * bdx + bdy * bdy ) * ( cdx * ady - adx * cdy ) +
+	             ( cdx * cdx + cdy * cdy ) * ( adx * bdy - bdx * ady ) );
+}
+
+vec2<i32> random_small2( ) {
+	return { random_bits( 13 ), random_bits( 13 ) };
+}
+
+vec3<i32> random_small3( ) {
+	return { random_bits( 13 ), random_bits( 13 ), random_bits( 13 ) };
+}
+
+// Scaling by a positive factor and translating keeps the signs, and takes
+// the intermediates far past 64 bits
+vec2<i32> scale( vec2<i32> p, std::int32_t s, vec2<i32> t ) {
+	return { p.x * i32( s ) + t.x, p.y * i32( s ) + t.y };
+}
+
+vec3<i32> scale( vec3<i32> p, std::int32_t s, vec3<i32> t ) {
+	return { p.x * i32( s ) + t.x, p.y * i32( s ) + t.y, p.z * i32( s ) + t.z };
+}
+
+int main( ) try {
+	using namespace daw::integers;
+	constexpr auto min = i32::min( );
+	constexpr auto max = i32::max( );
+
+	static_assert( cross( vec2<i32>{ min, min }, vec2<i32>{ max, min } ) ==
+	               i64( 0x7FFF'FFFF'8000'0000 ) );
+	static_assert( cross( vec2<i32>{ i32( 1 ), i32( 0 ) },
+	                      vec2<i32>{ i32( 0 ), i32( 1 ) } ) == 1 );
+	static_assert( cross( vec3<i32>{ i32( 1 ), i32( 0 ), i32( 0 ) },
+	                      vec3<i32>{ i32( 0 ), i32( 1 ), i32( 0 ) } ) ==
+	               vec3<i64>{ i64( 0 ), i64( 0 ), i64( 1 ) } );
+	static_assert( dot( vec3<i32>{ i32( 1 ), i32( 2 ), i32( 3 ) },
+	                    vec3<i32>{ i32( 4 ), i32( -5 ), i32( 6 ) } ) == 12 );
+
+	// Collinear at the extremes, where a double would round
+	static_assert( orient2d( vec2<i32>{ min, min }, vec2<i32>{ max, max },
+	                         vec2<i32>{ i32( 0 ), i32( 0 ) } ) == 0 );
+	static_assert( orient2d( vec2<i32>{ min, min }, vec2<i32>{ max, max },
+	                         vec2<i32>{ i32( 0 ), i32( 1 ) } ) == 1 );
+	static_assert( orient2d( vec2<i32>{ min, min }, vec2<i32>{ max, max },
+	                         vec2<i32>{ max, max - i32( 1 ) } ) == -1 );
+	static_assert( orient2d( vec2<i32>{ max, min }, vec2<i32>{ min, max },
+	                         vec2<i32>{ max, min } ) == 0 );
+	// The unit circle scaled out to the limits
+	constexpr auto r = max;
+	static_assert( in_circle( vec2<i32>{ r, i32( 0 ) }, vec2<i32>{ i32( 0 ), r },
+	                          vec2<i32>{ -r, i32( 0 ) },
+	                          vec2<i32>{ i32( 0 ), -r } ) == 0 );
+	static_assert( in_circle( vec2<i32>{ r, i32( 0 ) }, vec2<i32>{ i32( 0 ), r },
+	                          vec2<i32>{ -r, i32( 0 ) },
+	                          vec2<i32>{ i32( 0 ), i32( 1 ) - r } ) == 1 );
+	static_assert( in_circle( vec2<i32>{ r, i32( 0 ) }, vec2<i32>{ i32( 0 ), r },
+	                          vec2<i32>{ -r, i32( 0 ) },
+	                          vec2<i32>{ i32( 1 ), -r } ) == -1 );
+	// a, b, c are counterclockwise seen from above
+	static_assert( orient3d( vec3<i32>{ max, min, i32( 0 ) },
+	                         vec3<i32>{ min, max, i32( 0 ) },
+	                         vec3<i32>{ min, min, i32( 0 ) },
+	                         vec3<i32>{ i32( 5 ), i32( 7 ), i32( -1 ) } ) == 1 );
+	static_assert( orient3d( vec3<i32>{ max, min, i32( 0 ) },
+	                         vec3<i32>{ min, max, i32( 0 ) },
+	                         vec3<i32>{ min, min, i32( 0 ) },
+	                         vec3<i32>{ max, max, i32( 1 ) } ) == -1 );
+
+	for( int iteration = 0; iteration < 20000; ++iteration ) {
+		auto const a = random_small2( );
+		auto const b = random_small2( );
+		auto c = random_small2( );
+		auto d = random_small2( );
+		if( iteration % 4 == 0 ) {
+			// Degenerate cases
+			c = a;
+			d = b;
+		}
+		auto const s =
+		  daw::integers::uniform_int( rng, i32( 1 ), i32( 0x20000 ) ).value( );
+		auto const t2 = vec2<i32>{ random_bits( 30 ), random_bits( 30 ) };
+		daw_ensure( orient2d( a, b, c ) == ref_orient2d( a, b, c ) );
+		daw_ensure( orient2d( scale( a, s, t2 ), scale( b, s, t2 ),
+		                      scale( c, s, t2 ) ) == ref_orient2d( a, b, c ) );
+		daw_ensure( in_circle( a, b, c, d ) == ref_in_circle( a, b, c, d ) );
+		daw_ensure( in_circle( scale( a, s, t2 ), scale( b, s, t2 ),
+		                       scale( c, s, t2 ), scale( d, s, t2 ) ) ==
+		            ref_in_circle( a, b, c, d ) );
+
+		auto const a3 = random_small3( );
+		auto const b3 = random_small3( );
+		auto const c3 = random_small3( );
+		auto const d3 = iteration % 4 == 0 ? a3 : random_small3( );
+		auto const t3 =
+		  vec3<i32>{ random_bits( 30 ), random_bits( 30 ), random_bits( 30 ) };
+		daw_ensure( orient3d( a3, b3, c3, d3 ) == ref_orient3d( a3, b3, c3, d3 ) );
+		daw_ensure( orient3d( scale( a3, s, t3 ), scale( b3, s, t3 ),
+		                      scale( c3, s, t3 ), scale( d3, s, t3 ) ) ==
+		            ref_orient3d( a3, b3, c3, d3 ) );
+	}
+
+	// Many points against one segment, over the full range of coordinates
+	for( int iteration = 0; iteration < 200; ++iteration ) {
+		auto const a = vec2<i32>{ random_bits( 32 ), random_bits( 32 ) };
+		auto b = vec2<i32>{ random_bits( 32 ), random_bits( 32 ) };
+		if( iteration % 10 == 0 ) {
+			b = vec2<i32>{ iteration % 20 == 0 ? max : min, min };
+		}
+		auto points = std::vector<vec2<i32>>(
+		  37U + static_cast<std::size_t>( iteration ) % 8U );
+		for( std::size_t n = 0; n < points.size( ); ++n ) {
+			if( n % 5 == 0 ) {
+				// On the line through a and b
+				points[n] = n % 2 == 0 ? a : b;
+			} else if( n % 7 == 0 ) {
+				points[n] = vec2<i32>{ n % 2 == 0 ? min : max, n % 3 == 0 ? min : max };
+			} else {
+				points[n] = vec2<i32>{ random_bits( 32 ), random_bits( 32 ) };
+			}
+		}
+		auto sides = std::vector<i8>( points.size( ) );
+		orient2d( a, b, points, sides );
+		for( std::size_t n = 0; n < points.size( ); ++n ) {
+			daw_ensure( sides[n] == orient2d( a, b, points[n] ) );
+#if defined( DAW_HAS_INT128 )
+			daw::int128_t const abx = std::int64_t{ b.x.value( ) } - a.x.value( );
+			daw::int128_t const aby = std::int64_t{ b.y.value( ) } - a.y.value( );
+			daw::int128_t const apx =
+			  std::int64_t{ points[n].x.value( ) } - a.x.value( );
+			daw::int128_t const apy =
+			  std::int64_t{ points[n].y.value( ) } - a.y.value( );
+			auto const det = abx * apy - aby * apx;
+			daw_ensure( sides[n] == ( det > 0 ) - ( det < 0 ) );
+#endif
+		}
+	}
+
+	bool has_overflow = false;
+	bool has_out_of_range = false;
+	auto const error_handler = [&]( SignedIntegerErrorType error_type ) {
+		switch( error_type ) {
+		case SignedIntegerErrorType::Overflow:
+			has_overflow = true;
+			break;
+		case SignedIntegerErrorType::OutOfRange:
+			has_out_of_range = true;
+			break;
+		default:
+			break;
+		}
+	};
+	register_signed_overflow_handler( error_handler );
+	register_signed_out_of_range_handler( error_handler );
+	(void)dot( vec2<i32>{ min, min }, vec2<i32>{ min, min } );
+	daw_ensure( has_overflow );
+	auto const points = std::vector<vec2<i32>>( 3 );
+	auto sides = std::vector<i8>( 2 );
+	orient2d( vec2<i32>{ }, vec2<i32>{ }, points, sides );
+	daw_ensure( has_out_of_range );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
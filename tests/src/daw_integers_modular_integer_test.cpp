@@ -0,0 +1,127 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_modular_integer.h>
+#include <daw/integers/daw_wide_arithmetic.h>
+
+#include <daw/daw_ensure.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+static constexpr auto prime_mod =
+  daw::integers::modulus( daw::i64( 1'000'000'007 ) );
+static_assert( prime_mod.is_montgomery( ) );
+static_assert( daw::integers::pow_mod( daw::i64( 2 ), daw::i64( 10 ),
+                                       prime_mod ) == daw::i64( 1024 ) );
+
+// Reference ( a * b ) % m on unsigned values, with a double and add loop
+std::uint64_t ref_mulmod( std::uint64_t a, std::uint64_t b, std::uint64_t m ) {
+	std::uint64_t result = 0;
+	a %= m;
+	for( ; b != 0; b >>= 1U ) {
+		if( b & 1U ) {
+			result = ( result + a ) % m;
+		}
+		a = ( a + a ) % m;
+	}
+	return result;
+}
+
+std::uint64_t ref_reduce( std::int64_t v, std::uint64_t m ) {
+	auto const r = v % static_cast<std::int64_t>( m );
+	return static_cast<std::uint64_t>( r < 0 ? r + static_cast<std::int64_t>( m )
+	                                         : r );
+}
+
+template<std::size_t Bits>
+void test_modulus( daw::integers::signed_integer<Bits> m_value ) {
+	using value_t = daw::integers::signed_integer<Bits>;
+	using raw_t = typename value_t::value_type;
+	auto const mod = daw::integers::modulus( m_value );
+	auto const m = static_cast<std::uint64_t>( m_value.value( ) );
+	std::uint64_t seed = 11;
+	auto const next = [&] {
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		return static_cast<raw_t>( seed >> ( 64U - Bits ) );
+	};
+	for( std::size_t n = 0; n < 2000; ++n ) {
+		auto const a = value_t::conversion_unchecked( next( ) );
+		auto const b = value_t::conversion_unchecked( next( ) );
+		auto const ma = daw::integers::modular_integer( a, mod );
+		auto const mb = daw::integers::modular_integer( b, mod );
+		auto const ra = ref_reduce( a.value( ), m );
+		auto const rb = ref_reduce( b.value( ), m );
+		daw_ensure( static_cast<std::uint64_t>( ma.value( ).value( ) ) == ra );
+		daw_ensure( static_cast<std::uint64_t>( ( ma * mb ).value( ).value( ) ) ==
+		            ref_mulmod( ra, rb, m ) );
+		daw_ensure( static_cast<std::uint64_t>( ( ma + mb ).value( ).value( ) ) ==
+		            ( ra + rb ) % m );
+		daw_ensure( static_cast<std::uint64_t>( ( ma - mb ).value( ).value( ) ) ==
+		            ( ra + m - rb ) % m );
+	}
+	// Batched and scalar pow_mod agree
+	auto bases = std::vector<value_t>( );
+	for( std::size_t n = 0; n < 37; ++n ) {
+		bases.push_back( value_t::conversion_unchecked( next( ) ) );
+	}
+	auto out = std::vector<value_t>( bases.size( ) );
+	auto const e = daw::i64( 65537 );
+	daw::integers::pow_mod( bases, e, mod, out );
+	for( std::size_t n = 0; n < bases.size( ); ++n ) {
+		auto expected = std::uint64_t{ 1 } % m;
+		auto p = ref_reduce( bases[n].value( ), m );
+		for( auto x = 65537U; x != 0; x >>= 1U ) {
+			if( x & 1U ) {
+				expected = ref_mulmod( expected, p, m );
+			}
+			p = ref_mulmod( p, p, m );
+		}
+		daw_ensure( static_cast<std::uint64_t>( out[n].value( ) ) == expected );
+		daw_ensure( daw::integers::pow_mod( bases[n], e, mod ) == out[n] );
+	}
+}
+
+int main( ) try {
+	// mul_wide
+	auto const w = daw::integers::mul_wide( daw::i64::max( ), daw::i64( -3 ) );
+	daw_ensure( w.high == daw::i64( -2 ) );
+	daw_ensure( w.low == 0x8000'0000'0000'0003ULL );
+	auto const w32 = daw::integers::mul_wide( daw::i32( -7 ), daw::i32( 9 ) );
+	daw_ensure( w32.high == daw::i32( -1 ) );
+	daw_ensure( w32.low == static_cast<std::uint32_t>( -63 ) );
+
+	test_modulus<64>( daw::i64( 1'000'000'007 ) );
+	test_modulus<64>( daw::i64( 0x7FFF'FFFF'FFFF'FFE7LL ) );
+	test_modulus<64>( daw::i64( 1'000'000'000'000LL ) );
+	test_modulus<32>( daw::i32( 998'244'353 ) );
+	test_modulus<32>( daw::i32( 1 << 20 ) );
+	test_modulus<16>( daw::i16( 251 ) );
+	test_modulus<8>( daw::i8( 3 ) );
+
+	// Fermat's little theorem
+	auto const a = daw::integers::modular_integer( daw::i64( 123456789 ),
+	                                               prime_mod );
+	daw_ensure( a.pow( daw::i64( 1'000'000'006 ) ).value( ) == daw::i64( 1 ) );
+
+	bool has_out_of_range = false;
+	auto const error_handler =
+	  [&]( daw::integers::SignedIntegerErrorType error_type ) {
+		  if( error_type == daw::integers::SignedIntegerErrorType::OutOfRange ) {
+			  has_out_of_range = true;
+		  }
+	  };
+	daw::integers::register_signed_out_of_range_handler( error_handler );
+	(void)daw::integers::modulus( daw::i32( 0 ) );
+	daw_ensure( has_out_of_range );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
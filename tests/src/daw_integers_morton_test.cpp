@@ -0,0 +1,210 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_morton.h>
+#include <daw/integers/daw_random.h>
+
+#include <daw/daw_ensure.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+using daw::integers::i32;
+using daw::integers::i64;
+using daw::integers::i8;
+using daw::integers::morton_3d_max;
+using daw::integers::morton_3d_min;
+using daw::integers::uniform_int;
+using daw::integers::xoshiro256pp;
+
+static_assert( i32( 0b1011'0100 ).extract_bits( i32( 0b1111'0000 ) ) ==
+               i32( 0b1011 ) );
+static_assert( i32( 0b1011 ).deposit_bits( i32( 0b1111'0000 ) ) ==
+               i32( 0b1011'0000 ) );
+static_assert( i32( -1 ).extract_bits( i32( 0x0F0F'0000 ) ) == i32( 0xFF ) );
+static_assert( i8( 0b0101 ).deposit_bits( i8( -128 + 0b101 ) ) == i8( -127 ) );
+static_assert( daw::integers::morton_encode_2d( i32( 0 ), i32( 0 ) ) <
+               daw::integers::morton_encode_2d( i32( 1 ), i32( 0 ) ) );
+static_assert( daw::integers::morton_encode_2d( i32( -1 ), i32( -1 ) ) <
+               daw::integers::morton_encode_2d( i32( 0 ), i32( 0 ) ) );
+static_assert( daw::integers::morton_decode_2d(
+                 daw::integers::morton_encode_2d( i32( -7 ), i32( 3 ) ) )[0] ==
+               i32( -7 ) );
+static_assert( daw::integers::morton_decode_3d( daw::integers::morton_encode_3d(
+                 i32( -7 ), i32( 3 ), morton_3d_min ) )[2] == morton_3d_min );
+
+namespace {
+	std::size_t out_of_range_count = 0;
+
+	std::uint64_t reference_extract( std::uint64_t value, std::uint64_t mask ) {
+		std::uint64_t result = 0;
+		unsigned pos = 0;
+		for( unsigned n = 0; n < 64; ++n ) {
+			if( ( mask >> n ) & 1U ) {
+				result |= ( ( value >> n ) & 1U ) << pos++;
+			}
+		}
+		return result;
+	}
+
+	std::uint64_t reference_deposit( std::uint64_t value, std::uint64_t mask ) {
+		std::uint64_t result = 0;
+		unsigned pos = 0;
+		for( unsigned n = 0; n < 64; ++n ) {
+			if( ( mask >> n ) & 1U ) {
+				result |= ( ( value >> pos++ ) & 1U ) << n;
+			}
+		}
+		return result;
+	}
+
+	// Interleave one bit at a time, as a spatial index would without pdep
+	std::uint64_t reference_interleave( std::int32_t x, std::int32_t y ) {
+		auto const kx = static_cast<std::uint32_t>( x ) ^ 0x8000'0000U;
+		auto const ky = static_cast<std::uint32_t>( y ) ^ 0x8000'0000U;
+		std::uint64_t result = 0;
+		for( unsigned n = 0; n < 32; ++n ) {
+			result |= static_cast<std::uint64_t>( ( kx >> n ) & 1U ) << ( 2U * n );
+			result |= static_cast<std::uint64_t>( ( ky >> n ) & 1U )
+			          << ( 2U * n + 1U );
+		}
+		return result;
+	}
+
+	void test_extract_deposit( ) {
+		auto rng = xoshiro256pp( 98 );
+		for( int n = 0; n < 100'000; ++n ) {
+			auto const value = rng( );
+			auto const mask = rng( ) & rng( );
+			auto const v64 = i64( static_cast<std::int64_t>( value ) );
+			auto const m64 = i64( static_cast<std::int64_t>( mask ) );
+			daw_ensure( static_cast<std::uint64_t>(
+			              v64.extract_bits( m64 ).value( ) ) ==
+			            reference_extract( value, mask ) );
+			daw_ensure( static_cast<std::uint64_t>(
+			              v64.deposit_bits( m64 ).value( ) ) ==
+			            reference_deposit( value, mask ) );
+			auto const v32 = i32( static_cast<std::int32_t>( value ) );
+			auto const m32 = i32( static_cast<std::int32_t>( mask ) );
+			daw_ensure(
+			  static_cast<std::uint32_t>( v32.extract_bits( m32 ).value( ) ) ==
+			  reference_extract( value & 0xFFFF'FFFFU, mask & 0xFFFF'FFFFU ) );
+			daw_ensure(
+			  static_cast<std::uint32_t>( v32.deposit_bits( m32 ).value( ) ) ==
+			  reference_deposit( value & 0xFFFF'FFFFU, mask & 0xFFFF'FFFFU ) );
+			// Extracting what was deposited gives back the low popcount( mask )
+			// bits
+			auto const width = reference_extract( ~0ULL, mask );
+			daw_ensure( static_cast<std::uint64_t>(
+			              v64.deposit_bits( m64 ).extract_bits( m64 ).value( ) ) ==
+			            ( value & width ) );
+		}
+	}
+
+	void test_2d( ) {
+		constexpr std::size_t count = 1000;
+		auto rng = xoshiro256pp( 98 );
+		auto xs = std::vector<i32>( count, i32( 0 ) );
+		auto ys = std::vector<i32>( count, i32( 0 ) );
+		for( std::size_t n = 0; n < count; ++n ) {
+			xs[n] = uniform_int( rng, i32::min( ), i32::max( ) );
+			ys[n] = uniform_int( rng, i32( -100 ), i32( 100 ) );
+		}
+		xs[0] = i32::min( );
+		ys[0] = i32::max( );
+		auto codes = std::vector<i64>( count, i64( 0 ) );
+		daw::integers::morton_encode_2d( xs, ys, codes );
+		for( std::size_t n = 0; n < count; ++n ) {
+			auto const expected = reference_interleave( xs[n].value( ),
+			                                            ys[n].value( ) ) ^
+			                      ( 1ULL << 63U );
+			daw_ensure( static_cast<std::uint64_t>( codes[n].value( ) ) ==
+			            expected );
+			daw_ensure( codes[n] == daw::integers::morton_encode_2d( xs[n], ys[n] ) );
+			auto const [x, y] = daw::integers::morton_decode_2d( codes[n] );
+			daw_ensure( x == xs[n] and y == ys[n] );
+		}
+		auto dx = std::vector<i32>( count, i32( 0 ) );
+		auto dy = std::vector<i32>( count, i32( 0 ) );
+		daw::integers::morton_decode_2d( codes, dx, dy );
+		daw_ensure( dx == xs and dy == ys );
+
+		// The code order matches the coordinate order along each axis
+		for( std::size_t n = 0; n + 1 < count; ++n ) {
+			auto const a = daw::integers::morton_encode_2d( xs[n], ys[0] );
+			auto const b = daw::integers::morton_encode_2d( xs[n + 1], ys[0] );
+			daw_ensure( ( xs[n] < xs[n + 1] ) == ( a < b ) );
+			auto const c = daw::integers::morton_encode_2d( xs[0], ys[n] );
+			auto const d = daw::integers::morton_encode_2d( xs[0], ys[n + 1] );
+			daw_ensure( ( ys[n] < ys[n + 1] ) == ( c < d ) );
+		}
+	}
+
+	void test_3d( ) {
+		constexpr std::size_t count = 1000;
+		auto rng = xoshiro256pp( 98 );
+		auto xs = std::vector<i32>( count, i32( 0 ) );
+		auto ys = std::vector<i32>( count, i32( 0 ) );
+		auto zs = std::vector<i32>( count, i32( 0 ) );
+		auto const lo = morton_3d_min;
+		auto const hi = morton_3d_max;
+		for( std::size_t n = 0; n < count; ++n ) {
+			xs[n] = uniform_int( rng, lo, hi );
+			ys[n] = uniform_int( rng, lo, hi );
+			zs[n] = uniform_int( rng, i32( -5 ), i32( 5 ) );
+		}
+		auto codes = std::vector<i64>( count, i64( 0 ) );
+		daw_ensure( daw::integers::morton_encode_3d( xs, ys, zs, codes ) == count );
+		for( std::size_t n = 0; n < count; ++n ) {
+			daw_ensure( codes[n] >= 0 );
+			auto const [x, y, z] = daw::integers::morton_decode_3d( codes[n] );
+			daw_ensure( x == xs[n] and y == ys[n] and z == zs[n] );
+		}
+		auto dx = std::vector<i32>( count, i32( 0 ) );
+		auto dy = std::vector<i32>( count, i32( 0 ) );
+		auto dz = std::vector<i32>( count, i32( 0 ) );
+		daw::integers::morton_decode_3d( codes, dx, dy, dz );
+		daw_ensure( dx == xs and dy == ys and dz == zs );
+
+		for( std::size_t n = 0; n + 1 < count; ++n ) {
+			auto const a =
+			  daw::integers::morton_encode_3d( i32( 0 ), xs[n], i32( 0 ) );
+			auto const b =
+			  daw::integers::morton_encode_3d( i32( 0 ), xs[n + 1], i32( 0 ) );
+			daw_ensure( ( xs[n] < xs[n + 1] ) == ( a < b ) );
+		}
+
+		// Out of range coordinates stop the bulk encode and clamp when scalar
+		auto const before = out_of_range_count;
+		zs[10] = morton_3d_max + 1;
+		daw_ensure( daw::integers::morton_encode_3d( xs, ys, zs, codes ) == 10 );
+		daw_ensure( out_of_range_count == before + 1 );
+		auto const clamped =
+		  daw::integers::morton_encode_3d( i32( 0 ), i32( 0 ), i32::min( ) );
+		daw_ensure( out_of_range_count == before + 2 );
+		daw_ensure( daw::integers::morton_decode_3d( clamped )[2] ==
+		            morton_3d_min );
+	}
+} // namespace
+
+int main( ) try {
+	auto const on_out_of_range = []( daw::integers::SignedIntegerErrorType ) {
+		++out_of_range_count;
+	};
+	daw::integers::register_signed_out_of_range_handler( on_out_of_range );
+
+	test_extract_deposit( );
+	test_2d( );
+	test_3d( );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
@@ -0,0 +1,296 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include "daw_integers_test_support.h"
+
+#include <daw/integers/daw_multiply.h>
+#include <daw/integers/daw_random.h>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_ensure.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+using daw::integers::i16;
+using daw::integers::i32;
+using daw::integers::i64;
+using daw::integers::i8;
+using daw::integers::xoshiro256pp;
+using daw::integers::test::random_magnitude;
+
+namespace {
+	std::size_t overflow_count = 0;
+	std::size_t out_of_range_count = 0;
+
+	// The wrapped product of a and b, and whether the exact one fits.  Kept
+	// independent of the library's own overflow detection
+	template<typename SI>
+	bool reference_mul( SI a, SI b, SI &result ) {
+		using value_type = typename SI::value_type;
+		using unsigned_t = std::make_unsigned_t<value_type>;
+		auto const x = a.value( );
+		auto const y = b.value( );
+		auto const wrapped = static_cast<value_type>( static_cast<unsigned_t>(
+		  static_cast<unsigned_t>( x ) * static_cast<unsigned_t>( y ) ) );
+		result = SI( wrapped );
+		if( x == 0 ) {
+			return true;
+		}
+		constexpr auto min = std::numeric_limits<value_type>::min( );
+		if( ( x == -1 and y == min ) or ( y == -1 and x == min ) ) {
+			return false;
+		}
+		return static_cast<value_type>( wrapped / x ) == y;
+	}
+
+	template<typename SI>
+	SI reference_mul_saturated( SI a, SI b ) {
+		auto result = SI( 0 );
+		if( reference_mul( a, b, result ) ) {
+			return result;
+		}
+		return ( a < 0 ) == ( b < 0 ) ? SI::max( ) : SI::min( );
+	}
+
+	template<typename SI>
+	std::vector<SI> random_values( std::size_t size, xoshiro256pp &rng ) {
+		auto result = std::vector<SI>( size, SI( 0 ) );
+		for( auto &v : result ) {
+			// About half of the products of these overflow
+			v = random_magnitude<SI>( rng );
+		}
+		// Sprinkle in the edge cases
+		SI const edges[] = { SI::min( ), SI::max( ), SI( -1 ), SI( 0 ), SI( 1 ) };
+		for( std::size_t n = 0; n < size; n += 7U ) {
+			result[n] = edges[( n / 7U ) % std::size( edges )];
+		}
+		return result;
+	}
+
+	template<typename SI>
+	void test_span( std::size_t size ) {
+		auto rng = xoshiro256pp( 100 );
+		auto const a = random_values<SI>( size, rng );
+		auto b = random_values<SI>( size, rng );
+		auto out = std::vector<SI>( size, SI( 0 ) );
+		auto flags = std::unique_ptr<bool[]>( new bool[size + 1U] );
+
+		daw::integers::mul_wrapped( a, b, out );
+		std::size_t expected_overflows = 0;
+		std::size_t first_bad = size;
+		for( std::size_t n = 0; n < size; ++n ) {
+			auto expected = SI( 0 );
+			bool const fits = reference_mul( a[n], b[n], expected );
+			daw_ensure( out[n] == expected );
+			if( not fits ) {
+				++expected_overflows;
+				if( first_bad == size ) {
+					first_bad = n;
+				}
+			}
+		}
+
+		// Lane overflow flags
+		daw_ensure( daw::integers::mul_wrapped( a.data( ), b.data( ), size,
+		                                        out.data( ), flags.get( ) ) ==
+		            expected_overflows );
+		for( std::size_t n = 0; n < size; ++n ) {
+			auto expected = SI( 0 );
+			daw_ensure( flags[n] == not reference_mul( a[n], b[n], expected ) );
+			daw_ensure( out[n] == expected );
+		}
+
+		daw::integers::mul_saturated( a, b, out );
+		for( std::size_t n = 0; n < size; ++n ) {
+			daw_ensure( out[n] == reference_mul_saturated( a[n], b[n] ) );
+		}
+
+		// Checked stops at the first overflow
+		{
+			auto const before = overflow_count;
+			daw_ensure( daw::integers::mul_checked( a, b, out ) == first_bad );
+			daw_ensure( overflow_count == before + ( first_bad == size ? 0 : 1 ) );
+			for( std::size_t n = 0; n < first_bad; ++n ) {
+				auto expected = SI( 0 );
+				(void)reference_mul( a[n], b[n], expected );
+				daw_ensure( out[n] == expected );
+			}
+		}
+		// Nothing overflows when one side is in {-1, 0, 1} and is never min( )
+		auto small = a;
+		for( std::size_t n = 0; n < size; ++n ) {
+			b[n] = SI( static_cast<int>( rng( ) % 3U ) - 1 );
+			if( small[n] == SI::min( ) ) {
+				small[n] = SI::max( );
+			}
+		}
+		{
+			auto const before = overflow_count;
+			daw_ensure( daw::integers::mul_checked( small, b, out ) == size );
+			daw_ensure( overflow_count == before );
+			for( std::size_t n = 0; n < size; ++n ) {
+				daw_ensure( out[n] == small[n] * b[n] );
+			}
+		}
+		if( size == 0 ) {
+			return;
+		}
+		// Plant one overflow and check the position is reported, in place
+		auto const bad = size - 1U - static_cast<std::size_t>( rng( ) % size );
+		small[bad] = SI::max( );
+		b[bad] = SI( 2 );
+		out = small;
+		auto const before = overflow_count;
+		daw_ensure( daw::integers::mul_checked( out, b, out ) == bad );
+		daw_ensure( overflow_count == before + 1 );
+		for( std::size_t n = 0; n < bad; ++n ) {
+			daw_ensure( out[n] == small[n] * b[n] );
+		}
+		daw_ensure( out[bad] == SI::max( ) );
+	}
+
+	template<typename SI>
+	void test_spans( ) {
+		for( std::size_t size : { 0U, 1U, 3U, 15U, 16U, 17U, 33U, 100U, 4096U } ) {
+			test_span<SI>( size );
+		}
+	}
+
+	void test_range_sizes( ) {
+		auto const a = std::vector<i32>( 10, i32( 3 ) );
+		auto const b = std::vector<i32>( 6, i32( -2 ) );
+		auto out = std::vector<i32>( 8, i32( 0 ) );
+		auto const before = out_of_range_count;
+		daw_ensure( daw::integers::mul_checked( a, b, out ) == 6 );
+		daw_ensure( out_of_range_count == before + 1 );
+		daw_ensure( out[5] == i32( -6 ) and out[6] == i32( 0 ) );
+		bool flags[4] = { };
+		daw_ensure( daw::integers::mul_wrapped( a, b, out, flags ) == 0 );
+		daw_ensure( out_of_range_count == before + 2 );
+	}
+
+	template<typename SI, typename Kernel>
+	double time_kernel( std::vector<SI> const &a, std::vector<SI> const &b,
+	                    std::vector<SI> &out, Kernel kernel ) {
+		constexpr int repetitions = 20;
+		auto best = std::chrono::duration<double, std::nano>::max( );
+		for( int r = 0; r < repetitions; ++r ) {
+			auto const start = std::chrono::steady_clock::now( );
+			auto const result = kernel( a, b, out );
+			daw::do_not_optimize( result );
+			daw::do_not_optimize( out );
+			auto const elapsed = std::chrono::steady_clock::now( ) - start;
+			if( elapsed < best ) {
+				best = elapsed;
+			}
+		}
+		return best.count( ) / static_cast<double>( a.size( ) );
+	}
+
+	template<typename SI>
+	void bench_width( char const *name ) {
+		using value_type = typename SI::value_type;
+		constexpr std::size_t count = 1U << 14U;
+		auto rng = xoshiro256pp( 100 );
+		auto const a = random_values<SI>( count, rng );
+		auto const b = random_values<SI>( count, rng );
+		// Operands whose products all fit, so checked runs to the end
+		auto fit_a = std::vector<SI>( count, SI( 0 ) );
+		auto fit_b = std::vector<SI>( count, SI( 0 ) );
+		for( std::size_t n = 0; n < count; ++n ) {
+			auto const half = static_cast<unsigned>( sizeof( value_type ) * 4U ) - 1U;
+			auto const mask = ( std::uint64_t{ 1 } << half ) - 1U;
+			fit_a[n] = SI( static_cast<value_type>( rng( ) & mask ) );
+			fit_b[n] = SI( static_cast<value_type>(
+			  -static_cast<std::int64_t>( rng( ) & mask ) ) );
+		}
+		auto out = std::vector<SI>( count, SI( 0 ) );
+
+		// The loop a caller would write by hand, one __builtin_mul_overflow per
+		// element
+		auto const scalar_checked = []( auto const &x, auto const &y,
+		                                auto &o ) {
+			std::size_t n = 0;
+			for( ; n < x.size( ); ++n ) {
+				auto r = value_type{ };
+				if( daw::integers::sint_impl::wrapping_mul( x[n].value( ),
+				                                            y[n].value( ), r ) ) {
+					break;
+				}
+				o[n] = SI( r );
+			}
+			return n;
+		};
+		auto const scalar_saturated = []( auto const &x, auto const &y,
+		                                  auto &o ) {
+			for( std::size_t n = 0; n < x.size( ); ++n ) {
+				o[n] = x[n].mul_saturated( y[n] );
+			}
+			return std::size_t{ 0 };
+		};
+		auto const simd_checked = []( auto const &x, auto const &y, auto &o ) {
+			return daw::integers::mul_checked( x, y, o );
+		};
+		auto const simd_saturated = []( auto const &x, auto const &y, auto &o ) {
+			daw::integers::mul_saturated( x, y, o );
+			return std::size_t{ 0 };
+		};
+		auto const simd_wrapped = []( auto const &x, auto const &y, auto &o ) {
+			daw::integers::mul_wrapped( x, y, o );
+			return std::size_t{ 0 };
+		};
+		std::cout << std::setw( 4 ) << name << std::fixed << std::setprecision( 3 )
+		          << std::setw( 16 )
+		          << time_kernel( fit_a, fit_b, out, scalar_checked )
+		          << std::setw( 10 )
+		          << time_kernel( fit_a, fit_b, out, simd_checked )
+		          << std::setw( 17 ) << time_kernel( a, b, out, scalar_saturated )
+		          << std::setw( 10 ) << time_kernel( a, b, out, simd_saturated )
+		          << std::setw( 10 ) << time_kernel( a, b, out, simd_wrapped )
+		          << '\n';
+	}
+
+	void bench_multiply( ) {
+		std::cout << "ns/element     checked scalar     simd  saturated scalar"
+		             "      simd   wrapped\n";
+		bench_width<i8>( "i8" );
+		bench_width<i16>( "i16" );
+		bench_width<i32>( "i32" );
+		bench_width<i64>( "i64" );
+	}
+} // namespace
+
+int main( ) try {
+	auto const on_overflow = []( daw::integers::SignedIntegerErrorType ) {
+		++overflow_count;
+	};
+	auto const on_out_of_range = []( daw::integers::SignedIntegerErrorType ) {
+		++out_of_range_count;
+	};
+	daw::integers::register_signed_overflow_handler( on_overflow );
+	daw::integers::register_signed_out_of_range_handler( on_out_of_range );
+
+	test_spans<i8>( );
+	test_spans<i16>( );
+	test_spans<i32>( );
+	test_spans<i64>( );
+	test_range_sizes( );
+
+	bench_multiply( );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
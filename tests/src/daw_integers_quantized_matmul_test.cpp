@@ -0,0 +1,136 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_quantized_matmul.h>
+#include <daw/integers/daw_random.h>
+
+#include <daw/daw_ensure.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+using daw::integers::i32;
+using daw::integers::i8;
+
+auto rng = daw::integers::xoshiro256pp( 91 );
+
+void test_gemm( std::size_t m, std::size_t n, std::size_t k ) {
+	auto a = std::vector<i8>( m * k );
+	auto w = std::vector<i8>( n * k );
+	daw::integers::uniform_fill( rng, i8::min( ), i8::max( ), a );
+	daw::integers::uniform_fill( rng, i8::min( ), i8::max( ), w );
+	// Include the extreme values
+	if( k > 0 ) {
+		a[0] = i8( -128 );
+		w[0] = i8( -128 );
+		a[a.size( ) - 1] = i8( 127 );
+		w[w.size( ) - 1] = i8( -128 );
+	}
+	auto c = std::vector<i32>( m * n, i32( 12345 ) );
+	daw::integers::quantized_gemm( a.data( ), m, w.data( ), n, k, c.data( ) );
+	for( std::size_t row = 0; row < m; ++row ) {
+		for( std::size_t col = 0; col < n; ++col ) {
+			std::int64_t expected = 0;
+			for( std::size_t i = 0; i < k; ++i ) {
+				expected += std::int64_t{ a[row * k + i].value( ) } *
+				            w[col * k + i].value( );
+			}
+			daw_ensure( c[row * n + col].value( ) == expected );
+		}
+	}
+	if( m > 0 ) {
+		auto y = std::vector<i32>( n );
+		daw::integers::quantized_gemv( w.data( ), n, k, a.data( ), y.data( ) );
+		for( std::size_t col = 0; col < n; ++col ) {
+			daw_ensure( y[col] == c[col] );
+		}
+	}
+}
+
+int main( ) try {
+	using namespace daw::integers;
+
+	test_gemm( 1, 1, 1 );
+	test_gemm( 3, 5, 7 );
+	test_gemm( 4, 4, 16 );
+	test_gemm( 2, 9, 33 );
+	test_gemm( 7, 67, 100 );
+	test_gemm( 5, 130, 257 );
+	test_gemm( 2, 3, quantized_block_k + 45 );
+	test_gemm( 1, 2, 3 * quantized_block_k );
+	test_gemm( 3, 4, 0 );
+
+	// The worst case products, all -128 * -128, stay exact until the total
+	// no longer fits
+	{
+		bool has_overflow = false;
+		auto const error_handler = [&]( SignedIntegerErrorType error_type ) {
+			if( error_type == SignedIntegerErrorType::Overflow ) {
+				has_overflow = true;
+			}
+		};
+		register_signed_overflow_handler( error_handler );
+		constexpr std::size_t fits = 131071;
+		auto a = std::vector<i8>( fits + quantized_block_k, i8( -128 ) );
+		auto y = i32( 0 );
+		quantized_gemv( a.data( ), 1, fits, a.data( ), &y );
+		daw_ensure( not has_overflow );
+		daw_ensure( y.value( ) == 16384 * static_cast<std::int32_t>( fits ) );
+		quantized_gemv( a.data( ), 1, a.size( ), a.data( ), &y );
+		daw_ensure( has_overflow );
+	}
+
+	// Requantization
+	{
+		auto p = requantize_params{ i32( 1 ), i32( 0 ), i32( 0 ) };
+		daw_ensure( requantize( i32( 5 ), p ) == 5 );
+		daw_ensure( requantize( i32( 1000 ), p ) == 127 );
+		daw_ensure( requantize( i32( -1000 ), p ) == -128 );
+		// Divide by 4, half way rounds up
+		p = requantize_params{ i32( 1 ), i32( 2 ), i32( 0 ) };
+		daw_ensure( requantize( i32( 6 ), p ) == 2 );
+		daw_ensure( requantize( i32( 5 ), p ) == 1 );
+		daw_ensure( requantize( i32( -6 ), p ) == -1 );
+		daw_ensure( requantize( i32( -7 ), p ) == -2 );
+		// A scale of about 0.0123 with a zero point
+		p = requantize_params{ i32( 1'651'910'902 ), i32( 37 ), i32( -3 ) };
+		daw_ensure( requantize( i32( 1000 ), p ) == 9 );
+		daw_ensure( requantize( daw::numeric_limits<i32>::max( ), p ) == 127 );
+		daw_ensure( requantize( daw::numeric_limits<i32>::min( ), p ) == -128 );
+		static_assert( requantize( i32( 300 ),
+		                           requantize_params{ i32( 3 ), i32( 3 ),
+		                                              i32( 10 ) } ) == 123 );
+
+		auto acc = std::vector<i32>{ i32( -100000 ), i32( -7 ), i32( 0 ),
+		                             i32( 7 ), i32( 100000 ) };
+		auto out = std::vector<i8>( acc.size( ) );
+		p = requantize_params{ i32( 3 ), i32( 1 ), i32( 1 ) };
+		requantize( acc, p, out );
+		for( std::size_t i = 0; i < acc.size( ); ++i ) {
+			daw_ensure( out[i] == requantize( acc[i], p ) );
+		}
+		daw_ensure( out[1] == -9 and out[3] == 12 );
+		daw_ensure( out[0] == -128 and out[4] == 127 );
+
+		bool has_out_of_range = false;
+		auto const error_handler = [&]( SignedIntegerErrorType error_type ) {
+			if( error_type == SignedIntegerErrorType::OutOfRange ) {
+				has_out_of_range = true;
+			}
+		};
+		register_signed_out_of_range_handler( error_handler );
+		p.shift = i32( 63 );
+		(void)requantize( i32( 1 ), p );
+		daw_ensure( has_out_of_range );
+	}
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
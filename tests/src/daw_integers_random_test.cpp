@@ -0,0 +1,174 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_random.h>
+
+#include <daw/daw_ensure.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+template<typename SignedInteger, typename URBG>
+void test_bounds( URBG &rng, SignedInteger lo, SignedInteger hi ) {
+	bool saw_lo = false;
+	bool saw_hi = false;
+	for( std::size_t n = 0; n < 2000; ++n ) {
+		auto const v = daw::integers::uniform_int( rng, lo, hi );
+		daw_ensure( v >= lo and v <= hi );
+		saw_lo |= v == lo;
+		saw_hi |= v == hi;
+	}
+	auto values = std::vector<SignedInteger>( 2003 );
+	daw::integers::uniform_fill( rng, lo, hi, values );
+	for( auto v : values ) {
+		daw_ensure( v >= lo and v <= hi );
+		saw_lo |= v == lo;
+		saw_hi |= v == hi;
+	}
+	if( hi.sub_wrapped( lo ) < 8 and hi.sub_wrapped( lo ) >= 0 ) {
+		daw_ensure( saw_lo and saw_hi );
+	}
+}
+
+template<typename SignedInteger, typename URBG>
+void test_widths( URBG &rng ) {
+	using limits = daw::numeric_limits<SignedInteger>;
+	auto const min = limits::min( );
+	auto const max = limits::max( );
+	test_bounds( rng, min, max );
+	test_bounds( rng, min, min + SignedInteger( 1 ) );
+	test_bounds( rng, max - SignedInteger( 3 ), max );
+	test_bounds( rng, SignedInteger( -3 ), SignedInteger( 3 ) );
+	test_bounds( rng, SignedInteger( 5 ), SignedInteger( 5 ) );
+	test_bounds( rng, min, SignedInteger( 0 ) );
+	test_bounds( rng, SignedInteger( -1 ), max );
+}
+
+template<typename URBG>
+void test_uniformity( URBG &rng ) {
+	// Seven buckets, 70000 draws.  Each count is binomial with a standard
+	// deviation near 90
+	std::size_t counts[7]{ };
+	auto values = std::vector<daw::integers::i32>( 70000 );
+	daw::integers::uniform_fill( rng, daw::integers::i32( -3 ),
+	                             daw::integers::i32( 3 ), values );
+	for( auto v : values ) {
+		++counts[static_cast<std::size_t>( v.value( ) + 3 )];
+	}
+	for( auto c : counts ) {
+		daw_ensure( c > 9500 and c < 10500 );
+	}
+}
+
+int main( ) try {
+	using namespace daw::integers;
+
+	// The lanes of xoshiro256pp_x4 are the scalar generator jumped 0 to 3
+	// times
+	{
+		auto x4 = xoshiro256pp_x4( 42 );
+		xoshiro256pp lanes[4] = { xoshiro256pp( 42 ), xoshiro256pp( 42 ),
+		                          xoshiro256pp( 42 ), xoshiro256pp( 42 ) };
+		for( std::size_t k = 1; k < 4; ++k ) {
+			for( std::size_t j = 0; j < k; ++j ) {
+				lanes[k].jump( );
+			}
+		}
+		std::uint64_t block[4];
+		for( std::size_t n = 0; n < 100; ++n ) {
+			x4.next_block( block );
+			for( std::size_t k = 0; k < 4; ++k ) {
+				daw_ensure( block[k] == lanes[k]( ) );
+			}
+		}
+		// The call operator hands out whole blocks in lane order
+		auto a = xoshiro256pp_x4( 7 );
+		auto b = xoshiro256pp_x4( 7 );
+		b.next_block( block );
+		for( std::size_t k = 0; k < 4; ++k ) {
+			daw_ensure( a( ) == block[k] );
+		}
+	}
+
+	// A power of two span never rejects, so the vector and scalar multiply
+	// shift must produce the offsets x >> 24 from the 32 bit halves in order
+	{
+		auto rng = xoshiro256pp_x4( 9 );
+		auto ref = xoshiro256pp_x4( 9 );
+		auto values = std::vector<i32>( 64 );
+		uniform_fill( rng, i32( -1000 ), i32( -1000 + 255 ), values );
+		std::uint64_t block[4];
+		for( std::size_t n = 0; n < values.size( ); ++n ) {
+			if( n % 8 == 0 ) {
+				ref.next_block( block );
+			}
+			auto const k = n % 8;
+			auto const x =
+			  static_cast<std::uint32_t>( block[k / 2] >> ( 32U * ( k % 2 ) ) );
+			daw_ensure( values[n] == i32( -1000 ) + i32( x >> 24U ) );
+		}
+	}
+
+	// Same seed, same output
+	{
+		auto a = xoshiro256pp_x4( 11 );
+		auto b = xoshiro256pp_x4( 11 );
+		auto va = std::vector<i64>( 101 );
+		auto vb = std::vector<i64>( 101 );
+		uniform_fill( a, i64( -7 ), i64( 1'000'000'007 ), va );
+		uniform_fill( b, i64( -7 ), i64( 1'000'000'007 ), vb );
+		daw_ensure( va == vb );
+	}
+
+	{
+		auto rng = xoshiro256pp_x4( 1 );
+		test_widths<i8>( rng );
+		test_widths<i16>( rng );
+		test_widths<i32>( rng );
+		test_widths<i64>( rng );
+		test_uniformity( rng );
+	}
+	{
+		auto rng = xoshiro256pp( 2 );
+		test_widths<i8>( rng );
+		test_widths<i32>( rng );
+		test_widths<i64>( rng );
+		test_uniformity( rng );
+	}
+	{
+		auto rng = std::mt19937_64( 3 );
+		test_widths<i16>( rng );
+		test_widths<i64>( rng );
+		test_uniformity( rng );
+	}
+
+	// hi < lo is out of range
+	{
+		bool out_of_range = false;
+		auto const error_handler = [&]( SignedIntegerErrorType error_type ) {
+			if( error_type == SignedIntegerErrorType::OutOfRange ) {
+				out_of_range = true;
+			}
+		};
+		register_signed_out_of_range_handler( error_handler );
+		auto rng = xoshiro256pp( 5 );
+		daw_ensure( uniform_int( rng, i32( 4 ), i32( 3 ) ) == 4 );
+		daw_ensure( out_of_range );
+		out_of_range = false;
+		auto values = std::vector<i32>( 4, i32( 9 ) );
+		uniform_fill( rng, i32( 4 ), i32( 3 ), values );
+		daw_ensure( out_of_range );
+		daw_ensure( values[0] == 9 );
+	}
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
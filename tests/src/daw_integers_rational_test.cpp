@@ -0,0 +1,166 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_random.h>
+#include <daw/integers/daw_rational.h>
+
+#include <daw/daw_ensure.h>
+
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+
+using daw::integers::i32;
+using daw::integers::i64;
+using daw::integers::rational32;
+using daw::integers::rational64;
+
+auto rng = daw::integers::xoshiro256pp( 95 );
+
+std::int64_t next_small( ) {
+	return daw::integers::uniform_int( rng, i64( -2048 ), i64( 2047 ) ).value( );
+}
+
+// A fraction in lowest terms with a positive denominator
+struct reference {
+	std::int64_t num;
+	std::int64_t den;
+
+	reference( std::int64_t n, std::int64_t d ) {
+		if( d < 0 ) {
+			n = -n;
+			d = -d;
+		}
+		auto const g = std::gcd( n, d );
+		num = n / g;
+		den = d / g;
+	}
+};
+
+void ensure_equal( rational32 r, reference const &expected ) {
+	auto const n = r.normalized( );
+	daw_ensure( n.numerator( ) == expected.num );
+	daw_ensure( n.denominator( ) == expected.den );
+	daw_ensure( n.is_normalized( ) );
+	daw_ensure( r == rational32( i32( expected.num ), i32( expected.den ) ) );
+}
+
+int main( ) try {
+	using namespace daw::integers;
+
+	static_assert( rational32( i32( 1 ), i32( 2 ) ) +
+	                 rational32( i32( 1 ), i32( 3 ) ) ==
+	               rational32( i32( 5 ), i32( 6 ) ) );
+	static_assert( rational32( i32( 3 ), i32( -6 ) ) ==
+	               rational32( i32( -1 ), i32( 2 ) ) );
+	static_assert( rational32( i32( 3 ), i32( -6 ) ).denominator( ) == 6 );
+	static_assert( rational32( i32( 1 ), i32( 3 ) ) <
+	               rational32( i32( 1 ), i32( 2 ) ) );
+	static_assert( rational32( i32( -1 ), i32( 2 ) ) <
+	               rational32( i32( 1 ), i32( 3 ) ) );
+
+	// The terms are left alone while there is headroom
+	{
+		auto const half = rational32( i32( 2 ), i32( 4 ) );
+		auto const quarter = half * half;
+		daw_ensure( quarter.numerator( ) == 4 and quarter.denominator( ) == 16 );
+		daw_ensure( not quarter.is_normalized( ) );
+		auto const n = quarter.normalized( );
+		daw_ensure( n.numerator( ) == 1 and n.denominator( ) == 4 );
+		daw_ensure( quarter == rational32( i32( 1 ), i32( 4 ) ) );
+	}
+
+	// Against 64 bit reference fractions
+	for( int iteration = 0; iteration < 20000; ++iteration ) {
+		auto const a = next_small( );
+		auto const b = next_small( ) | 1;
+		auto const c = next_small( );
+		auto const d = next_small( ) | 1;
+		auto const x = rational32( i32( a ), i32( b ) );
+		auto const y = rational32( i32( c ), i32( d ) );
+		ensure_equal( x + y, reference( a * d + c * b, b * d ) );
+		ensure_equal( x - y, reference( a * d - c * b, b * d ) );
+		ensure_equal( x * y, reference( a * c, b * d ) );
+		if( c != 0 ) {
+			ensure_equal( x / y, reference( a * d, b * c ) );
+		}
+		ensure_equal( -x, reference( -a, b ) );
+		auto const cmp = ( a * d - c * b ) * ( b * d < 0 ? -1 : 1 );
+		daw_ensure( ( x < y ) == ( cmp < 0 ) );
+		daw_ensure( ( x == y ) == ( cmp == 0 ) );
+		daw_ensure( ( x >= y ) == ( cmp >= 0 ) );
+	}
+
+	bool has_overflow = false;
+	bool has_div_by_zero = false;
+	auto const error_handler = [&]( SignedIntegerErrorType error_type ) {
+		switch( error_type ) {
+		case SignedIntegerErrorType::Overflow:
+			has_overflow = true;
+			break;
+		case SignedIntegerErrorType::DivideByZero:
+			has_div_by_zero = true;
+			break;
+		default:
+			break;
+		}
+	};
+	register_signed_overflow_handler( error_handler );
+	register_signed_div_by_zero_handler( error_handler );
+
+	// Long chains only fit because they are reduced when they get large
+	{
+		auto product = rational32( i32( 1 ) );
+		for( std::int32_t k = 1; k <= 5000; ++k ) {
+			product *= rational32( i32( k + 1 ), i32( k ) );
+		}
+		daw_ensure( product == rational32( i32( 5001 ) ) );
+		auto sum = rational64( );
+		for( std::int64_t k = 0; k < 62; ++k ) {
+			sum += rational64( i64( 1 ), i64( std::int64_t{ 1 } << k ) );
+		}
+		daw_ensure( sum == rational64( i64( ( std::int64_t{ 1 } << 62 ) - 1 ),
+		                               i64( std::int64_t{ 1 } << 61 ) ) );
+		daw_ensure( not has_overflow );
+	}
+
+	// Comparisons are exact at the limits
+	{
+		constexpr auto max = i64::max( );
+		auto const a = rational64( max, max - i64( 1 ) );
+		auto const b = rational64( max - i64( 1 ), max - i64( 2 ) );
+		daw_ensure( a < b and b > a and a != b );
+		daw_ensure( rational64( i64::min( ), max ) < rational64( i64( -1 ) ) );
+		daw_ensure( rational64( i64::min( ), i64::min( ) ) ==
+		            rational64( i64( 1 ) ) );
+		daw_ensure( rational64( i64( 0 ), i64::min( ) ) == rational64( ) );
+		daw_ensure( rational64( i64( 6 ), i64::min( ) ).denominator( ) ==
+		            i64( std::int64_t{ 1 } << 62 ) );
+		daw_ensure( not has_overflow );
+	}
+
+	(void)( rational32( i32::max( ) ) + rational32( i32( 1 ) ) );
+	daw_ensure( has_overflow );
+	has_overflow = false;
+	(void)( rational32( i32( 1 ), i32::max( ) ) *
+	        rational32( i32( 1 ), i32::max( ) - i32( 1 ) ) );
+	daw_ensure( has_overflow );
+	has_overflow = false;
+	(void)rational32( i32( 1 ), i32::min( ) );
+	daw_ensure( has_overflow );
+
+	(void)rational32( i32( 1 ), i32( 0 ) );
+	daw_ensure( has_div_by_zero );
+	has_div_by_zero = false;
+	auto const one = rational32( i32( 1 ) );
+	daw_ensure( one / rational32( ) == one );
+	daw_ensure( has_div_by_zero );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
@@ -0,0 +1,108 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_ring_buffer.h>
+
+#include <daw/daw_ensure.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Start just before the counters wrap
+static auto const near_wrap = daw::i64::max( ) - daw::i64( 1000 );
+
+void test_spsc( ) {
+	auto queue = daw::integers::spsc_ring_buffer<std::uint64_t>( 100, near_wrap );
+	daw_ensure( queue.capacity( ) == 128 );
+	constexpr std::uint64_t count = 200'000;
+	auto consumer = std::thread( [&] {
+		std::uint64_t expected = 0;
+		std::uint64_t buff[16];
+		while( expected < count ) {
+			auto const popped = queue.pop( buff, 16 );
+			if( popped == 0 ) {
+				std::this_thread::yield( );
+			}
+			for( std::size_t n = 0; n < popped; ++n ) {
+				daw_ensure( buff[n] == expected++ );
+			}
+		}
+	} );
+	std::uint64_t next = 0;
+	while( next < count ) {
+		std::uint64_t buff[8];
+		for( auto &v : buff ) {
+			v = next++;
+		}
+		std::size_t pushed = 0;
+		while( pushed < 8 ) {
+			auto const n = queue.push( buff + pushed, 8 - pushed );
+			if( n == 0 ) {
+				std::this_thread::yield( );
+			}
+			pushed += n;
+		}
+	}
+	consumer.join( );
+	daw_ensure( queue.size( ) == 0 );
+	std::uint64_t v = 0;
+	daw_ensure( not queue.try_pop( v ) );
+}
+
+void test_mpmc( ) {
+	auto queue = daw::integers::mpmc_ring_buffer<std::uint64_t>( 64, near_wrap );
+	constexpr std::size_t threads = 4;
+	constexpr std::uint64_t per_thread = 50'000;
+	auto popped_sum = std::atomic<std::uint64_t>( 0 );
+	auto popped_count = std::atomic<std::uint64_t>( 0 );
+	auto workers = std::vector<std::thread>( );
+	for( std::size_t t = 0; t < threads; ++t ) {
+		workers.emplace_back( [&, t] {
+			for( std::uint64_t n = 0; n < per_thread; ++n ) {
+				while( not queue.try_push( t * per_thread + n ) ) {
+					std::this_thread::yield( );
+				}
+			}
+		} );
+		workers.emplace_back( [&] {
+			std::uint64_t sum = 0;
+			std::uint64_t v = 0;
+			for( std::uint64_t n = 0; n < per_thread; ++n ) {
+				while( not queue.try_pop( v ) ) {
+					std::this_thread::yield( );
+				}
+				sum += v;
+			}
+			popped_sum += sum;
+			popped_count += per_thread;
+		} );
+	}
+	for( auto &w : workers ) {
+		w.join( );
+	}
+	constexpr auto total = threads * per_thread;
+	daw_ensure( popped_count == total );
+	daw_ensure( popped_sum == total * ( total - 1 ) / 2 );
+
+	// Batches stop at full and at empty
+	auto values = std::vector<std::uint64_t>( 100, 7 );
+	daw_ensure( queue.push( values.data( ), values.size( ) ) == 64 );
+	daw_ensure( queue.pop( values.data( ), values.size( ) ) == 64 );
+}
+
+int main( ) try {
+	test_spsc( );
+	test_mpmc( );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
@@ -0,0 +1,157 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_random.h>
+#include <daw/integers/daw_signed.h>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_ensure.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using daw::integers::i16;
+using daw::integers::i32;
+using daw::integers::i64;
+using daw::integers::i8;
+using daw::integers::saturate_branchless;
+using daw::integers::saturate_branchy;
+using daw::integers::xoshiro256pp;
+
+static_assert( i8( 100 ).add_saturated( i8( 100 ), saturate_branchless ) ==
+               i8( 127 ) );
+static_assert( i8( -100 ).sub_saturated( i8( 100 ), saturate_branchless ) ==
+               i8( -128 ) );
+static_assert( i8( -100 ).mul_saturated( i8( 2 ), saturate_branchless ) ==
+               i8( -128 ) );
+static_assert( i8( -100 ).mul_saturated( i8( -2 ), saturate_branchless ) ==
+               i8( 127 ) );
+static_assert( i32( 5 ).add_saturated( i32( -7 ), saturate_branchless ) ==
+               i32( -2 ) );
+
+template<typename SI>
+SI from_bits( std::uint64_t bits ) {
+	using value_type = typename SI::value_type;
+	using unsigned_t = std::make_unsigned_t<value_type>;
+	return SI( static_cast<value_type>( static_cast<unsigned_t>( bits ) ) );
+}
+
+template<typename SI>
+void check_agree( SI a, SI b ) {
+	daw_ensure( a.add_saturated( b, saturate_branchy ) ==
+	            a.add_saturated( b, saturate_branchless ) );
+	daw_ensure( a.sub_saturated( b, saturate_branchy ) ==
+	            a.sub_saturated( b, saturate_branchless ) );
+	daw_ensure( a.mul_saturated( b, saturate_branchy ) ==
+	            a.mul_saturated( b, saturate_branchless ) );
+}
+
+template<typename SI>
+void test_policies_agree( ) {
+	using value_type = typename SI::value_type;
+	using limits = std::numeric_limits<value_type>;
+	value_type const extremes[] = {
+	  limits::min( ),
+	  static_cast<value_type>( limits::min( ) + 1 ),
+	  static_cast<value_type>( limits::min( ) / 2 ),
+	  static_cast<value_type>( -2 ),
+	  static_cast<value_type>( -1 ),
+	  static_cast<value_type>( 0 ),
+	  static_cast<value_type>( 1 ),
+	  static_cast<value_type>( 2 ),
+	  static_cast<value_type>( limits::max( ) / 2 ),
+	  static_cast<value_type>( limits::max( ) - 1 ),
+	  limits::max( ) };
+	for( auto a : extremes ) {
+		for( auto b : extremes ) {
+			check_agree( SI( a ), SI( b ) );
+		}
+	}
+	auto rng = xoshiro256pp( 96 );
+	for( int n = 0; n < 100'000; ++n ) {
+		auto const bits = rng( );
+		// Mix full width values with small ones so both the overflowing and
+		// the non-overflowing paths are exercised
+		auto const shift = static_cast<unsigned>( rng( ) % ( sizeof( SI ) * 8U ) );
+		check_agree( from_bits<SI>( bits ), from_bits<SI>( rng( ) >> shift ) );
+	}
+}
+
+// Builds operand pairs for a + b where roughly percent of the additions
+// overflow, in an unpredictable order
+std::vector<std::int32_t> make_operands( unsigned percent, std::size_t count ) {
+	auto result = std::vector<std::int32_t>( count * 2U );
+	auto rng = xoshiro256pp( 96 );
+	for( std::size_t n = 0; n < count; ++n ) {
+		bool const overflow = rng( ) % 100U < percent;
+		auto const a = static_cast<std::int32_t>( rng( ) % 0x4000'0000U );
+		auto const b =
+		  overflow ? std::numeric_limits<std::int32_t>::max( ) - a / 2
+		           : static_cast<std::int32_t>( rng( ) % 0x4000'0000U );
+		bool const negate = ( rng( ) & 1U ) != 0;
+		result[n * 2U] = negate ? -a : a;
+		result[n * 2U + 1U] = negate ? -b : b;
+	}
+	return result;
+}
+
+template<typename Policy>
+double time_add_saturated( std::vector<std::int32_t> const &operands,
+                           Policy policy ) {
+	constexpr int repetitions = 20;
+	auto const count = operands.size( ) / 2U;
+	auto best = std::chrono::duration<double, std::nano>::max( );
+	for( int r = 0; r < repetitions; ++r ) {
+		auto sum = i32( 0 );
+		auto const start = std::chrono::steady_clock::now( );
+		for( std::size_t n = 0; n < count; ++n ) {
+			auto const a = i32( operands[n * 2U] );
+			auto const b = i32( operands[n * 2U + 1U] );
+			// Fold in with a wrapping op so the result depends on every element
+			sum = sum.add_wrapped( a.add_saturated( b, policy ) );
+		}
+		daw::do_not_optimize( sum );
+		auto const elapsed = std::chrono::steady_clock::now( ) - start;
+		if( elapsed < best ) {
+			best = elapsed;
+		}
+	}
+	return best.count( ) / static_cast<double>( count );
+}
+
+void bench_overflow_probability( ) {
+	constexpr std::size_t count = 1U << 16U;
+	std::cout << "i32 add_saturated, ns/op\n";
+	std::cout << "overflow%   branchy  branchless\n";
+	for( unsigned percent : { 0U, 1U, 2U, 5U, 10U, 20U, 30U, 40U, 50U } ) {
+		auto const operands = make_operands( percent, count );
+		auto const branchy = time_add_saturated( operands, saturate_branchy );
+		auto const branchless =
+		  time_add_saturated( operands, saturate_branchless );
+		std::cout << std::setw( 9 ) << percent << std::fixed
+		          << std::setprecision( 3 ) << std::setw( 10 ) << branchy
+		          << std::setw( 12 ) << branchless << '\n';
+	}
+}
+
+int main( ) try {
+	test_policies_agree<i8>( );
+	test_policies_agree<i16>( );
+	test_policies_agree<i32>( );
+	test_policies_agree<i64>( );
+
+	bench_overflow_probability( );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
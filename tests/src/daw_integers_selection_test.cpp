@@ -0,0 +1,74 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_selection.h>
+
+#include <daw/daw_ensure.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+template<typename SignedInteger>
+std::vector<SignedInteger> make_values( std::size_t count, std::uint64_t seed,
+                                        std::uint64_t modulus ) {
+	auto result = std::vector<SignedInteger>( );
+	using value_t = typename SignedInteger::value_type;
+	for( std::size_t n = 0; n < count; ++n ) {
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		auto const v = static_cast<value_t>( ( seed >> 17U ) % modulus );
+		result.push_back( SignedInteger::conversion_unchecked(
+		  static_cast<value_t>( v - static_cast<value_t>( modulus / 2 ) ) ) );
+	}
+	return result;
+}
+
+template<typename SignedInteger>
+void test_selection( std::size_t count, std::uint64_t modulus,
+                     std::size_t thread_count ) {
+	auto const values = make_values<SignedInteger>( count, 42, modulus );
+	auto sorted = values;
+	std::sort( sorted.begin( ), sorted.end( ) );
+	for( std::size_t k : { std::size_t{ 0 }, count / 3, count / 2, count - 1 } ) {
+		daw_ensure( daw::integers::radix_select( values, k, thread_count ) ==
+		            sorted[k] );
+	}
+	auto top = std::vector<SignedInteger>( 25 );
+	auto const written = daw::integers::top_k( values, top );
+	daw_ensure( written == std::min( count, top.size( ) ) );
+	for( std::size_t n = 0; n < written; ++n ) {
+		daw_ensure( top[n] == sorted[count - 1 - n] );
+	}
+}
+
+int main( ) try {
+	for( std::size_t threads : { 1U, 4U } ) {
+		test_selection<daw::i8>( 1000, 256, threads );
+		test_selection<daw::i16>( 10, 1000, threads );
+		test_selection<daw::i32>( 100'000, 1'000'000'000, threads );
+		test_selection<daw::i32>( 300'000, 7, threads );
+		test_selection<daw::i64>( 300'000, 1ULL << 40U, threads );
+	}
+	bool has_out_of_range = false;
+	auto const error_handler =
+	  [&]( daw::integers::SignedIntegerErrorType error_type ) {
+		  if( error_type == daw::integers::SignedIntegerErrorType::OutOfRange ) {
+			  has_out_of_range = true;
+		  }
+	  };
+	daw::integers::register_signed_out_of_range_handler( error_handler );
+	auto const values = make_values<daw::i32>( 10, 1, 100 );
+	(void)daw::integers::radix_select( values, 10 );
+	daw_ensure( has_out_of_range );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
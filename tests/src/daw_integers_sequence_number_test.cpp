@@ -0,0 +1,57 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_sequence_number.h>
+
+#include <daw/daw_ensure.h>
+
+#include <iostream>
+
+using daw::integers::seq16;
+using daw::integers::seq32;
+using daw::integers::seq8;
+
+static_assert( seq8( daw::i8( 127 ) ) + daw::i8( 1 ) ==
+               seq8( daw::i8::min( ) ) );
+static_assert( seq8( daw::i8( 127 ) ) < seq8( daw::i8::min( ) ) );
+static_assert( seq8( daw::i8( -1 ) ) < seq8( daw::i8( 0 ) ) );
+static_assert( seq8( daw::i8( 100 ) ) < seq8( daw::i8( -100 ) ) );
+static_assert( seq8( daw::i8( 0 ) ) <= seq8( daw::i8( 0 ) ) );
+static_assert( seq8( daw::i8( 0 ) ) >= seq8( daw::i8( 0 ) ) );
+static_assert( seq8( daw::i8( -100 ) ) - seq8( daw::i8( 100 ) ) ==
+               daw::i8( 56 ) );
+// Exactly half the space apart is unordered
+static_assert( not( seq8( daw::i8( 0 ) ) < seq8( daw::i8::min( ) ) ) );
+static_assert( not( seq8( daw::i8::min( ) ) < seq8( daw::i8( 0 ) ) ) );
+
+template<typename Seq>
+void test_wrap( typename Seq::value_type start ) {
+	auto s = Seq( start );
+	auto prev = s;
+	for( int n = 0; n < 1000; ++n ) {
+		++s;
+		daw_ensure( prev < s );
+		daw_ensure( s > prev );
+		daw_ensure( not( s < prev ) );
+		daw_ensure( s - prev == typename Seq::difference_type( 1 ) );
+		prev = s;
+	}
+	daw_ensure( Seq( start ).distance_to( s ) ==
+	            typename Seq::difference_type( 1000 ) );
+	s -= typename Seq::difference_type( 1000 );
+	daw_ensure( s == Seq( start ) );
+}
+
+int main( ) try {
+	test_wrap<seq16>( daw::i16::max( ) - daw::i16( 500 ) );
+	test_wrap<seq32>( daw::i32::max( ) - daw::i32( 10 ) );
+	test_wrap<daw::integers::sequence_number<64>>( daw::i64( -500 ) );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
@@ -0,0 +1,249 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include "daw_integers_test_support.h"
+
+#include <daw/integers/daw_random.h>
+#include <daw/integers/daw_shift.h>
+
+#include <daw/daw_ensure.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using daw::integers::i16;
+using daw::integers::i32;
+using daw::integers::i64;
+using daw::integers::i8;
+using daw::integers::xoshiro256pp;
+using daw::integers::test::random_magnitude;
+
+static_assert( i32( 5 ).shl_checked( i32( 0 ) ) == i32( 5 ) );
+static_assert( i32( -3 ).shl_checked( i32( 4 ) ) == i32( -48 ) );
+static_assert( i8( 1 ).shl_saturated( i8( 7 ) ) == i8::max( ) );
+static_assert( i8( -1 ).shl_saturated( i8( 7 ) ) == i8::min( ) );
+static_assert( i8( -1 ).shl_saturated( i8( 100 ) ) == i8::min( ) );
+static_assert( i8( 0 ).shl_saturated( i8( 100 ) ) == i8( 0 ) );
+static_assert( i16( 3 ).shl_saturated( i16( 2 ) ) == i16( 12 ) );
+static_assert( i64( -5 ).shl_saturated( i64( 62 ) ) == i64::min( ) );
+
+namespace {
+	std::size_t overflow_count = 0;
+	std::size_t out_of_range_count = 0;
+
+	// The exact value of v << k, if it fits
+	template<typename SI>
+	bool reference_shl( SI v, int k, SI &result ) {
+		using value_type = typename SI::value_type;
+		if( k < 0 or k >= static_cast<int>( sizeof( value_type ) * 8 ) ) {
+			return false;
+		}
+		auto const limit = std::numeric_limits<value_type>::max( ) >> k;
+		auto const x = v.value( );
+		if( x > limit or x < -limit - 1 ) {
+			return false;
+		}
+		result = SI( static_cast<value_type>( x * ( value_type{ 1 } << k ) ) );
+		return true;
+	}
+
+	template<typename SI>
+	SI reference_shl_saturated( SI v, int k ) {
+		auto result = SI( 0 );
+		if( reference_shl( v, k, result ) or v == 0 ) {
+			return result;
+		}
+		return v < 0 ? SI::min( ) : SI::max( );
+	}
+
+	template<typename SI>
+	void test_scalar( ) {
+		using value_type = typename SI::value_type;
+		constexpr int bits = static_cast<int>( sizeof( value_type ) * 8 );
+		auto rng = xoshiro256pp( 97 );
+		for( int n = 0; n < 200'000; ++n ) {
+			auto const v = random_magnitude<SI>( rng );
+			auto const k = static_cast<int>( rng( ) % ( bits + 2 ) ) - 1;
+			auto expected = SI( 0 );
+			bool const fits = reference_shl( v, k, expected );
+			auto const before = overflow_count;
+			auto const result = v.shl_checked( SI( k ) );
+			daw_ensure( ( overflow_count != before ) == not fits );
+			if( fits ) {
+				daw_ensure( result == expected );
+			}
+			if( k >= 0 ) {
+				daw_ensure( v.shl_saturated( SI( k ) ) ==
+				            reference_shl_saturated( v, k ) );
+			}
+		}
+		// A zero count never overflows
+		auto const before = overflow_count;
+		daw_ensure( SI::min( ).shl_checked( SI( 0 ) ) == SI::min( ) );
+		daw_ensure( SI::max( ).shl_checked( SI( 0 ) ) == SI::max( ) );
+		daw_ensure( overflow_count == before );
+		// Neither does shifting a one into the sign bit of a negative value
+		daw_ensure( SI( -1 ).shl_checked( SI( bits - 1 ) ) == SI::min( ) );
+		daw_ensure( overflow_count == before );
+		daw_ensure( SI( 1 ).shl_checked( SI( bits - 2 ) ) ==
+		            SI( value_type{ 1 } << ( bits - 2 ) ) );
+		daw_ensure( overflow_count == before );
+		(void)SI( 1 ).shl_checked( SI( bits - 1 ) );
+		daw_ensure( overflow_count == before + 1 );
+		(void)SI( 1 ).shl_saturated( SI( -1 ) );
+		daw_ensure( overflow_count == before + 2 );
+	}
+
+	template<typename SI>
+	void test_span( std::size_t size ) {
+		using value_type = typename SI::value_type;
+		constexpr int bits = static_cast<int>( sizeof( value_type ) * 8 );
+		auto rng = xoshiro256pp( 97 );
+		auto values = std::vector<SI>( size, SI( 0 ) );
+		auto counts = std::vector<SI>( size, SI( 0 ) );
+		// Small enough that shifts of up to 3 fit
+		constexpr auto limit =
+		  static_cast<std::int64_t>( std::numeric_limits<value_type>::max( ) >> 3 );
+		for( std::size_t n = 0; n < size; ++n ) {
+			values[n] = SI( static_cast<value_type>(
+			  static_cast<std::int64_t>(
+			    rng( ) % static_cast<std::uint64_t>( 2 * limit + 1 ) ) -
+			  limit ) );
+			counts[n] = SI( static_cast<int>( rng( ) % 4U ) );
+		}
+		auto out = std::vector<SI>( size, SI( 0 ) );
+
+		// Uniform count, nothing lost
+		for( int k = 0; k < 4; ++k ) {
+			auto const before = overflow_count;
+			daw_ensure( daw::integers::shl_checked( values, SI( k ), out ) == size );
+			daw_ensure( overflow_count == before );
+			for( std::size_t n = 0; n < size; ++n ) {
+				auto expected = SI( 0 );
+				daw_ensure( reference_shl( values[n], k, expected ) );
+				daw_ensure( out[n] == expected );
+			}
+		}
+		// Per element count, nothing lost
+		{
+			auto const before = overflow_count;
+			daw_ensure( daw::integers::shl_checked( values, counts, out ) == size );
+			daw_ensure( overflow_count == before );
+			for( std::size_t n = 0; n < size; ++n ) {
+				auto expected = SI( 0 );
+				daw_ensure(
+				  reference_shl( values[n], static_cast<int>( counts[n].value( ) ),
+				                 expected ) );
+				daw_ensure( out[n] == expected );
+			}
+		}
+		if( size == 0 ) {
+			return;
+		}
+		// Plant a value that loses bits and check the position is reported
+		auto const bad = size - 1 - static_cast<std::size_t>( rng( ) % size );
+		auto const saved = values[bad];
+		values[bad] = SI::max( );
+		{
+			auto const before = overflow_count;
+			daw_ensure( daw::integers::shl_checked( values, SI( 1 ), out ) == bad );
+			daw_ensure( overflow_count == before + 1 );
+			counts[bad] = SI( 1 );
+			daw_ensure( daw::integers::shl_checked( values, counts, out ) == bad );
+			daw_ensure( overflow_count == before + 2 );
+		}
+		values[bad] = saved;
+		// An out of range count in one lane
+		{
+			auto const before = overflow_count;
+			counts[bad] = SI( bits );
+			daw_ensure( daw::integers::shl_checked( values, counts, out ) == bad );
+			daw_ensure( overflow_count == before + 1 );
+			(void)daw::integers::shl_checked( values, SI( bits ), out );
+			daw_ensure( overflow_count == before + 2 );
+		}
+
+		// Saturating over wide ranges of values and counts, in place
+		for( std::size_t n = 0; n < size; ++n ) {
+			values[n] = random_magnitude<SI>( rng );
+			counts[n] = SI( static_cast<int>( rng( ) % ( bits + 3 ) ) );
+		}
+		for( int k : { 0, 1, bits / 2, bits - 1, bits, bits + 5 } ) {
+			daw::integers::shl_saturated( values, SI( k ), out );
+			for( std::size_t n = 0; n < size; ++n ) {
+				daw_ensure( out[n] == reference_shl_saturated( values[n], k ) );
+			}
+		}
+		daw::integers::shl_saturated( values, counts, out );
+		for( std::size_t n = 0; n < size; ++n ) {
+			auto const k = static_cast<int>( counts[n].value( ) );
+			daw_ensure( out[n] == reference_shl_saturated( values[n], k ) );
+		}
+		out = values;
+		daw::integers::shl_saturated( out, SI( 3 ), out );
+		for( std::size_t n = 0; n < size; ++n ) {
+			daw_ensure( out[n] == reference_shl_saturated( values[n], 3 ) );
+		}
+		// A negative count is reported and the values pass through
+		{
+			auto const before = overflow_count;
+			counts[bad] = SI( -1 );
+			daw::integers::shl_saturated( values, counts, out );
+			daw_ensure( overflow_count == before + 1 );
+			daw_ensure( out[bad] == values[bad] );
+		}
+	}
+
+	template<typename SI>
+	void test_spans( ) {
+		for( std::size_t size : { 0U, 1U, 7U, 31U, 64U, 333U, 4096U } ) {
+			test_span<SI>( size );
+		}
+	}
+
+	void test_range_sizes( ) {
+		auto const values = std::vector<i32>( 10, i32( 1 ) );
+		auto const counts = std::vector<i32>( 5, i32( 1 ) );
+		auto out = std::vector<i32>( 8, i32( 0 ) );
+		auto const before = out_of_range_count;
+		daw_ensure( daw::integers::shl_checked( values, i32( 2 ), out ) == 8 );
+		daw_ensure( out_of_range_count == before + 1 );
+		daw_ensure( daw::integers::shl_checked( values, counts, out ) == 5 );
+		daw_ensure( out_of_range_count == before + 2 );
+		daw_ensure( out[4] == i32( 2 ) and out[5] == i32( 4 ) );
+	}
+} // namespace
+
+int main( ) try {
+	auto const on_overflow = []( daw::integers::SignedIntegerErrorType ) {
+		++overflow_count;
+	};
+	auto const on_out_of_range = []( daw::integers::SignedIntegerErrorType ) {
+		++out_of_range_count;
+	};
+	daw::integers::register_signed_overflow_handler( on_overflow );
+	daw::integers::register_signed_out_of_range_handler( on_out_of_range );
+
+	test_scalar<i8>( );
+	test_scalar<i16>( );
+	test_scalar<i32>( );
+	test_scalar<i64>( );
+
+	test_spans<i8>( );
+	test_spans<i16>( );
+	test_spans<i32>( );
+	test_spans<i64>( );
+
+	test_range_sizes( );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
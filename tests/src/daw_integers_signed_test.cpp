@@ -309,6 +309,16 @@ int main( ) try {
 		(void)i2;
 		daw_ensure( not has_overflow );
 	}
+	{
+		has_overflow = false;
+		daw_ensure( daw::i8::conversion_saturated( 300 ) == 127 );
+		daw_ensure( daw::i8::conversion_saturated( -300 ) == -128 );
+		daw_ensure( daw::i8::conversion_saturated( -5 ) == -5 );
+		daw_ensure( daw::i16::conversion_saturated( daw::i64( 1 ) << 40 ) ==
+		            daw::numeric_limits<daw::i16>::max( ) );
+		daw_ensure( daw::i64::conversion_saturated( daw::i8( -128 ) ) == -128 );
+		daw_ensure( not has_overflow );
+	}
 	{
 		constexpr std::uint32_t le_val = 0x0123'4567U;
 		constexpr std::uint32_t be_val = 0x6745'2301U;
@@ -411,6 +421,10 @@ int main( ) try {
 	               daw::i64::conversion_unchecked( 0x5555'5555'5555'5555ULL ) );
 	static_assert( daw::i64::conversion_unchecked( 0x8000'0000'0000'0000ULL )
 	                 .reverse_bits( ) == daw::i64::conversion_unchecked( 1ULL ) );
+
+	static_assert( daw::i32( 3 ) - daw::i32( 5 ) == daw::i32( -2 ) );
+	static_assert( daw::i64( 3 ) - daw::i16( 5 ) == daw::i64( -2 ) );
+	static_assert( daw::i64( -7 ) % daw::i64( 3 ) == daw::i64( -1 ) );
 } catch( ... ) {
 	std::cerr << "Unexpected exception thrown\n" << std::flush;
 	throw;
@@ -0,0 +1,99 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_sorted_set.h>
+
+#include <daw/daw_ensure.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+template<typename SignedInteger>
+std::vector<SignedInteger> make_set( std::int64_t first, std::int64_t stride,
+                                     std::size_t count ) {
+	auto result = std::vector<SignedInteger>( );
+	for( std::size_t n = 0; n < count; ++n ) {
+		result.push_back( SignedInteger( first ) );
+		first += stride;
+	}
+	return result;
+}
+
+template<typename SignedInteger>
+void test_sets( std::vector<SignedInteger> const &lhs,
+                std::vector<SignedInteger> const &rhs ) {
+	auto expected = std::vector<SignedInteger>( );
+	std::set_intersection( lhs.begin( ), lhs.end( ), rhs.begin( ), rhs.end( ),
+	                       std::back_inserter( expected ) );
+	auto out = std::vector<SignedInteger>( std::min( lhs.size( ), rhs.size( ) ) );
+	auto count = daw::integers::intersect_sorted( lhs, rhs, out );
+	out.resize( count );
+	daw_ensure( out == expected );
+
+	out.assign( std::min( lhs.size( ), rhs.size( ) ), SignedInteger( 0 ) );
+	count = daw::integers::galloping_intersect( lhs, rhs, out );
+	out.resize( count );
+	daw_ensure( out == expected );
+
+	expected.clear( );
+	std::set_union( lhs.begin( ), lhs.end( ), rhs.begin( ), rhs.end( ),
+	                std::back_inserter( expected ) );
+	out.assign( lhs.size( ) + rhs.size( ), SignedInteger( 0 ) );
+	count = daw::integers::union_sorted( lhs, rhs, out );
+	out.resize( count );
+	daw_ensure( out == expected );
+}
+
+template<typename SignedInteger>
+void test_all( ) {
+	test_sets( make_set<SignedInteger>( -100, 3, 1000 ),
+	           make_set<SignedInteger>( -90, 5, 700 ) );
+	test_sets( make_set<SignedInteger>( 0, 1, 1000 ),
+	           make_set<SignedInteger>( 0, 1, 1000 ) );
+	test_sets( make_set<SignedInteger>( 0, 2, 1000 ),
+	           make_set<SignedInteger>( 1, 2, 1000 ) );
+	test_sets( make_set<SignedInteger>( 0, 1, 5000 ),
+	           make_set<SignedInteger>( 7, 301, 10 ) );
+	test_sets( make_set<SignedInteger>( 0, 1, 0 ),
+	           make_set<SignedInteger>( 7, 301, 10 ) );
+	test_sets( make_set<SignedInteger>( 5, 7, 13 ),
+	           make_set<SignedInteger>( 5, 7, 13 ) );
+}
+
+int main( ) try {
+	test_all<daw::i16>( );
+	test_all<daw::i32>( );
+	test_all<daw::i64>( );
+
+	bool has_out_of_range = false;
+	auto const error_handler =
+	  [&]( daw::integers::SignedIntegerErrorType error_type ) {
+		  if( error_type == daw::integers::SignedIntegerErrorType::OutOfRange ) {
+			  has_out_of_range = true;
+		  }
+	  };
+	daw::integers::register_signed_out_of_range_handler( error_handler );
+	auto const lhs = make_set<daw::i32>( 0, 1, 100 );
+	auto const rhs = make_set<daw::i32>( 50, 1, 100 );
+	auto out = std::vector<daw::i32>( 200 );
+	daw_ensure( daw::integers::union_sorted( lhs, rhs, out ) == 150 );
+	daw_ensure( not has_out_of_range );
+	out.resize( 199 );
+	daw_ensure( daw::integers::union_sorted( lhs, rhs, out ) == 0 );
+	daw_ensure( has_out_of_range );
+	has_out_of_range = false;
+	out.resize( 99 );
+	daw_ensure( daw::integers::intersect_sorted( lhs, rhs, out ) == 0 );
+	daw_ensure( has_out_of_range );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
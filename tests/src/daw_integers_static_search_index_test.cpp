@@ -0,0 +1,64 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_static_search_index.h>
+
+#include <daw/daw_ensure.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+template<typename SignedInteger>
+void test_index( std::size_t count ) {
+	auto sorted = std::vector<SignedInteger>( );
+	for( std::size_t n = 0; n < count; ++n ) {
+		// Includes duplicates and negatives
+		sorted.push_back(
+		  SignedInteger( static_cast<std::int64_t>( n / 2 * 3 ) - 100 ) );
+	}
+	auto const index = daw::integers::static_search_index( sorted );
+	daw_ensure( index.size( ) == count );
+
+	auto queries = std::vector<SignedInteger>( );
+	for( std::int64_t v = -105; v < static_cast<std::int64_t>( count * 2 ); ++v ) {
+		queries.push_back( SignedInteger( v ) );
+	}
+	auto lower = std::vector<std::size_t>( queries.size( ) );
+	auto upper = std::vector<std::size_t>( queries.size( ) );
+	index.lower_bound( queries, lower );
+	index.upper_bound( queries, upper );
+	for( std::size_t n = 0; n < queries.size( ); ++n ) {
+		auto const q = queries[n];
+		auto const expected_lower = static_cast<std::size_t>(
+		  std::lower_bound( sorted.begin( ), sorted.end( ), q ) - sorted.begin( ) );
+		auto const expected_upper = static_cast<std::size_t>(
+		  std::upper_bound( sorted.begin( ), sorted.end( ), q ) - sorted.begin( ) );
+		daw_ensure( index.lower_bound( q ) == expected_lower );
+		daw_ensure( index.upper_bound( q ) == expected_upper );
+		daw_ensure( lower[n] == expected_lower );
+		daw_ensure( upper[n] == expected_upper );
+		daw_ensure( index.contains( q ) ==
+		            std::binary_search( sorted.begin( ), sorted.end( ), q ) );
+	}
+}
+
+int main( ) try {
+	for( std::size_t count : { 0U, 1U, 2U, 3U, 7U, 8U, 15U, 16U, 100U, 1000U } ) {
+		test_index<daw::i16>( count );
+		test_index<daw::i32>( count );
+		test_index<daw::i64>( count );
+	}
+	auto const empty = daw::integers::static_search_index<64>( );
+	daw_ensure( empty.lower_bound( daw::i64( 5 ) ) == 0 );
+	daw_ensure( not empty.contains( daw::i64( 5 ) ) );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
@@ -0,0 +1,30 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#pragma once
+
+#include <daw/integers/daw_random.h>
+#include <daw/integers/daw_signed.h>
+
+#include <cstdint>
+
+namespace daw::integers::test {
+	/// @brief A value whose magnitude is a uniformly chosen power of two, then
+	/// uniform below that.  Small and large values are equally likely, so
+	/// operations that overflow near the edge of the type are exercised
+	/// about as often as those that do not
+	template<typename SI, typename URBG>
+	SI random_magnitude( URBG &rng ) {
+		using value_type = typename SI::value_type;
+		constexpr auto bits = static_cast<unsigned>( sizeof( value_type ) * 8U );
+		auto const width = static_cast<unsigned>( rng( ) % bits );
+		auto const limit =
+		  SI( static_cast<value_type>( ( std::uint64_t{ 1 } << width ) - 1U ) );
+		return uniform_int( rng, -limit - SI( 1 ), limit );
+	}
+} // namespace daw::integers::test
@@ -0,0 +1,130 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_token_bucket.h>
+
+#include <daw/daw_ensure.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using bucket_t = daw::integers::token_bucket<>;
+
+void test_refill( ) {
+	auto const start = bucket_t::clock_type::now( );
+	auto bucket = bucket_t( daw::i64( 10 ), daw::i64( 4 ), start );
+	daw_ensure( bucket.available( start ) == daw::i64( 10 ) );
+	daw_ensure( bucket.try_consume( daw::i64( 10 ), start ) );
+	daw_ensure( not bucket.try_consume( daw::i64( 1 ), start ) );
+	// 4 per second, fractions of a token carry over
+	daw_ensure( bucket.available( start + 300ms ) == daw::i64( 1 ) );
+	daw_ensure( bucket.available( start + 500ms ) == daw::i64( 2 ) );
+	daw_ensure( bucket.available( start + 1s ) == daw::i64( 4 ) );
+	// Refills stop at the capacity
+	daw_ensure( bucket.available( start + 1h ) == daw::i64( 10 ) );
+	// Time going backwards credits nothing
+	daw_ensure( bucket.try_consume( daw::i64( 3 ), start ) );
+	daw_ensure( bucket.available( start ) == daw::i64( 7 ) );
+}
+
+void test_saturated_refill( ) {
+	auto const start = bucket_t::clock_type::now( );
+	auto bucket =
+	  bucket_t( daw::i64::max( ), daw::i64::max( ) - daw::i64( 1 ), start );
+	daw_ensure( bucket.try_consume( daw::i64::max( ), start ) );
+	// elapsed * rate overflows and saturates instead of wrapping
+	daw_ensure( bucket.available( start + 24h ) == daw::i64::max( ) );
+}
+
+void test_fast_rate( ) {
+	// More than one token per nanosecond.  The refill time must still advance
+	// so the same instant is not credited twice
+	auto const start = bucket_t::clock_type::now( );
+	auto bucket =
+	  bucket_t( daw::i64( 1'000 ), daw::i64( 1'500'000'000 ), start );
+	daw_ensure( bucket.try_consume( daw::i64( 1'000 ), start ) );
+	std::size_t taken = 0;
+	for( std::size_t n = 0; n < 1000; ++n ) {
+		taken += static_cast<std::size_t>(
+		  bucket.try_consume( daw::i64( 1 ), start + 1ns ) );
+	}
+	daw_ensure( taken == 1 );
+
+	// A rate that does not divide a second never credits early.  7 per
+	// second earns one token every 142'857'142.857ns.  Rounding the time used
+	// up gives back at most 1ns per refill
+	auto slow = bucket_t( daw::i64( 10'000 ), daw::i64( 7 ), start );
+	daw_ensure( slow.try_consume( daw::i64( 10'000 ), start ) );
+	for( std::int64_t n = 1; n < 6'990; ++n ) {
+		(void)slow.available( start + std::chrono::nanoseconds( n * 142'857'143 ) );
+	}
+	daw_ensure( slow.available( start + 1000s - 1ns ) == daw::i64( 6'999 ) );
+	daw_ensure( slow.available( start + 1000s + 7us ) == daw::i64( 7'000 ) );
+}
+
+void test_large_capacity( ) {
+	// A product that does not fit in 64 bits is still exact when the
+	// capacity is larger than i64::max( ) / 1s
+	auto const start = bucket_t::clock_type::now( );
+	auto bucket = bucket_t( daw::i64( 100'000'000'000 ),
+	                        daw::i64( 50'000'000'000 ), start );
+	daw_ensure( bucket.try_consume( bucket.capacity( ), start ) );
+	daw_ensure( bucket.available( start + 1s ) == daw::i64( 50'000'000'000 ) );
+}
+
+void test_concurrent( ) {
+	auto const start = bucket_t::clock_type::now( );
+	constexpr std::size_t capacity = 100'000;
+	auto bucket = bucket_t( daw::i64( capacity ), daw::i64( 1 ), start );
+	auto taken = std::atomic<std::size_t>( 0 );
+	auto threads = std::vector<std::thread>( );
+	for( std::size_t t = 0; t < 4; ++t ) {
+		threads.emplace_back( [&] {
+			std::size_t count = 0;
+			for( std::size_t n = 0; n < capacity; ++n ) {
+				count += static_cast<std::size_t>(
+				  bucket.try_consume( daw::i64( 1 ), start ) );
+			}
+			taken += count;
+		} );
+	}
+	for( auto &th : threads ) {
+		th.join( );
+	}
+	daw_ensure( taken == capacity );
+	daw_ensure( bucket.available( start ) == daw::i64( 0 ) );
+}
+
+int main( ) try {
+	test_refill( );
+	test_saturated_refill( );
+	test_fast_rate( );
+	test_large_capacity( );
+	test_concurrent( );
+
+	bool has_out_of_range = false;
+	auto const error_handler =
+	  [&]( daw::integers::SignedIntegerErrorType error_type ) {
+		  if( error_type == daw::integers::SignedIntegerErrorType::OutOfRange ) {
+			  has_out_of_range = true;
+		  }
+	  };
+	daw::integers::register_signed_out_of_range_handler( error_handler );
+	auto bucket = bucket_t( daw::i64( 5 ), daw::i64( 1 ) );
+	daw_ensure( not bucket.try_consume( daw::i64( -1 ) ) );
+	daw_ensure( has_out_of_range );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}
@@ -0,0 +1,161 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/daw_integer
+//
+
+#include <daw/integers/daw_random.h>
+#include <daw/integers/daw_widen.h>
+
+#include <daw/daw_ensure.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using daw::integers::i16;
+using daw::integers::i32;
+using daw::integers::i64;
+using daw::integers::i8;
+
+namespace {
+	std::size_t overflow_count = 0;
+	std::size_t out_of_range_count = 0;
+
+	template<typename From>
+	std::vector<From> random_values( std::size_t count ) {
+		auto rng = daw::integers::xoshiro256pp( 99 );
+		auto result = std::vector<From>( count, From( 0 ) );
+		daw::integers::uniform_fill( rng, From::min( ), From::max( ), result );
+		if( count >= 2 ) {
+			result[0] = From::min( );
+			result[count - 1] = From::max( );
+		}
+		return result;
+	}
+
+	template<typename To, typename From>
+	void test_widen( std::size_t count ) {
+		using from_t = typename From::value_type;
+		using to_t = typename To::value_type;
+		auto const in = random_values<From>( count );
+		auto out = std::vector<To>( count, To( 0 ) );
+		daw::integers::widen( in, out );
+		for( std::size_t n = 0; n < count; ++n ) {
+			daw_ensure( out[n] == To( in[n] ) );
+		}
+
+		// Frame of reference decoding that can never overflow
+		auto const base = To( std::numeric_limits<to_t>::max( ) / 2 );
+		daw_ensure( daw::integers::widen( in, out, base ) == count );
+		for( std::size_t n = 0; n < count; ++n ) {
+			daw_ensure( out[n] ==
+			            To( static_cast<to_t>( base.value( ) + in[n].value( ) ) ) );
+		}
+		auto const scale = To( -3 );
+		daw_ensure( daw::integers::widen( in, out, base, scale ) == count );
+		for( std::size_t n = 0; n < count; ++n ) {
+			auto const expected = base.value( ) + in[n].value( ) * scale.value( );
+			daw_ensure( out[n] == To( static_cast<to_t>( expected ) ) );
+		}
+		if( count == 0 ) {
+			return;
+		}
+
+		// A base and scale where only part of the input range fits.  The
+		// largest inputs overflow
+		auto const big_scale = To( static_cast<to_t>(
+		  std::numeric_limits<to_t>::max( ) /
+		  -static_cast<to_t>( std::numeric_limits<from_t>::min( ) ) ) );
+		auto const threshold = static_cast<from_t>(
+		  std::numeric_limits<from_t>::max( ) / 2 );
+		auto const big_base =
+		  To( static_cast<to_t>( std::numeric_limits<to_t>::max( ) -
+		                         big_scale.value( ) * threshold ) );
+		auto clipped = in;
+		std::size_t first_bad = count;
+		for( std::size_t n = 0; n < count; ++n ) {
+			if( clipped[n].value( ) > threshold ) {
+				// Keep every element after the first few valid
+				if( first_bad == count and n >= count / 2 ) {
+					first_bad = n;
+				} else {
+					clipped[n] = From( threshold );
+				}
+			}
+		}
+		auto const before = overflow_count;
+		auto const written =
+		  daw::integers::widen( clipped, out, big_base, big_scale );
+		if( first_bad == count ) {
+			daw_ensure( written == count );
+			daw_ensure( overflow_count == before );
+		} else {
+			daw_ensure( written == first_bad );
+			daw_ensure( overflow_count == before + 1 );
+		}
+		for( std::size_t n = 0; n < written; ++n ) {
+			daw_ensure( out[n] == To( static_cast<to_t>(
+			                        big_base.value( ) +
+			                        clipped[n].value( ) * big_scale.value( ) ) ) );
+		}
+	}
+
+	template<typename To, typename From>
+	void test_pair( ) {
+		for( std::size_t count : { 0U, 1U, 3U, 15U, 16U, 33U, 100U, 4095U, 4096U,
+		                           4097U, 10'000U } ) {
+			test_widen<To, From>( count );
+		}
+	}
+
+	void test_wide_scale( ) {
+		// A scale that does not fit in 32 bits takes the scalar path for i64
+		auto const in = random_values<i16>( 100 );
+		auto out = std::vector<i64>( 100, i64( 0 ) );
+		auto const scale = i64( 1LL << 40 );
+		daw_ensure( daw::integers::widen( in, out, i64( 5 ), scale ) == 100 );
+		for( std::size_t n = 0; n < 100; ++n ) {
+			daw_ensure( out[n] == i64( in[n].value( ) * ( 1LL << 40 ) + 5 ) );
+		}
+	}
+
+	void test_short_output( ) {
+		auto const in = std::vector<i8>( 10, i8( -2 ) );
+		auto out = std::vector<i32>( 4, i32( 0 ) );
+		auto const before = out_of_range_count;
+		daw::integers::widen( in, out );
+		daw_ensure( out_of_range_count == before + 1 );
+		daw_ensure( out[3] == i32( -2 ) );
+		daw_ensure( daw::integers::widen( in, out, i32( 10 ) ) == 4 );
+		daw_ensure( out_of_range_count == before + 2 );
+		daw_ensure( out[3] == i32( 8 ) );
+	}
+} // namespace
+
+int main( ) try {
+	auto const on_overflow = []( daw::integers::SignedIntegerErrorType ) {
+		++overflow_count;
+	};
+	auto const on_out_of_range = []( daw::integers::SignedIntegerErrorType ) {
+		++out_of_range_count;
+	};
+	daw::integers::register_signed_overflow_handler( on_overflow );
+	daw::integers::register_signed_out_of_range_handler( on_out_of_range );
+
+	test_pair<i16, i8>( );
+	test_pair<i32, i8>( );
+	test_pair<i64, i8>( );
+	test_pair<i32, i16>( );
+	test_pair<i64, i16>( );
+	test_pair<i64, i32>( );
+	test_wide_scale( );
+	test_short_output( );
+} catch( ... ) {
+	std::cerr << "Unexpected exception thrown\n" << std::flush;
+	throw;
+}